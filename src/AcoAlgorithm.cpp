@@ -1,9 +1,16 @@
 #include "AcoAlgorithm.hpp"
 
+#include <algorithm>
 #include <iostream>
 
 #include "AcoAlgorithmCpu.hpp"
+#include "AcoAlgorithmCpuAsync.hpp"
+#include "AcoAlgorithmCpuNuma.hpp"
+#include "AcoAlgorithmCpuPipelined.hpp"
+#include "AcoAlgorithmCpuSimd.hpp"
+#include "AcoAlgorithmCpuSmall.hpp"
 #include "AcoAlgorithmGpu.hpp"
+#include "AcoAlgorithmReordered.hpp"
 
 namespace aco {
 
@@ -15,6 +22,21 @@ std::ostream& operator<<(std::ostream& out, DeviceType device) {
     case DeviceType::GPU:
         out << "GPU";
         return out;
+    case DeviceType::CPU_NUMA:
+        out << "CPU_NUMA";
+        return out;
+    case DeviceType::CPU_ASYNC:
+        out << "CPU_ASYNC";
+        return out;
+    case DeviceType::CPU_PIPELINED:
+        out << "CPU_PIPELINED";
+        return out;
+    case DeviceType::CPU_SIMD:
+        out << "CPU_SIMD";
+        return out;
+    case DeviceType::CPU_SMALL:
+        out << "CPU_SMALL";
+        return out;
     }
 
     out << "unknown";
@@ -32,14 +54,105 @@ static void validate_config(Algorithm::Config config) {
                   << config.pheromone_evaporation << "\n";
         throw std::invalid_argument("aco::Algorithm invalid pheromone evaporation argument!");
     }
+    if (config.alpha < 0 || config.beta < 0) {
+        std::cerr << "aco::Algorithm invalid alpha or beta argument! Expected non-negative, got: "
+                  << config.alpha << ", " << config.beta << "\n";
+        throw std::invalid_argument("aco::Algorithm invalid alpha or beta argument!");
+    }
+    if (config.pruning_factor != 0 && !(config.pruning_factor >= 1)) {
+        std::cerr << "aco::Algorithm invalid pruning factor argument! Expected zero or at least 1, "
+                     "got: "
+                  << config.pruning_factor << "\n";
+        throw std::invalid_argument("aco::Algorithm invalid pruning factor argument!");
+    }
 }
 
 Algorithm::Algorithm(std::mt19937& random_generator, Graph graph_arg, Config config_arg)
-    : gen(random_generator), graph(std::move(graph_arg)), config(config_arg) {
+    : gen(random_generator), graph(std::move(graph_arg)), config(config_arg), diagnostics(),
+      diagnostics_snapshot() {
     // Validate arguments
     validate_config(config);
 }
 
+void Algorithm::reset(const Graph& graph_arg, Config config_arg) {
+    validate_config(config_arg);
+    prepare_reset(graph_arg, config_arg);
+
+    // Copy-assignment reuses already allocated memory if possible
+    graph = graph_arg;
+    config = config_arg;
+    diagnostics = Diagnostics();
+    diagnostics_snapshot = Diagnostics::Snapshot();
+    reset_state();
+}
+
+void Algorithm::diagnose(const Graph::Index* tours, std::size_t count) {
+    if (config.diagnostics_samples == 0) {
+        return;
+    }
+    auto load_row = [this](Graph::Index row, float* values) { load_pheromone_row(row, values); };
+    diagnostics_snapshot = diagnostics.measure(graph.get_size(), load_row, tours, count,
+                                               config.diagnostics_samples);
+}
+
+void Algorithm::load_pheromone_row(Graph::Index row, float* values) const {
+    const auto& current = get_graph();
+    for (Graph::Index j = 0; j < current.get_size(); ++j) {
+        values[j] = j != row ? current.get_pheromone(row, j) : 0.f;
+    }
+}
+
+// Cheapest insertion of the new node into the shortest path
+Graph::Index Algorithm::add_node(const std::vector<int>& costs) {
+    // Synchronize pheromones first, they may live on a device
+    prepare_change();
+    get_graph();
+    auto path = get_shortest_path();
+    auto node = graph.add_node(costs);
+
+    std::size_t  best_position = 0;
+    std::int64_t best_increase = 0;
+    for (std::size_t i = 0; i < path.size(); ++i) {
+        // Path is a round trip, a single node path is a loop to itself (of zero cost)
+        auto src = path[i];
+        auto dst = path[(i + 1) % path.size()];
+        std::int64_t removed = src == dst ? 0 : graph.get_cost(src, dst);
+        std::int64_t increase =
+            std::int64_t{graph.get_cost(src, node)} + graph.get_cost(node, dst) - removed;
+        if (i == 0 || increase < best_increase) {
+            best_position = i + 1;
+            best_increase = increase;
+        }
+    }
+    path.insert(begin(path) + best_position, node);
+
+    update_state(std::move(path));
+    return node;
+}
+
+void Algorithm::remove_node(Graph::Index node) {
+    prepare_change();
+    get_graph();
+    auto path = get_shortest_path();
+    graph.remove_node(node);
+
+    path.erase(std::remove(begin(path), end(path), node), end(path));
+    for (auto& elem : path) {
+        elem -= elem > node ? 1 : 0;
+    }
+
+    update_state(std::move(path));
+}
+
+void Algorithm::set_cost(Graph::Index src, Graph::Index dst, int cost) {
+    prepare_change();
+    get_graph();
+    graph.set_cost(src, dst, cost);
+
+    // The shortest path is still valid, only its length may have changed
+    update_state(get_shortest_path());
+}
+
 // Factory method
 std::unique_ptr<Algorithm> Algorithm::make(DeviceType device, std::mt19937& random_generator,
                                            Graph graph, Config config) {
@@ -50,10 +163,46 @@ std::unique_ptr<Algorithm> Algorithm::make(DeviceType device, std::mt19937& rand
     case DeviceType::GPU:
         return std::unique_ptr<Algorithm>(
             new AlgorithmGpu(random_generator, std::move(graph), config));
+    case DeviceType::CPU_NUMA:
+        return std::unique_ptr<Algorithm>(
+            new AlgorithmCpuNuma(random_generator, std::move(graph), config));
+    case DeviceType::CPU_ASYNC:
+        return std::unique_ptr<Algorithm>(
+            new AlgorithmCpuAsync(random_generator, std::move(graph), config));
+    case DeviceType::CPU_PIPELINED:
+        return std::unique_ptr<Algorithm>(
+            new AlgorithmCpuPipelined(random_generator, std::move(graph), config));
+    case DeviceType::CPU_SIMD:
+        return std::unique_ptr<Algorithm>(
+            new AlgorithmCpuSimd(random_generator, std::move(graph), config));
+    case DeviceType::CPU_SMALL:
+        switch (small_capacity(graph.get_size())) {
+        case 32:
+            return std::unique_ptr<Algorithm>(
+                new AlgorithmCpuSmall<32>(random_generator, std::move(graph), config));
+        case 64:
+            return std::unique_ptr<Algorithm>(
+                new AlgorithmCpuSmall<64>(random_generator, std::move(graph), config));
+        case 128:
+            return std::unique_ptr<Algorithm>(
+                new AlgorithmCpuSmall<128>(random_generator, std::move(graph), config));
+        case 256:
+            return std::unique_ptr<Algorithm>(
+                new AlgorithmCpuSmall<256>(random_generator, std::move(graph), config));
+        }
+        std::cerr << "aco::Algorithm::make graph too big for CPU_SMALL: " << graph.get_size()
+                  << " nodes\n";
+        throw std::invalid_argument("aco::Algorithm::make graph too big for CPU_SMALL");
     }
 
     std::cerr << "aco::Algorithm::make_algorithm unknown device type: " << (int)device << "\n";
     throw std::invalid_argument("aco::Algorithm::make_algorithm unknown device type");
 }
 
+std::unique_ptr<Algorithm> Algorithm::make(DeviceType device, std::mt19937& random_generator,
+                                           Graph graph, Config config, Reordering reordering) {
+    return std::unique_ptr<Algorithm>(new AlgorithmReordered(
+        device, random_generator, std::move(graph), config, std::move(reordering)));
+}
+
 } // namespace aco
\ No newline at end of file
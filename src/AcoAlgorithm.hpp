@@ -1,17 +1,22 @@
 #include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <random>
 #include <vector>
 
+#include "AcoChoiceInfo.hpp"
+#include "AcoDiagnostics.hpp"
+#include "AcoFootprint.hpp"
 #include "AcoGraph.hpp"
+#include "AcoReordering.hpp"
 
 #ifndef ACO_ALGORITHM_HPP
 #define ACO_ALGORITHM_HPP
 
 namespace aco {
 
-enum class DeviceType { CPU, GPU };
+enum class DeviceType { CPU, GPU, CPU_NUMA, CPU_ASYNC, CPU_PIPELINED, CPU_SIMD, CPU_SMALL };
 
 std::ostream& operator<<(std::ostream&, DeviceType);
 
@@ -19,7 +24,7 @@ std::ostream& operator<<(std::ostream&, DeviceType);
 // At the moment it is tightly coupled to solve TSP (Travelling Salesman Problem).
 class Algorithm {
   public:
-    using Path = std::vector<Graph::Index>;
+    using Path = Graph::Path;
 
     // Algorithm configuration
     struct Config {
@@ -27,6 +32,22 @@ class Algorithm {
         float       pheromone_evaporation; // Pheromone evaporation coefficient: in [0,1] range:
                                            // * 1 means no evaporation (100% pheromones remain)
                                            // * 0 means full evaporation (0% pheromones remain)
+        std::size_t threads = 0; // Worker threads of multithreaded algorithms, zero means one per
+                                 // available CPU. Ignored by the other ones.
+        Precision choice_info_precision = Precision::Float; // Storage of the choice info on the
+                                                            // host, pheromones are always floats
+        float alpha = 1; // Weight of the pheromone in the choice info: pheromone^alpha
+        float beta = 1;  // Weight of the heuristic in the choice info: (1 / cost)^beta
+        std::size_t diagnostics_samples = 0; // Pheromone rows and pairs of tours measured per
+                                             // iteration for get_diagnostics(), zero disables
+        std::size_t recombination_elites = 0; // The best so far is recombined with this many best
+                                              // tours of every iteration (see Recombination), and
+                                              // deposits pheromone like one more ant. Zero
+                                              // disables. CPU only, ignored by the others.
+        float pruning_factor = 0; // Ants which can't finish within this times the best so far are
+                                  // abandoned and replaced by new ones, see build_bounded in
+                                  // TourBuilder. Zero disables, otherwise at least 1, tight
+                                  // factors starve the pheromone update. CPU only.
     };
 
   public:
@@ -39,6 +60,12 @@ class Algorithm {
     static std::unique_ptr<Algorithm> make(DeviceType device, std::mt19937& random_generator,
                                            Graph graph, Config config);
 
+    // Same as above, but the algorithm works on the graph renumbered by 'reordering' for better
+    // memory locality, see AlgorithmReordered. Paths, the graph and dynamic changes still use the
+    // original node indices.
+    static std::unique_ptr<Algorithm> make(DeviceType device, std::mt19937& random_generator,
+                                           Graph graph, Config config, Reordering reordering);
+
   public:
     // Accessors. For algorithms operating on GPU, this is also synchronization point.
     virtual const Graph& get_graph() const = 0;
@@ -50,14 +77,70 @@ class Algorithm {
     // Algorithm info
     virtual std::string info() const = 0;
 
+    // Search state after the last iteration, see Diagnostics. Not available (NaN) unless enabled
+    // with Config::diagnostics_samples. Diversity is not available on CPU_NUMA and CPU_ASYNC, which
+    // don't keep the tours of an iteration together.
+    virtual const Diagnostics::Snapshot& get_diagnostics() const { return diagnostics_snapshot; }
+
+    // Memory held by the algorithm, by structure (see Footprint), the graph included. Device
+    // memory is listed too, under names starting with "device". Sizes are the allocated ones, so
+    // after the graph shrank they may be bigger than predicted, see predict_footprint.
+    virtual Footprint get_footprint() const { return graph.get_footprint(); }
+
+    // Start solving another problem, reusing already allocated resources (e.g. buffers) where
+    // possible. Throws std::invalid_argument on invalid configuration, or on a graph the algorithm
+    // can't take, and is left unchanged then.
+    void reset(const Graph& graph, Config config);
+
+    // Dynamic instances, see the corresponding Graph methods. Pheromones learned so far are kept,
+    // so that re-optimization after a small change starts from a good state instead of from
+    // scratch. The shortest path is repaired: a new node is inserted where it adds the least cost,
+    // a removed one is just skipped.
+    virtual Graph::Index add_node(const std::vector<int>& costs);
+    virtual void         remove_node(Graph::Index node);
+    virtual void         set_cost(Graph::Index src, Graph::Index dst, int cost);
+
   public:
-    // TODO: Move the following method to aco::Graph
-    virtual int path_length(const Path& path) const = 0;
+    // Convenience wrapper for Graph::path_length(). Costs are kept up to date on the host, so this
+    // does not need to synchronize with the device.
+    virtual std::int64_t path_length(const Path& path) const { return graph.path_length(path); }
+
+  protected:
+    // Called by reset() with the new graph and configuration, before anything is replaced. Should
+    // stop background work reading them, and throw std::invalid_argument if the algorithm can't
+    // take them, so that a failed reset leaves it unchanged.
+    virtual void prepare_reset(const Graph& /*graph*/, const Config& /*config*/) {}
+
+    // Called by reset(), after the graph and the configuration were replaced. Should bring the
+    // algorithm to the same state as just after construction.
+    virtual void reset_state() = 0;
+
+    // Called by the dynamic changes before the pheromones are synchronized to the graph. Should
+    // stop background work updating them, so that none of its updates are lost.
+    virtual void prepare_change() {}
+
+    // Called after the graph was modified in place. Should bring workspaces and device buffers in
+    // line with the graph, keeping the pheromones, and take over the repaired shortest path.
+    virtual void update_state(Path shortest_path) = 0;
+
+    // Should be called at the end of advance(), once the pheromones were updated. 'tours' are the
+    // tours of the iteration one after the other, or nullptr if not available. Only the sampled
+    // rows of the pheromones are read, see load_pheromone_row.
+    void diagnose(const Graph::Index* tours, std::size_t count);
+
+    // Current pheromones of 'row' into 'values' (get_size() of them, the edge to self is ignored).
+    // Goes through get_graph() by default, algorithms which keep the pheromones elsewhere should
+    // copy just the row.
+    virtual void load_pheromone_row(Graph::Index row, float* values) const;
 
   protected:
     std::mt19937& gen;
     Graph         graph;
     Config        config;
+
+  private:
+    Diagnostics           diagnostics;
+    Diagnostics::Snapshot diagnostics_snapshot;
 };
 
 } // namespace aco
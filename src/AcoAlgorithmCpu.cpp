@@ -1,6 +1,8 @@
 #include "AcoAlgorithmCpu.hpp"
 
+#include <algorithm>
 #include <iostream>
+#include <numeric>
 
 #include "Utils.hpp"
 
@@ -14,8 +16,9 @@ static auto make_valid_path(const Graph& graph) {
 }
 
 AlgorithmCpu::AlgorithmCpu(std::mt19937& random_generator, Graph graph_arg, Config config_arg)
-    : Algorithm(random_generator, std::move(graph_arg), config_arg), shortest_path() {
-    shortest_path = make_valid_path(graph);
+    : Algorithm(random_generator, std::move(graph_arg), config_arg), shortest_path(),
+      choice_info(graph.get_size()), tour_builder(graph.get_size()) {
+    reset_state();
 }
 
 const Graph& AlgorithmCpu::get_graph() const {
@@ -28,98 +31,168 @@ const AlgorithmCpu::Path& AlgorithmCpu::get_shortest_path() const {
 
 AlgorithmCpu::Path AlgorithmCpu::advance() {
     auto cities = graph.get_size();
-    Path iteration_best = make_valid_path(graph);
+    auto agents = config.agents_count; // Ants that completed their tours, after the generation
 
-    // Generate solutions
-    std::vector<Path> paths(config.agents_count);
+    // Combine pheromones and heuristic information once per iteration (pheromones were updated at
+    // the end of the previous one)
     {
-        auto scoped = utils::scoped_time_measurement("AlgorithmCpu: generate solutions");
-        for (std::size_t i = 0; i < config.agents_count; ++i) {
-            auto& path = paths[i];
-
-            // Start from a city with index 'i', modulo in case the number of agents is higher than
-            // the number of cities
-            path.push_back(i % cities);
-
-            // Choose one new destination in every iteration
-            while (path.size() < cities) {
-                // Calculate the score (desire to go) for every city
-                std::vector<float> path_scores(cities);
-                auto               current_city = path.back();
-                for (std::size_t j = 0; j < cities; ++j) {
-                    if (utils::contains(path, j)) {
-                        // Path already visited - leave it a score of zero
-                        continue;
-                    }
-
-                    // Basic score function without alpha and beta coefficients
-                    // Basic heuristic - just a reciprocal of the distance, so that shorter paths
-                    // are preferred in general
-                    // TODO: Precompute reciprocals of distances?
-                    path_scores[j] =
-                        graph.get_pheromone(current_city, j) / graph.get_cost(current_city, j);
-                }
-
-                // Choose the target city using roullette random algorithm
-                auto target = utils::roullette(path_scores, gen);
-                path.push_back(target);
-            }
+        auto scoped = utils::scoped_time_measurement("AlgorithmCpu: update choice info");
+        choice_info.update(graph);
+    }
 
-            // Path calculated - remember it if is shorter than the current best
-            if (path_length(path) < path_length(iteration_best)) {
-                iteration_best = path;
+    // Generate solutions. Tours of all agents are stored one after the other, so that they can be
+    // evaluated in a single batch.
+    tours.resize(agents * cities);
+    {
+        auto scoped = utils::scoped_time_measurement("AlgorithmCpu: generate solutions");
+        if (config.pruning_factor > 0) {
+            agents = build_pruned();
+        } else {
+            for (std::size_t i = 0; i < agents; ++i) {
+                // Start from a city with index 'i', modulo in case the number of agents is higher
+                // than the number of cities
+                tour_builder.build(choice_info, i % cities, gen, tours.data() + i * cities);
             }
         }
     }
 
+    tours_total += agents;
+
+    // Evaluate all solutions and find the best one
+    lengths.resize(agents);
+    {
+        auto scoped = utils::scoped_time_measurement("AlgorithmCpu: evaluate solutions");
+        graph.path_lengths(tours.data(), agents, lengths.data());
+    }
+    auto best = std::min_element(begin(lengths), end(lengths)) - begin(lengths);
+    Path iteration_best(tours.begin() + best * cities, tours.begin() + (best + 1) * cities);
+
     {
         auto scoped = utils::scoped_time_measurement("AlgorithmCpu: update pheromones");
         // Update pheromones
-        // Step 1: evaporation
-        graph.update_all(config.pheromone_evaporation);
-
-        // Step 2: Pheromones left by ants.
+        // Step 1: Pheromones left by ants.
         // Basic algorithm, where every ant leaves pheromones, and the amount is independent from
         // other ants' solutions.
         // No limit on total pheromone on a section.
-        for (const auto& path : paths) {
+        auto deposit = [&](const Graph::Index* path, std::int64_t length) {
             // The total amount of pheromone left by ant is inversely proportional to the distance
             // covered by ant.
-            float total_pheromone = 1.f / path_length(path);
+            float total_pheromone = 1.f / length;
 
-            for (int i = 0; i < path.size(); ++i) {
+            for (std::size_t i = 0; i < cities; ++i) {
                 // Path stores visited cities in order. It is a round trip, so the last distance is
                 // from the last city directly to the first one
                 auto src = path[i];
-                auto dst = path[(i + 1) % path.size()];
+                auto dst = path[(i + 1) % cities];
 
                 // The amount of pheromone to leave is proportional to the section length
                 float pheromone_to_leave = total_pheromone / graph.get_cost(src, dst);
-                graph.add_pheromone_two_way(src, dst, pheromone_to_leave);
+                deposits.add_two_way(src, dst, pheromone_to_leave);
             }
+        };
+
+        auto elitist = config.recombination_elites > 0 ? 1 : 0;
+        deposits.clear();
+        deposits.reserve((agents + elitist) * cities);
+        for (std::size_t agent = 0; agent < agents; ++agent) {
+            deposit(tours.data() + agent * cities, lengths[agent]);
+        }
+
+        // With recombination, the best so far may be a child that no ant has built. It deposits
+        // like one more ant, otherwise the colony would never learn from it.
+        if (elitist) {
+            deposit(shortest_path.data(), path_length(shortest_path));
         }
+
+        // Step 2: evaporation, and then adding the above deposits, in a single pass
+        graph.update_all(config.pheromone_evaporation, deposits);
     }
 
     // If the iteration best path is shortest than the global shortest (best so far), remember it
-    if (path_length(iteration_best) < path_length(shortest_path)) {
+    if (lengths[best] < path_length(shortest_path)) {
         shortest_path = iteration_best;
     }
 
+    if (config.recombination_elites > 0) {
+        auto scoped = utils::scoped_time_measurement("AlgorithmCpu: recombination");
+        recombine();
+    }
+
+    diagnose(tours.data(), agents);
     return iteration_best;
 }
 
-int AlgorithmCpu::path_length(const Path& path) const {
-    int length = 0;
-    for (int i = 0; i < path.size(); ++i) {
-        // Path stores visited cities in order. It is a round trip, so the last distance is from the
-        // last city directly to the first one
-        auto src = path[i];
-        auto dst = path[(i + 1) % path.size()];
+std::size_t AlgorithmCpu::build_pruned() {
+    auto cities = graph.get_size();
+    auto limit =
+        static_cast<std::int64_t>(double(config.pruning_factor) * path_length(shortest_path));
+
+    // A hopeless ant leaves no tour, the next one takes its slot. New ants are started until the
+    // usual number of tours is complete, or twice as many ants were started.
+    std::size_t completed = 0;
+    std::size_t started = 0;
+    for (; started < 2 * config.agents_count && completed < config.agents_count; ++started) {
+        auto* path = tours.data() + completed * cities;
+        if (tour_builder.build_bounded(choice_info, graph, nearest_costs, limit, started % cities,
+                                       gen, path)) {
+            ++completed;
+        }
+    }
+    ants_abandoned += started - completed;
 
-        length += graph.get_cost(src, dst);
+    // An iteration needs its best tour
+    if (completed == 0) {
+        tour_builder.build(choice_info, 0, gen, tours.data());
+        completed = 1;
     }
+    return completed;
+}
+
+void AlgorithmCpu::recombine() {
+    auto cities = graph.get_size();
+    auto count = std::min(config.recombination_elites, lengths.size());
+
+    // Tours of the iteration, without the pruned ones
+    elites.resize(lengths.size());
+    std::iota(begin(elites), end(elites), 0);
+    std::partial_sort(begin(elites), begin(elites) + count, end(elites),
+                      [&](std::size_t a, std::size_t b) { return lengths[a] < lengths[b]; });
+
+    // Every improvement becomes the parent of the following crossovers
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto* elite = tours.data() + elites[i] * cities;
+        if (recombination.crossover(graph, shortest_path.data(), elite, child)) {
+            std::swap(shortest_path, child);
+        }
+    }
+}
 
-    return length;
+Footprint AlgorithmCpu::get_footprint() const {
+    auto result = Algorithm::get_footprint();
+    result.add("choice info", choice_info.get_memory_usage());
+    result.add("tours", Footprint::capacity_bytes(tours) + Footprint::capacity_bytes(lengths));
+    result.add("deposits", deposits.get_memory_usage());
+    return result;
+}
+
+void AlgorithmCpu::reset_state() {
+    // Workspaces adjust themselves to the graph size when used
+    shortest_path = make_valid_path(graph);
+    tours_total = 0;
+    ants_abandoned = 0;
+    choice_info.set_precision(config.choice_info_precision);
+    choice_info.set_exponents(config.alpha, config.beta);
+    if (config.pruning_factor > 0) {
+        graph.nearest_costs(nearest_costs);
+    }
+}
+
+void AlgorithmCpu::update_state(Path repaired_shortest_path) {
+    // Costs have changed
+    shortest_path = std::move(repaired_shortest_path);
+    if (config.pruning_factor > 0) {
+        graph.nearest_costs(nearest_costs);
+    }
 }
 
-} // namespace aco
\ No newline at end of file
+} // namespace aco
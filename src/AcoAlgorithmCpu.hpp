@@ -1,6 +1,9 @@
 #include <memory>
 
 #include "AcoAlgorithm.hpp"
+#include "AcoChoiceInfo.hpp"
+#include "AcoRecombination.hpp"
+#include "AcoTourBuilder.hpp"
 
 #ifndef ACO_ALGORITHM_CPU_HPP
 #define ACO_ALGORITHM_CPU_HPP
@@ -12,6 +15,12 @@ class AlgorithmCpu : public Algorithm {
   public:
     friend class Algorithm;
 
+    // Totals since construction (or the last reset)
+    struct Statistics {
+        std::size_t tours;     // Tours of the finished iterations
+        std::size_t abandoned; // Ants abandoned by pruning, see Config::pruning_factor
+    };
+
   private:
     // Should be created via factory method.
     explicit AlgorithmCpu(std::mt19937& random_generator, Graph graph, Config config);
@@ -26,12 +35,40 @@ class AlgorithmCpu : public Algorithm {
 
     std::string info() const override { return "CPU"; }
 
-  public:
-    // TODO: Move the following method to aco::Graph
-    int path_length(const Path& path) const override;
+    Footprint get_footprint() const override;
+
+    Statistics get_statistics() const { return {tours_total, ants_abandoned}; }
+
+  protected:
+    void reset_state() override;
+    void update_state(Path shortest_path) override;
+
+  private:
+    // Build the tours of the iteration, abandoning the ants that can't finish within
+    // pruning_factor times the best so far. Returns the number of tours, which may be lower than
+    // agents_count.
+    std::size_t build_pruned();
+
+    // Partition crossover of the best so far with the best tours of the iteration
+    void recombine();
 
   private:
     Path shortest_path;
+
+    // Workspaces, reused between iterations
+    ChoiceInfo                choice_info;
+    TourBuilder               tour_builder;
+    DepositBuffer             deposits;
+    std::vector<Graph::Index> tours;   // Flat, agents_count tours of get_size() cities each
+    std::vector<std::int64_t> lengths; // Length of each tour
+    std::vector<int>          nearest_costs; // See Graph::nearest_costs, updated with the costs
+    Recombination             recombination;
+    std::vector<std::size_t>  elites; // Indices of the best tours
+    Path                      child;
+
+    // Statistics
+    std::size_t tours_total = 0;
+    std::size_t ants_abandoned = 0;
 };
 
 } // namespace aco
@@ -0,0 +1,333 @@
+#include "AcoAlgorithmCpuAsync.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+
+#include "AcoKernels.hpp"
+
+namespace aco {
+
+// Initialize shortest path just to be valid
+static auto make_valid_path(const Graph& graph) {
+    Algorithm::Path result(graph.get_size());
+    std::iota(begin(result), end(result), 0);
+    return result;
+}
+
+// Relaxed read-modify-write of an atomic float. Deposits and evaporation of the same edge may
+// happen concurrently, so plain stores would lose updates.
+template <typename Function> static void atomic_update(std::atomic<float>& value, Function update) {
+    auto current = value.load(std::memory_order_relaxed);
+    while (!value.compare_exchange_weak(current, update(current), std::memory_order_relaxed)) {
+    }
+}
+
+AlgorithmCpuAsync::AlgorithmCpuAsync(std::mt19937& random_generator, Graph graph_arg,
+                                     Config config_arg)
+    : Algorithm(random_generator, std::move(graph_arg), config_arg), shortest_path(), workers(),
+      pheromones(), costs(), nodes(0), min_pheromone(0), evaporation_cursor(0), choice_info(),
+      previous_choice_info(), refresh_scores(), issued(0), finished(0), budget(0), iteration(0),
+      stopping(false), error(), tours_total(0), seconds_total(0), started(false), start_time() {
+    shortest_path = make_valid_path(graph);
+    load_graph();
+
+    auto threads = config.threads != 0
+                       ? config.threads
+                       : std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    workers.resize(threads);
+    for (auto& worker : workers) {
+        worker.gen.seed(gen());
+    }
+    for (std::size_t i = 0; i < threads; ++i) {
+        workers[i].thread = std::thread([this, i] { worker_loop(i); });
+    }
+}
+
+AlgorithmCpuAsync::~AlgorithmCpuAsync() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work_available.notify_all();
+    for (auto& worker : workers) {
+        worker.thread.join();
+    }
+}
+
+// From the algorithm's point of view, this operation is logically constant. It copies the current
+// pheromones to the graph, while workers may still be running ahead.
+const Graph& AlgorithmCpuAsync::get_graph() const {
+    auto& graph_pheromones = const_cast<utils::LargeVector<float>&>(graph.pheromones);
+    for (std::size_t i = 0; i < graph_pheromones.size(); ++i) {
+        graph_pheromones[i] = pheromones[i].load(std::memory_order_relaxed);
+    }
+
+    return graph;
+}
+
+const AlgorithmCpuAsync::Path& AlgorithmCpuAsync::get_shortest_path() const {
+    return shortest_path;
+}
+
+AlgorithmCpuAsync::Path AlgorithmCpuAsync::advance() {
+    Path         iteration_best;
+    std::int64_t iteration_best_length;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!started) {
+            started = true;
+            start_time = std::chrono::steady_clock::now();
+        }
+
+        // Allow workers to run one iteration ahead of this one
+        budget = (iteration + 2) * config.agents_count;
+        work_available.notify_all();
+
+        auto& current = iterations[iteration % 2];
+        tour_finished.wait(lock, [&] { return current.finished == config.agents_count; });
+        iteration_best = std::move(current.best);
+        iteration_best_length = current.best_length;
+        current = Iteration();
+        ++iteration;
+
+        tours_total += config.agents_count;
+        seconds_total =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+        if (error) {
+            auto result = error;
+            error = nullptr;
+            std::rethrow_exception(result);
+        }
+    }
+
+    // If the iteration best path is shortest than the global shortest (best so far), remember it
+    if (iteration_best_length < path_length(shortest_path)) {
+        shortest_path = iteration_best;
+    }
+
+    // Tours are not kept, workers only remember the best one
+    diagnose(nullptr, 0);
+    return iteration_best;
+}
+
+std::string AlgorithmCpuAsync::info() const {
+    std::ostringstream out;
+    out << "CPU async (" << workers.size() << " threads)";
+    return out.str();
+}
+
+Footprint AlgorithmCpuAsync::get_footprint() const {
+    auto result = Algorithm::get_footprint();
+    result.add("shared pheromones", Footprint::capacity_bytes(pheromones));
+    result.add("cost copy", Footprint::capacity_bytes(costs));
+
+    // Choice infos are never modified once published, the scores only while refreshing
+    std::lock_guard<std::mutex> lock(refresh_mutex);
+    auto                        current = std::atomic_load(&choice_info);
+    auto                        previous = previous_choice_info.lock();
+    result.add("choice info", current ? current->get_memory_usage() : 0);
+    result.add("choice info", previous ? previous->get_memory_usage() : 0);
+    result.add("refresh scores", Footprint::capacity_bytes(refresh_scores));
+    return result;
+}
+
+AlgorithmCpuAsync::Statistics AlgorithmCpuAsync::get_statistics() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return {tours_total, seconds_total, seconds_total > 0 ? tours_total / seconds_total : 0};
+}
+
+// Like get_graph(), a snapshot while workers may still be running ahead
+void AlgorithmCpuAsync::load_pheromone_row(Graph::Index row, float* values) const {
+    for (std::size_t j = 0; j < nodes; ++j) {
+        values[j] = pheromones[row * nodes + j].load(std::memory_order_relaxed);
+    }
+}
+
+void AlgorithmCpuAsync::prepare_reset(const Graph&, const Config&) {
+    pause();
+}
+
+void AlgorithmCpuAsync::prepare_change() {
+    pause();
+}
+
+void AlgorithmCpuAsync::reset_state() {
+    // Paused by prepare_reset()
+    shortest_path = make_valid_path(graph);
+    load_graph();
+}
+
+void AlgorithmCpuAsync::update_state(Path repaired_shortest_path) {
+    // Paused by prepare_change()
+    shortest_path = std::move(repaired_shortest_path);
+    load_graph();
+}
+
+void AlgorithmCpuAsync::worker_loop(std::size_t index) {
+    auto& worker = workers[index];
+    while (true) {
+        std::size_t ticket;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            work_available.wait(lock, [&] { return stopping || issued < budget; });
+            if (stopping) {
+                return;
+            }
+            ticket = issued++;
+        }
+
+        std::int64_t length = -1;
+        try {
+            length = build_tour(worker, ticket);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+
+        finish_tour(worker, ticket, length);
+    }
+}
+
+std::int64_t AlgorithmCpuAsync::build_tour(Worker& worker, std::size_t ticket) {
+    // Step 1: construct the tour with the latest published choice info, which stays alive as long
+    // as this ant holds it. The start city follows the ticket, like the agent index elsewhere.
+    {
+        auto current_choice_info = std::atomic_load(&choice_info);
+        worker.tour_builder.build(*current_choice_info, ticket % nodes, worker.gen, worker.path);
+    }
+    auto length = kernels::tour_length(costs.data(), nodes, worker.path.data());
+
+    // Step 2: deposit right away, the other ants see it once the choice info is refreshed
+    deposit(worker.path, length);
+
+    // Step 3: this tour's share of evaporation
+    evaporate_slice();
+
+    // Step 4: the last ticket of an iteration refreshes the choice info. Tours of that iteration
+    // may still be in progress, but there's no point in waiting for them.
+    if ((ticket + 1) % config.agents_count == 0) {
+        refresh_choice_info();
+    }
+
+    return length;
+}
+
+void AlgorithmCpuAsync::finish_tour(const Worker& worker, std::size_t ticket,
+                                    std::int64_t length) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& slot = iterations[(ticket / config.agents_count) % 2];
+    if (length >= 0 && (slot.best.empty() || length < slot.best_length)) {
+        slot.best = worker.path;
+        slot.best_length = length;
+    }
+
+    ++slot.finished;
+    ++finished;
+    tour_finished.notify_all();
+}
+
+void AlgorithmCpuAsync::deposit(const Path& path, std::int64_t length) {
+    // The total amount of pheromone left by ant is inversely proportional to the distance covered
+    // by ant, the amount on every section is proportional to the section length
+    float total_pheromone = 1.f / length;
+    for (std::size_t i = 0; i < nodes; ++i) {
+        // Path stores visited cities in order. It is a round trip, so the last distance is from
+        // the last city directly to the first one
+        auto src = path[i];
+        auto dst = path[(i + 1) % nodes];
+
+        float amount = total_pheromone / costs[src * nodes + dst];
+        auto  add = [amount](float value) { return value + amount; };
+        atomic_update(pheromones[src * nodes + dst], add);
+        atomic_update(pheromones[dst * nodes + src], add);
+    }
+}
+
+// The matrix is evaporated in slices, so that the whole of it is evaporated once per
+// agents_count tours
+void AlgorithmCpuAsync::evaporate_slice() {
+    auto edges = nodes * nodes;
+    auto slice = (edges + config.agents_count - 1) / config.agents_count;
+    auto first = evaporation_cursor.fetch_add(slice, std::memory_order_relaxed) % edges;
+
+    auto coefficient = config.pheromone_evaporation;
+    auto min_value = min_pheromone;
+    auto evaporate = [coefficient, min_value](float value) {
+        return std::max(value * coefficient, min_value);
+    };
+
+    // The slice may wrap around the end of the matrix
+    for (std::size_t i = 0; i < slice; ++i) {
+        atomic_update(pheromones[(first + i) % edges], evaporate);
+    }
+}
+
+void AlgorithmCpuAsync::refresh_choice_info() {
+    // Skip the refresh if another worker is still busy with the previous one
+    std::unique_lock<std::mutex> lock(refresh_mutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return;
+    }
+
+    auto next = make_choice_info();
+
+    auto edges = nodes * nodes;
+    refresh_scores.resize(edges);
+    for (std::size_t i = 0; i < edges; ++i) {
+        // The diagonal is ignored by ChoiceInfo::assign(), but it must not divide by zero
+        auto cost = costs[i];
+        refresh_scores[i] =
+            cost != 0 ? next->score(pheromones[i].load(std::memory_order_relaxed), cost) : 0.f;
+    }
+    next->assign(refresh_scores, nodes);
+    previous_choice_info = std::atomic_exchange(&choice_info, std::move(next));
+}
+
+std::shared_ptr<ChoiceInfo> AlgorithmCpuAsync::make_choice_info() const {
+    auto result = std::make_shared<ChoiceInfo>(nodes, config.choice_info_precision);
+    result->set_exponents(config.alpha, config.beta);
+    return result;
+}
+
+void AlgorithmCpuAsync::pause() {
+    std::unique_lock<std::mutex> lock(mutex);
+    budget = issued;
+    tour_finished.wait(lock, [&] { return finished == issued; });
+}
+
+void AlgorithmCpuAsync::load_graph() {
+    nodes = graph.get_size();
+    costs = graph.costs;
+    min_pheromone = graph.initial_pheromone;
+
+    auto edges = nodes * nodes;
+    pheromones = utils::LargeVector<std::atomic<float>>(edges);
+    for (std::size_t i = 0; i < edges; ++i) {
+        pheromones[i].store(graph.pheromones[i], std::memory_order_relaxed);
+    }
+    evaporation_cursor = 0;
+
+    auto initial_choice_info = make_choice_info();
+    initial_choice_info->update(graph);
+    std::atomic_store(&choice_info, std::move(initial_choice_info));
+    previous_choice_info.reset();
+
+    // Tickets start over
+    std::lock_guard<std::mutex> lock(mutex);
+    issued = 0;
+    finished = 0;
+    budget = 0;
+    iteration = 0;
+    iterations[0] = Iteration();
+    iterations[1] = Iteration();
+    tours_total = 0;
+    seconds_total = 0;
+    started = false;
+}
+
+} // namespace aco
@@ -0,0 +1,149 @@
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "AcoAlgorithm.hpp"
+#include "AcoChoiceInfo.hpp"
+#include "AcoTourBuilder.hpp"
+#include "HugePageAllocator.hpp"
+
+#ifndef ACO_ALGORITHM_CPU_ASYNC_HPP
+#define ACO_ALGORITHM_CPU_ASYNC_HPP
+
+namespace aco {
+
+// Asynchronous multithreaded CPU implementation of the ACO algorithm, without iteration barriers.
+// Worker threads build tours continuously against a shared pheromone matrix:
+// - every ant deposits its pheromones as soon as its tour is ready, with relaxed atomic adds
+//   (like atomicAdd in the GPU kernel), while the other ants are still constructing,
+// - evaporation is applied lazily, every finished tour evaporates the next slice of the matrix, so
+//   that the whole matrix evaporates once per agents_count tours,
+// - choice info is refreshed once per agents_count tours by whichever worker crosses that point,
+//   and published to the others without stopping them.
+// An iteration is just a budget of agents_count tours: advance() returns once that many tours are
+// finished, and workers are allowed to run one iteration ahead in the meantime, so they never wait
+// for the slowest ant. As a consequence, results are not reproducible from run to run.
+// Like on GPU, get_graph() is a synchronization point, which copies the pheromones to the graph.
+class AlgorithmCpuAsync : public Algorithm {
+  public:
+    friend class Algorithm;
+
+    // Totals since construction (or the last reset)
+    struct Statistics {
+        std::size_t tours;   // Tours of the finished iterations
+        double      seconds; // From the start of the first advance() to the end of the last one
+        double      tours_per_second;
+    };
+
+  private:
+    // Should be created via factory method.
+    explicit AlgorithmCpuAsync(std::mt19937& random_generator, Graph graph, Config config);
+
+  public:
+    ~AlgorithmCpuAsync() override;
+
+  public:
+    // Accessors
+    const Graph& get_graph() const override;
+    const Path&  get_shortest_path() const override;
+
+    // Advance simulation by one step. Return best path from that iteration.
+    Path advance() override;
+
+    std::string info() const override;
+
+    // Waits for a choice info refresh in progress
+    Footprint get_footprint() const override;
+
+    Statistics get_statistics() const;
+
+  protected:
+    // Workers are paused before the base class replaces the configuration they read, and before a
+    // dynamic change snapshots the pheromones they update
+    void prepare_reset(const Graph& graph, const Config& config) override;
+    void prepare_change() override;
+    void reset_state() override;
+    void load_pheromone_row(Graph::Index row, float* values) const override;
+    void update_state(Path shortest_path) override;
+
+  private:
+    struct Worker {
+        std::mt19937 gen;
+        TourBuilder  tour_builder;
+        Path         path;
+        std::thread  thread;
+    };
+
+    // Tours are attributed to iterations by their ticket. Workers run at most one iteration ahead,
+    // so two slots are enough.
+    struct Iteration {
+        Path         best;
+        std::int64_t best_length = 0;
+        std::size_t  finished = 0;
+    };
+
+    void         worker_loop(std::size_t index);
+    std::int64_t build_tour(Worker& worker, std::size_t ticket);
+    void         finish_tour(const Worker& worker, std::size_t ticket, std::int64_t length);
+    void         deposit(const Path& path, std::int64_t length);
+    void         evaporate_slice();
+    void         refresh_choice_info();
+
+    // Stop handing out tours and wait for the ones in progress, so that the shared state can be
+    // safely replaced
+    void pause();
+
+    // (Re)create the shared state from the graph, workers must be paused
+    void load_graph();
+
+    // Empty choice info configured according to the config
+    std::shared_ptr<ChoiceInfo> make_choice_info() const;
+
+  private:
+    Path shortest_path;
+
+    std::vector<Worker> workers;
+
+    // Shared state, read and written by workers without locks
+    utils::LargeVector<std::atomic<float>> pheromones;
+    utils::LargeVector<int>                costs; // Copy of the graph costs, the graph can change
+    std::size_t                           nodes;
+    float                                 min_pheromone;
+    std::atomic<std::size_t>              evaporation_cursor;
+    std::shared_ptr<ChoiceInfo>           choice_info; // Accessed with std::atomic_load/exchange
+
+    // Choice info refresh, by a single worker at a time, so the workspace is shared. Every refresh
+    // fills a new choice info: ants may still read the previous one, and nothing orders their
+    // reads before a rewrite of it. The previous one is only observed, for get_footprint().
+    mutable std::mutex        refresh_mutex;
+    std::weak_ptr<ChoiceInfo> previous_choice_info;
+    std::vector<float>        refresh_scores;
+
+    // Tour budget. Tours are numbered with tickets, workers build tours as long as there is budget.
+    mutable std::mutex      mutex;
+    std::condition_variable work_available;
+    std::condition_variable tour_finished;
+    std::size_t             issued;    // Tickets handed out
+    std::size_t             finished;  // Tours finished
+    std::size_t             budget;    // Tickets allowed to be handed out
+    std::size_t             iteration; // The one advance() waits for
+    Iteration               iterations[2];
+    bool                    stopping;
+    std::exception_ptr      error;
+
+    // Statistics
+    std::size_t                           tours_total;
+    double                                seconds_total;
+    bool                                  started;
+    std::chrono::steady_clock::time_point start_time;
+};
+
+} // namespace aco
+
+#endif // ACO_ALGORITHM_CPU_ASYNC_HPP
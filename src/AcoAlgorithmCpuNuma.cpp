@@ -0,0 +1,344 @@
+#include "AcoAlgorithmCpuNuma.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+
+#include "AcoKernels.hpp"
+#include "Utils.hpp"
+
+namespace aco {
+
+// Initialize shortest path just to be valid
+static auto make_valid_path(const Graph& graph) {
+    Algorithm::Path result(graph.get_size());
+    std::iota(begin(result), end(result), 0);
+    return result;
+}
+
+AlgorithmCpuNuma::AlgorithmCpuNuma(std::mt19937& random_generator, Graph graph_arg,
+                                   Config config_arg)
+    : Algorithm(random_generator, std::move(graph_arg), config_arg), shortest_path(), nodes(),
+      workers(), replicas_valid(false), phase(Phase::Prepare), generation(0), finished_workers(0),
+      error() {
+    shortest_path = make_valid_path(graph);
+
+    // Spread worker threads evenly over the nodes, then over CPUs of every node
+    auto topology = utils::Topology::detect();
+    auto threads = config.threads != 0 ? config.threads : topology.cpu_count();
+    for (const auto& topology_node : topology.get_nodes()) {
+        auto node = std::make_unique<Node>();
+        node->id = topology_node.id;
+        nodes.push_back(std::move(node));
+    }
+
+    workers.resize(threads);
+    const auto& topology_nodes = topology.get_nodes();
+    for (std::size_t i = 0; i < threads; ++i) {
+        auto  node_index = i % nodes.size();
+        auto& cpus = topology_nodes[node_index].cpus;
+        auto& worker = workers[i];
+        worker.node = node_index;
+        worker.cpu = cpus[(i / nodes.size()) % cpus.size()];
+        worker.gen.seed(gen());
+        worker.tours = 0;
+        nodes[node_index]->workers.push_back(i);
+    }
+
+    // Nodes without any worker (more nodes than threads) are not used
+    nodes.erase(std::remove_if(begin(nodes), end(nodes),
+                               [](const auto& node) { return node->workers.empty(); }),
+                end(nodes));
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        for (auto worker : nodes[i]->workers) {
+            workers[worker].node = i;
+        }
+    }
+
+    for (std::size_t i = 0; i < threads; ++i) {
+        workers[i].thread = std::thread([this, i] { worker_loop(i); });
+    }
+}
+
+AlgorithmCpuNuma::~AlgorithmCpuNuma() {
+    run_phase(Phase::Exit);
+    for (auto& worker : workers) {
+        worker.thread.join();
+    }
+}
+
+const Graph& AlgorithmCpuNuma::get_graph() const {
+    return graph;
+}
+
+const AlgorithmCpuNuma::Path& AlgorithmCpuNuma::get_shortest_path() const {
+    return shortest_path;
+}
+
+AlgorithmCpuNuma::Path AlgorithmCpuNuma::advance() {
+    // Split agents between nodes, proportionally to the number of their workers. Agent 'i' starts
+    // from the city with index 'i', modulo in case the number of agents is higher than the number
+    // of cities.
+    std::size_t agents_begin = 0;
+    for (auto& node : nodes) {
+        auto agents = config.agents_count * node->workers.size() / workers.size();
+        node->next_agent = agents_begin;
+        agents_begin += agents;
+        node->agents_end = agents_begin;
+    }
+    nodes.back()->agents_end = config.agents_count;
+
+    {
+        auto scoped = utils::scoped_time_measurement("AlgorithmCpuNuma: update choice info");
+        run_phase(Phase::Prepare);
+    }
+    {
+        auto scoped = utils::scoped_time_measurement("AlgorithmCpuNuma: generate solutions");
+        run_phase(Phase::Construct);
+    }
+    {
+        auto scoped = utils::scoped_time_measurement("AlgorithmCpuNuma: update pheromones");
+        run_phase(Phase::Reduce);
+        run_phase(Phase::Merge);
+    }
+
+    // Iteration best path from all the workers
+    const Path*  iteration_best = nullptr;
+    std::int64_t iteration_best_length = 0;
+    for (const auto& worker : workers) {
+        for (std::size_t i = 0; i < worker.tours; ++i) {
+            if (!iteration_best || worker.lengths[i] < iteration_best_length) {
+                iteration_best = &worker.paths[i];
+                iteration_best_length = worker.lengths[i];
+            }
+        }
+    }
+
+    // If the iteration best path is shortest than the global shortest (best so far), remember it
+    if (iteration_best_length < path_length(shortest_path)) {
+        shortest_path = *iteration_best;
+    }
+
+    // Tours are spread over the workers
+    diagnose(nullptr, 0);
+    return *iteration_best;
+}
+
+std::string AlgorithmCpuNuma::info() const {
+    std::ostringstream out;
+    out << "CPU NUMA (" << nodes.size() << " nodes, " << workers.size() << " threads)";
+    return out.str();
+}
+
+Footprint AlgorithmCpuNuma::get_footprint() const {
+    auto result = Algorithm::get_footprint();
+    for (const auto& node : nodes) {
+        result.add("replica costs", Footprint::capacity_bytes(node->costs));
+        result.add("replica choice info", node->choice_info.get_memory_usage());
+        result.add("replica deposits", Footprint::capacity_bytes(node->deposits));
+    }
+
+    // Every worker keeps the paths of the most tours it has built in a single iteration
+    std::size_t tours = 0;
+    for (const auto& worker : workers) {
+        tours += Footprint::capacity_bytes(worker.paths);
+        tours += Footprint::capacity_bytes(worker.lengths);
+        for (const auto& path : worker.paths) {
+            tours += Footprint::capacity_bytes(path);
+        }
+    }
+    result.add("tours", tours);
+    return result;
+}
+
+std::vector<AlgorithmCpuNuma::NodeStatistics> AlgorithmCpuNuma::get_statistics() const {
+    std::vector<NodeStatistics> result;
+    for (const auto& node : nodes) {
+        NodeStatistics statistics{node->id, node->workers.size(), 0, node->construction_seconds,
+                                  0};
+        for (auto worker : node->workers) {
+            statistics.tours += workers[worker].tours;
+        }
+        // The same accounting as get_footprint()
+        statistics.replica_bytes = Footprint::capacity_bytes(node->costs) +
+                                   node->choice_info.get_memory_usage() +
+                                   Footprint::capacity_bytes(node->deposits);
+        result.push_back(statistics);
+    }
+    return result;
+}
+
+void AlgorithmCpuNuma::reset_state() {
+    shortest_path = make_valid_path(graph);
+    replicas_valid = false;
+}
+
+void AlgorithmCpuNuma::update_state(Path repaired_shortest_path) {
+    shortest_path = std::move(repaired_shortest_path);
+    replicas_valid = false;
+}
+
+void AlgorithmCpuNuma::run_phase(Phase next_phase) {
+    std::unique_lock<std::mutex> lock(mutex);
+    phase = next_phase;
+    finished_workers = 0;
+    ++generation;
+    phase_started.notify_all();
+
+    if (next_phase == Phase::Exit) {
+        return;
+    }
+
+    phase_finished.wait(lock, [&] { return finished_workers == workers.size(); });
+    if (next_phase == Phase::Prepare) {
+        replicas_valid = true;
+    }
+
+    if (error) {
+        auto result = error;
+        error = nullptr;
+        std::rethrow_exception(result);
+    }
+}
+
+void AlgorithmCpuNuma::worker_loop(std::size_t index) {
+    auto& worker = workers[index];
+    auto& node = *nodes[worker.node];
+    bool  leader = node.workers.front() == index;
+    if (!utils::pin_current_thread(worker.cpu)) {
+        std::cerr << "AlgorithmCpuNuma: Failed to pin thread to CPU " << worker.cpu << "\n";
+    }
+
+    std::size_t seen_generation = 0;
+    while (true) {
+        Phase current;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            phase_started.wait(lock, [&] { return generation != seen_generation; });
+            seen_generation = generation;
+            current = phase;
+        }
+
+        if (current == Phase::Exit) {
+            return;
+        }
+
+        try {
+            switch (current) {
+            case Phase::Prepare:
+                if (leader) {
+                    prepare(node);
+                }
+                break;
+            case Phase::Construct:
+                construct(worker, node);
+                break;
+            case Phase::Reduce:
+                if (leader) {
+                    reduce(node);
+                }
+                break;
+            case Phase::Merge:
+                merge(index);
+                break;
+            case Phase::Exit:
+                break;
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (++finished_workers == workers.size()) {
+            phase_finished.notify_one();
+        }
+    }
+}
+
+// Runs on the node's leader thread, so that replicas are allocated and first touched on its node
+void AlgorithmCpuNuma::prepare(Node& node) {
+    auto edges = graph.get_size() * graph.get_size();
+    if (!replicas_valid) {
+        node.costs = graph.costs;
+    }
+    node.choice_info.set_precision(config.choice_info_precision);
+    node.choice_info.set_exponents(config.alpha, config.beta);
+    node.choice_info.update(graph);
+    node.deposits.assign(edges, 0.f);
+    node.construction_seconds = 0;
+}
+
+void AlgorithmCpuNuma::construct(Worker& worker, Node& node) {
+    auto begin = std::chrono::steady_clock::now();
+    auto cities = graph.get_size();
+
+    worker.tours = 0;
+    for (auto agent = node.next_agent++; agent < node.agents_end; agent = node.next_agent++) {
+        if (worker.tours == worker.paths.size()) {
+            worker.paths.emplace_back();
+            worker.lengths.emplace_back();
+        }
+        auto& path = worker.paths[worker.tours];
+        worker.tour_builder.build(node.choice_info, agent % cities, worker.gen, path);
+
+        // Length from node-local costs
+        worker.lengths[worker.tours] = kernels::tour_length(node.costs.data(), cities, path.data());
+        ++worker.tours;
+    }
+
+    // The slowest worker determines the node's construction time
+    auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    std::lock_guard<std::mutex> lock(mutex);
+    node.construction_seconds = std::max(node.construction_seconds, seconds);
+}
+
+// Sum pheromones left by the node's ants. Runs on the node's leader thread.
+void AlgorithmCpuNuma::reduce(Node& node) {
+    auto cities = graph.get_size();
+    for (auto index : node.workers) {
+        const auto& worker = workers[index];
+        for (std::size_t t = 0; t < worker.tours; ++t) {
+            // The total amount of pheromone left by ant is inversely proportional to the distance
+            // covered by ant.
+            const auto& path = worker.paths[t];
+            float       total_pheromone = 1.f / worker.lengths[t];
+
+            for (std::size_t i = 0; i < cities; ++i) {
+                auto src = path[i];
+                auto dst = path[(i + 1) % cities];
+
+                // The amount of pheromone to leave is proportional to the section length
+                float pheromone_to_leave = total_pheromone / node.costs[src * cities + dst];
+                node.deposits[src * cities + dst] += pheromone_to_leave;
+                node.deposits[dst * cities + src] += pheromone_to_leave;
+            }
+        }
+    }
+}
+
+// Evaporate and add pheromones from all nodes. Every worker takes a range of rows.
+void AlgorithmCpuNuma::merge(std::size_t worker) {
+    auto cities = graph.get_size();
+    auto rows_per_worker = (cities + workers.size() - 1) / workers.size();
+    auto first_row = std::min(cities, worker * rows_per_worker);
+    auto last_row = std::min(cities, first_row + rows_per_worker);
+
+    for (auto row = first_row; row < last_row; ++row) {
+        auto* pheromones = graph.pheromones.data() + row * cities;
+        kernels::evaporate(pheromones, cities, config.pheromone_evaporation,
+                           graph.initial_pheromone);
+        for (const auto& node : nodes) {
+            const auto* deposits = node->deposits.data() + row * cities;
+            for (std::size_t j = 0; j < cities; ++j) {
+                pheromones[j] += deposits[j];
+            }
+        }
+    }
+}
+
+} // namespace aco
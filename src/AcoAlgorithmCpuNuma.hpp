@@ -0,0 +1,120 @@
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "AcoAlgorithm.hpp"
+#include "AcoChoiceInfo.hpp"
+#include "AcoTourBuilder.hpp"
+#include "HugePageAllocator.hpp"
+#include "Topology.hpp"
+
+#ifndef ACO_ALGORITHM_CPU_NUMA_HPP
+#define ACO_ALGORITHM_CPU_NUMA_HPP
+
+namespace aco {
+
+// Multithreaded CPU implementation of the ACO algorithm, aware of NUMA (multi-socket) machines.
+// Worker threads are pinned to CPUs, spread evenly over NUMA nodes. Every node keeps its own
+// replica of the read-mostly data (costs and choice info), allocated and first touched by a
+// thread of that node, so that the memory is local to the ants that read it. Ants deposit
+// pheromones to their node's buffer first; node buffers are merged into the graph in the end of an
+// iteration, together with evaporation.
+// On a single-node machine it works just like a parallel version of AlgorithmCpu.
+class AlgorithmCpuNuma : public Algorithm {
+  public:
+    friend class Algorithm;
+
+    // Per-node statistics of the last iteration
+    struct NodeStatistics {
+        int         node;    // NUMA node id
+        std::size_t threads; // Worker threads on this node
+        std::size_t tours;   // Tours built on this node
+        double      construction_seconds;
+        std::size_t replica_bytes; // Memory of the data replicated on this node, zero before the
+                                   // first iteration
+    };
+
+  private:
+    // Should be created via factory method.
+    explicit AlgorithmCpuNuma(std::mt19937& random_generator, Graph graph, Config config);
+
+  public:
+    ~AlgorithmCpuNuma() override;
+
+  public:
+    // Accessors
+    const Graph& get_graph() const override;
+    const Path&  get_shortest_path() const override;
+
+    // Advance simulation by one step. Return best path from that iteration.
+    Path advance() override;
+
+    std::string info() const override;
+
+    // Replicas of all NUMA nodes are summed up
+    Footprint get_footprint() const override;
+
+    std::vector<NodeStatistics> get_statistics() const;
+
+  protected:
+    void reset_state() override;
+    void update_state(Path shortest_path) override;
+
+  private:
+    // Iteration is divided into phases, every worker thread takes part in every phase
+    enum class Phase { Prepare, Construct, Reduce, Merge, Exit };
+
+    struct Worker {
+        std::size_t               node;
+        int                       cpu;
+        std::mt19937              gen;
+        TourBuilder               tour_builder;
+        std::vector<Path>         paths; // Reused between iterations, 'tours' first ones are valid
+        std::vector<std::int64_t> lengths;
+        std::size_t               tours;
+        std::thread               thread;
+    };
+
+    struct Node {
+        int                       id;
+        std::vector<std::size_t>  workers; // Indices of node's workers, the first one leads
+        ChoiceInfo                choice_info;
+        utils::LargeVector<int>   costs;
+        utils::LargeVector<float> deposits;
+        std::atomic<std::size_t>  next_agent;
+        std::size_t               agents_end;
+        double                    construction_seconds;
+    };
+
+    void run_phase(Phase phase);
+    void worker_loop(std::size_t worker);
+    void prepare(Node& node);
+    void construct(Worker& worker, Node& node);
+    void reduce(Node& node);
+    void merge(std::size_t worker);
+
+  private:
+    Path shortest_path;
+
+    std::vector<std::unique_ptr<Node>> nodes;
+    std::vector<Worker>                workers;
+    bool                               replicas_valid; // False when costs need to be copied again
+
+    // Phase synchronization
+    std::mutex              mutex;
+    std::condition_variable phase_started;
+    std::condition_variable phase_finished;
+    Phase                   phase;
+    std::size_t             generation;
+    std::size_t             finished_workers;
+    std::exception_ptr      error;
+};
+
+} // namespace aco
+
+#endif // ACO_ALGORITHM_CPU_NUMA_HPP
@@ -0,0 +1,149 @@
+#include "AcoAlgorithmCpuPipelined.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <sstream>
+
+#include "AcoKernels.hpp"
+#include "Utils.hpp"
+
+namespace aco {
+
+// Rows prepared by a single helper task
+static constexpr std::size_t rows_per_task = 64;
+
+// Initialize shortest path just to be valid
+static auto make_valid_path(const Graph& graph) {
+    Algorithm::Path result(graph.get_size());
+    std::iota(begin(result), end(result), 0);
+    return result;
+}
+
+AlgorithmCpuPipelined::AlgorithmCpuPipelined(std::mt19937& random_generator, Graph graph_arg,
+                                             Config config_arg)
+    : Algorithm(random_generator, std::move(graph_arg), config_arg), shortest_path(),
+      choice_info(), back_choice_info(), back_pheromones(), tour_builder(), deposits(), tours(),
+      lengths(), helpers(config.threads) {
+    reset_state();
+}
+
+const Graph& AlgorithmCpuPipelined::get_graph() const {
+    return graph;
+}
+
+const AlgorithmCpuPipelined::Path& AlgorithmCpuPipelined::get_shortest_path() const {
+    return shortest_path;
+}
+
+AlgorithmCpuPipelined::Path AlgorithmCpuPipelined::advance() {
+    auto cities = graph.get_size();
+    auto agents = config.agents_count;
+
+    // Step 1: helpers prepare the back buffers for the next iteration, in the background
+    back_pheromones.resize(graph.pheromones.size());
+    back_choice_info.resize(cities);
+    for (std::size_t first = 0; first < cities; first += rows_per_task) {
+        auto last = std::min(cities, first + rows_per_task);
+        helpers.submit([this, first, last](std::size_t) { prepare_rows(first, last); });
+    }
+
+    // Step 2: meanwhile, construct and evaluate solutions with the front choice info
+    tours.resize(agents * cities);
+    lengths.resize(agents);
+    {
+        auto scoped = utils::scoped_time_measurement("AlgorithmCpuPipelined: generate solutions");
+        for (std::size_t i = 0; i < agents; ++i) {
+            // Start from a city with index 'i', modulo in case the number of agents is higher than
+            // the number of cities
+            tour_builder.build(choice_info, i % cities, gen, tours.data() + i * cities);
+        }
+        graph.path_lengths(tours.data(), agents, lengths.data());
+    }
+    auto best = std::min_element(begin(lengths), end(lengths)) - begin(lengths);
+    Path iteration_best(tours.begin() + best * cities, tours.begin() + (best + 1) * cities);
+
+    // Step 3: the swap point. Wait for the helpers, merge the deposits into the back pheromones,
+    // then swap the buffers.
+    {
+        auto scoped = utils::scoped_time_measurement("AlgorithmCpuPipelined: swap point");
+        helpers.wait();
+
+        deposits.clear();
+        deposits.reserve(agents * cities);
+        for (std::size_t agent = 0; agent < agents; ++agent) {
+            const auto* path = tours.data() + agent * cities;
+
+            // The total amount of pheromone left by ant is inversely proportional to the distance
+            // covered by ant, the amount on every section is proportional to the section length
+            float total_pheromone = 1.f / lengths[agent];
+            for (std::size_t i = 0; i < cities; ++i) {
+                auto src = path[i];
+                auto dst = path[(i + 1) % cities];
+                deposits.add_two_way(src, dst, total_pheromone / graph.get_cost(src, dst));
+            }
+        }
+
+        deposits.group_by_row(cities);
+        for (std::size_t i = 0; i < cities; ++i) {
+            auto* row = back_pheromones.data() + i * cities;
+            for (auto entry = deposits.row_begin(i); entry != deposits.row_end(i); ++entry) {
+                row[entry->dst] += entry->amount;
+            }
+        }
+
+        std::swap(graph.pheromones, back_pheromones);
+        std::swap(choice_info, back_choice_info);
+    }
+
+    // If the iteration best path is shortest than the global shortest (best so far), remember it
+    if (lengths[best] < path_length(shortest_path)) {
+        shortest_path = iteration_best;
+    }
+
+    diagnose(tours.data(), agents);
+    return iteration_best;
+}
+
+std::string AlgorithmCpuPipelined::info() const {
+    std::ostringstream out;
+    out << "CPU pipelined (" << helpers.size() << " helper threads)";
+    return out.str();
+}
+
+Footprint AlgorithmCpuPipelined::get_footprint() const {
+    auto result = Algorithm::get_footprint();
+    result.add("choice info", choice_info.get_memory_usage());
+    result.add("back choice info", back_choice_info.get_memory_usage());
+    result.add("back pheromones", Footprint::capacity_bytes(back_pheromones));
+    result.add("tours", Footprint::capacity_bytes(tours) + Footprint::capacity_bytes(lengths));
+    result.add("deposits", deposits.get_memory_usage());
+    return result;
+}
+
+void AlgorithmCpuPipelined::reset_state() {
+    shortest_path = make_valid_path(graph);
+    choice_info.set_precision(config.choice_info_precision);
+    back_choice_info.set_precision(config.choice_info_precision);
+    choice_info.set_exponents(config.alpha, config.beta);
+    back_choice_info.set_exponents(config.alpha, config.beta);
+    choice_info.update(graph);
+}
+
+void AlgorithmCpuPipelined::update_state(Path repaired_shortest_path) {
+    shortest_path = std::move(repaired_shortest_path);
+    choice_info.update(graph);
+}
+
+// Front buffers are only read here, so helpers don't interfere with the ants
+void AlgorithmCpuPipelined::prepare_rows(std::size_t first_row, std::size_t last_row) {
+    auto        cities = graph.get_size();
+    const auto* front = graph.pheromones.data() + first_row * cities;
+    auto*       back = back_pheromones.data() + first_row * cities;
+    auto        count = (last_row - first_row) * cities;
+
+    std::copy(front, front + count, back);
+    kernels::evaporate(back, count, config.pheromone_evaporation, graph.initial_pheromone);
+    back_choice_info.update_rows(graph, back_pheromones.data(), first_row, last_row);
+}
+
+} // namespace aco
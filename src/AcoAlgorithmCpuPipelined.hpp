@@ -0,0 +1,70 @@
+#include <cstdint>
+#include <vector>
+
+#include "AcoAlgorithm.hpp"
+#include "AcoChoiceInfo.hpp"
+#include "AcoTourBuilder.hpp"
+#include "HugePageAllocator.hpp"
+#include "ThreadPool.hpp"
+
+#ifndef ACO_ALGORITHM_CPU_PIPELINED_HPP
+#define ACO_ALGORITHM_CPU_PIPELINED_HPP
+
+namespace aco {
+
+// CPU implementation of the ACO algorithm, which overlaps the pheromone update with construction.
+// Pheromones and choice info are double-buffered. While ants of iteration i construct their tours
+// with the front choice info, helper threads evaporate the front pheromones into the back buffer
+// and calculate the back choice info from it. Deposits of iteration i are merged into the back
+// pheromones at a single swap point, after which both buffers are swapped.
+// Pheromones are exactly the same as in AlgorithmCpu, but choice info doesn't include the
+// deposits of the previous iteration yet (they are there one iteration later). In return, the
+// iteration takes about as long as the construction alone.
+class AlgorithmCpuPipelined : public Algorithm {
+  public:
+    friend class Algorithm;
+
+  private:
+    // Should be created via factory method.
+    explicit AlgorithmCpuPipelined(std::mt19937& random_generator, Graph graph, Config config);
+
+  public:
+    // Accessors
+    const Graph& get_graph() const override;
+    const Path&  get_shortest_path() const override;
+
+    // Advance simulation by one step. Return best path from that iteration.
+    Path advance() override;
+
+    std::string info() const override;
+
+    Footprint get_footprint() const override;
+
+  protected:
+    void reset_state() override;
+    void update_state(Path shortest_path) override;
+
+  private:
+    // Prepare the back buffers for rows [first_row, last_row), runs on helper threads
+    void prepare_rows(std::size_t first_row, std::size_t last_row);
+
+  private:
+    Path shortest_path;
+
+    // Front buffers are the graph pheromones and 'choice_info', read by the ants
+    ChoiceInfo                choice_info;
+    ChoiceInfo                back_choice_info;
+    utils::LargeVector<float> back_pheromones;
+
+    // Workspaces, reused between iterations
+    TourBuilder               tour_builder;
+    DepositBuffer             deposits;
+    std::vector<Graph::Index> tours;   // Flat, agents_count tours of get_size() cities each
+    std::vector<std::int64_t> lengths; // Length of each tour
+
+    utils::ThreadPool helpers;
+};
+
+} // namespace aco
+
+#endif // ACO_ALGORITHM_CPU_PIPELINED_HPP
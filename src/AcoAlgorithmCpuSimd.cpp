@@ -0,0 +1,110 @@
+#include "AcoAlgorithmCpuSimd.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <sstream>
+
+#include "Utils.hpp"
+
+namespace aco {
+
+// Initialize shortest path just to be valid
+static auto make_valid_path(const Graph& graph) {
+    Algorithm::Path result(graph.get_size());
+    std::iota(begin(result), end(result), 0);
+    return result;
+}
+
+AlgorithmCpuSimd::AlgorithmCpuSimd(std::mt19937& random_generator, Graph graph_arg,
+                                   Config config_arg)
+    : Algorithm(random_generator, std::move(graph_arg), config_arg), shortest_path(),
+      tour_builder() {
+    reset_state();
+}
+
+const Graph& AlgorithmCpuSimd::get_graph() const {
+    return graph;
+}
+
+const AlgorithmCpuSimd::Path& AlgorithmCpuSimd::get_shortest_path() const {
+    return shortest_path;
+}
+
+AlgorithmCpuSimd::Path AlgorithmCpuSimd::advance() {
+    auto cities = graph.get_size();
+    auto agents = config.agents_count;
+
+    {
+        auto scoped = utils::scoped_time_measurement("AlgorithmCpuSimd: update scores");
+        tour_builder.update(graph, config.alpha, config.beta);
+    }
+
+    // Generate solutions, a batch of ants at a time
+    tours.resize(agents * cities);
+    {
+        auto scoped = utils::scoped_time_measurement("AlgorithmCpuSimd: generate solutions");
+        tour_builder.build(agents, gen, tours.data());
+    }
+
+    // Evaluate all solutions and find the best one
+    lengths.resize(agents);
+    {
+        auto scoped = utils::scoped_time_measurement("AlgorithmCpuSimd: evaluate solutions");
+        graph.path_lengths(tours.data(), agents, lengths.data());
+    }
+    auto best = std::min_element(begin(lengths), end(lengths)) - begin(lengths);
+    Path iteration_best(tours.begin() + best * cities, tours.begin() + (best + 1) * cities);
+
+    {
+        auto scoped = utils::scoped_time_measurement("AlgorithmCpuSimd: update pheromones");
+        deposits.clear();
+        deposits.reserve(agents * cities);
+        for (std::size_t agent = 0; agent < agents; ++agent) {
+            const auto* path = tours.data() + agent * cities;
+
+            // The total amount of pheromone left by ant is inversely proportional to the distance
+            // covered by ant, the amount on every section is proportional to the section length
+            float total_pheromone = 1.f / lengths[agent];
+            for (std::size_t i = 0; i < cities; ++i) {
+                auto src = path[i];
+                auto dst = path[(i + 1) % cities];
+                deposits.add_two_way(src, dst, total_pheromone / graph.get_cost(src, dst));
+            }
+        }
+
+        graph.update_all(config.pheromone_evaporation, deposits);
+    }
+
+    // If the iteration best path is shortest than the global shortest (best so far), remember it
+    if (lengths[best] < path_length(shortest_path)) {
+        shortest_path = iteration_best;
+    }
+
+    diagnose(tours.data(), agents);
+    return iteration_best;
+}
+
+std::string AlgorithmCpuSimd::info() const {
+    std::ostringstream out;
+    out << "CPU SIMD (" << tour_builder.get_isa() << ", " << tour_builder.get_lanes()
+        << " ants per batch)";
+    return out.str();
+}
+
+Footprint AlgorithmCpuSimd::get_footprint() const {
+    auto result = Algorithm::get_footprint();
+    result.add("tour builder", tour_builder.get_memory_usage());
+    result.add("tours", Footprint::capacity_bytes(tours) + Footprint::capacity_bytes(lengths));
+    result.add("deposits", deposits.get_memory_usage());
+    return result;
+}
+
+void AlgorithmCpuSimd::reset_state() {
+    shortest_path = make_valid_path(graph);
+}
+
+void AlgorithmCpuSimd::update_state(Path repaired_shortest_path) {
+    shortest_path = std::move(repaired_shortest_path);
+}
+
+} // namespace aco
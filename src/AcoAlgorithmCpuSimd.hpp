@@ -0,0 +1,51 @@
+#include <memory>
+
+#include "AcoAlgorithm.hpp"
+#include "AcoSimdTourBuilder.hpp"
+
+#ifndef ACO_ALGORITHM_CPU_SIMD_HPP
+#define ACO_ALGORITHM_CPU_SIMD_HPP
+
+namespace aco {
+
+// CPU implementation of the ACO algorithm, which constructs the tours of many ants in lockstep, one
+// ant per SIMD lane (see SimdTourBuilder). Otherwise the same as AlgorithmCpu. Meant for small
+// graphs, up to a few hundred cities. The scores are calculated as floats straight from the graph,
+// without a ChoiceInfo, so Config::choice_info_precision is ignored.
+class AlgorithmCpuSimd : public Algorithm {
+  public:
+    friend class Algorithm;
+
+  private:
+    // Should be created via factory method.
+    explicit AlgorithmCpuSimd(std::mt19937& random_generator, Graph graph, Config config);
+
+  public:
+    // Accessors
+    const Graph& get_graph() const override;
+    const Path&  get_shortest_path() const override;
+
+    // Advance simulation by one step. Return best path from that iteration.
+    Path advance() override;
+
+    std::string info() const override;
+
+    Footprint get_footprint() const override;
+
+  protected:
+    void reset_state() override;
+    void update_state(Path shortest_path) override;
+
+  private:
+    Path shortest_path;
+
+    // Workspaces, reused between iterations
+    SimdTourBuilder           tour_builder;
+    DepositBuffer             deposits;
+    std::vector<Graph::Index> tours;   // Flat, agents_count tours of get_size() cities each
+    std::vector<std::int64_t> lengths; // Length of each tour
+};
+
+} // namespace aco
+
+#endif // ACO_ALGORITHM_CPU_SIMD_HPP
\ No newline at end of file
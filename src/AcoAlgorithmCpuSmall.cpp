@@ -0,0 +1,256 @@
+#include "AcoAlgorithmCpuSmall.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+#include "AcoKernels.hpp"
+
+namespace aco {
+
+template <std::size_t N>
+AlgorithmCpuSmall<N>::AlgorithmCpuSmall(std::mt19937& random_generator, Graph graph_arg,
+                                        Config config_arg)
+    : Algorithm(random_generator, std::move(graph_arg), config_arg), shortest_path(), nodes(0),
+      costs(), pheromones(), choice_info(), tours(), lengths(), diagnosed_tours() {
+    validate_size(graph.get_size());
+    reset_state();
+}
+
+// From the algorithm's point of view, this operation is logically constant. It copies the current
+// pheromones to the graph.
+template <std::size_t N>
+const Graph& AlgorithmCpuSmall<N>::get_graph() const {
+    auto& graph_pheromones = const_cast<utils::LargeVector<float>&>(graph.pheromones);
+    for (std::size_t i = 0; i < nodes; ++i) {
+        std::copy_n(pheromones.data() + i * N, nodes, graph_pheromones.data() + i * nodes);
+    }
+
+    return graph;
+}
+
+template <std::size_t N>
+void AlgorithmCpuSmall<N>::load_pheromone_row(Graph::Index row, float* values) const {
+    std::copy_n(pheromones.data() + row * N, nodes, values);
+}
+
+template <std::size_t N>
+const typename AlgorithmCpuSmall<N>::Path& AlgorithmCpuSmall<N>::get_shortest_path() const {
+    return shortest_path;
+}
+
+template <std::size_t N>
+typename AlgorithmCpuSmall<N>::Path AlgorithmCpuSmall<N>::advance() {
+    auto agents = config.agents_count;
+
+    // Combine pheromones and heuristic information once per iteration (pheromones were updated at
+    // the end of the previous one)
+    update_choice_info();
+
+    // Generate solutions, evaluated on the way. No time measurements here, getting the environment
+    // variable alone is noticeable on tiny instances.
+    tours.resize(agents);
+    lengths.resize(agents);
+    for (std::size_t i = 0; i < agents; ++i) {
+        // Start from a city with index 'i', modulo in case the number of agents is higher than the
+        // number of cities
+        lengths[i] = build(static_cast<City>(i % nodes), tours[i]);
+    }
+    auto best = std::min_element(begin(lengths), end(lengths)) - begin(lengths);
+    Path iteration_best(tours[best].begin(), tours[best].begin() + nodes);
+
+    // Update pheromones, the same as in AlgorithmCpu
+    // Step 1: evaporation of the whole matrix, the padding beyond the graph is never read
+    kernels::evaporate(pheromones.data(), pheromones.size(), config.pheromone_evaporation,
+                       graph.initial_pheromone);
+
+    // Step 2: pheromones left by ants, inversely proportional to the tour length, and
+    // proportional to the section length
+    for (std::size_t agent = 0; agent < agents; ++agent) {
+        const auto& tour = tours[agent];
+        float       total_pheromone = 1.f / lengths[agent];
+        for (std::size_t i = 0; i < nodes; ++i) {
+            std::size_t src = tour[i];
+            std::size_t dst = tour[i + 1 == nodes ? 0 : i + 1];
+
+            float pheromone_to_leave = total_pheromone / costs[src * N + dst];
+            pheromones[src * N + dst] += pheromone_to_leave;
+            pheromones[dst * N + src] += pheromone_to_leave;
+        }
+    }
+
+    // If the iteration best path is shortest than the global shortest (best so far), remember it
+    if (lengths[best] < path_length(shortest_path)) {
+        shortest_path = iteration_best;
+    }
+
+    // Diagnostics take the tours in the usual flat layout
+    if (config.diagnostics_samples > 0) {
+        diagnosed_tours.resize(agents * nodes);
+        for (std::size_t agent = 0; agent < agents; ++agent) {
+            std::copy_n(tours[agent].begin(), nodes, diagnosed_tours.begin() + agent * nodes);
+        }
+    }
+    diagnose(diagnosed_tours.data(), agents);
+    return iteration_best;
+}
+
+template <std::size_t N>
+std::string AlgorithmCpuSmall<N>::info() const {
+    std::ostringstream out;
+    out << "CPU_SMALL (up to " << N << " cities)";
+    return out.str();
+}
+
+template <std::size_t N>
+Footprint AlgorithmCpuSmall<N>::get_footprint() const {
+    auto result = Algorithm::get_footprint();
+    result.add("fixed matrices", sizeof(costs) + sizeof(pheromones) + sizeof(choice_info));
+    result.add("tours", Footprint::capacity_bytes(tours) + Footprint::capacity_bytes(lengths) +
+                            Footprint::capacity_bytes(diagnosed_tours));
+    return result;
+}
+
+template <std::size_t N>
+Graph::Index AlgorithmCpuSmall<N>::add_node(const std::vector<int>& new_costs) {
+    if (graph.get_size() >= N) {
+        std::cerr << "aco::AlgorithmCpuSmall::add_node the graph would not fit. Max size: " << N
+                  << "\n";
+        throw std::invalid_argument("aco::AlgorithmCpuSmall::add_node the graph would not fit!");
+    }
+    return Algorithm::add_node(new_costs);
+}
+
+template <std::size_t N>
+void AlgorithmCpuSmall<N>::load_graph() {
+    nodes = graph.get_size();
+    costs.fill(0);
+    pheromones.fill(0);
+    choice_info.fill(0);
+    for (std::size_t i = 0; i < nodes; ++i) {
+        std::copy_n(graph.costs.data() + i * nodes, nodes, costs.data() + i * N);
+        std::copy_n(graph.pheromones.data() + i * nodes, nodes, pheromones.data() + i * N);
+    }
+}
+
+template <std::size_t N>
+void AlgorithmCpuSmall<N>::update_choice_info() {
+    // Diagonal and padding stay zero
+    const bool plain = config.alpha == 1.f && config.beta == 1.f;
+    for (std::size_t i = 0; i < nodes; ++i) {
+        for (std::size_t j = 0; j < nodes; ++j) {
+            auto  index = i * N + j;
+            float pheromone = pheromones[index];
+            float cost = static_cast<float>(costs[index]);
+            // Plain division in the default case, pow() is expensive
+            choice_info[index] =
+                i == j  ? 0.f
+                : plain ? pheromone / cost
+                        : std::pow(pheromone, config.alpha) * std::pow(1.f / cost, config.beta);
+        }
+    }
+}
+
+template <std::size_t N>
+std::int64_t AlgorithmCpuSmall<N>::build(City start, Tour& tour) {
+    // Weight of every city: one for the ones still to visit, zero for the visited ones and for the
+    // padding beyond the graph. Multiplying by it, instead of testing a visited mask, keeps the
+    // loop over a row free of branches.
+    std::array<float, N> open{};
+    std::fill_n(open.begin(), nodes, 1.f);
+    std::array<float, N>         scores;
+    std::array<float, N / block> block_sums;
+
+    tour[0] = start;
+    open[start] = 0.f;
+
+    std::int64_t length = 0;
+    std::size_t  current = start;
+    for (std::size_t step = 1; step < nodes; ++step) {
+        // Scores of the row, and their sums by blocks. The blocks are independent, unlike the
+        // terms of a single running sum, so they are added in parallel.
+        const float* row = choice_info.data() + current * N;
+        for (std::size_t j = 0; j < N; ++j) {
+            scores[j] = row[j] * open[j];
+        }
+        float total = 0.f;
+        for (std::size_t i = 0; i < N / block; ++i) {
+            float sum = 0.f;
+            for (std::size_t j = 0; j < block; ++j) {
+                sum += scores[i * block + j];
+            }
+            block_sums[i] = sum;
+            total += sum;
+        }
+
+        // Roulette, first over the blocks, then within the chosen one. Cities with a score of zero
+        // can't be chosen this way.
+        std::uniform_real_distribution<float> distrib(0, total);
+        float                                 random = distrib(gen);
+        std::size_t                           chosen_block = 0;
+        while (chosen_block + 1 < N / block && random >= block_sums[chosen_block]) {
+            random -= block_sums[chosen_block];
+            ++chosen_block;
+        }
+        std::size_t next = chosen_block * block;
+        while (next + 1 < (chosen_block + 1) * block && random >= scores[next]) {
+            random -= scores[next];
+            ++next;
+        }
+        if (open[next] == 0.f) {
+            // Possible only due to floating point rounding, or if all the scores underflowed
+            next = nodes - 1;
+            while (open[next] == 0.f) {
+                --next;
+            }
+        }
+
+        tour[step] = static_cast<City>(next);
+        open[next] = 0.f;
+        length += costs[current * N + next];
+        current = next;
+    }
+
+    // Round trip
+    return length + costs[current * N + start];
+}
+
+template <std::size_t N>
+void AlgorithmCpuSmall<N>::validate_size(std::size_t size) {
+    if (size == 0 || size > N) {
+        std::cerr << "aco::AlgorithmCpuSmall invalid graph size. Expected between 1 and " << N
+                  << ", got: " << size << "\n";
+        throw std::invalid_argument("aco::AlgorithmCpuSmall invalid graph size!");
+    }
+}
+
+template <std::size_t N>
+void AlgorithmCpuSmall<N>::prepare_reset(const Graph& graph_arg, const Config&) {
+    validate_size(graph_arg.get_size());
+}
+
+template <std::size_t N>
+void AlgorithmCpuSmall<N>::reset_state() {
+    shortest_path.resize(graph.get_size());
+    std::iota(begin(shortest_path), end(shortest_path), 0);
+    load_graph();
+}
+
+template <std::size_t N>
+void AlgorithmCpuSmall<N>::update_state(Path repaired_shortest_path) {
+    // Costs have changed, pheromones were synchronized to the graph before the change
+    shortest_path = std::move(repaired_shortest_path);
+    load_graph();
+}
+
+// Specializations available through Algorithm::make
+template class AlgorithmCpuSmall<32>;
+template class AlgorithmCpuSmall<64>;
+template class AlgorithmCpuSmall<128>;
+template class AlgorithmCpuSmall<256>;
+
+} // namespace aco
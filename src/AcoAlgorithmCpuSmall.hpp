@@ -0,0 +1,100 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "AcoAlgorithm.hpp"
+
+#ifndef ACO_ALGORITHM_CPU_SMALL_HPP
+#define ACO_ALGORITHM_CPU_SMALL_HPP
+
+namespace aco {
+
+// The specialization Algorithm::make picks for a graph: the smallest N that fits it, or zero if
+// none does
+inline std::size_t small_capacity(std::size_t nodes) {
+    for (std::size_t capacity : {32, 64, 128, 256}) {
+        if (nodes <= capacity) {
+            return capacity;
+        }
+    }
+    return 0;
+}
+
+// CPU implementation of the ACO algorithm for small graphs of at most N cities, for batches of
+// tiny instances. Matrices are fixed-size arrays with a row stride of N, the workspace of an ant
+// lives on its stack, and the loops over a row have a trip count known at compile time, so the
+// compiler unrolls and vectorizes them. Cities beyond the graph have a choice info of zero, so
+// they are never chosen.
+// Algorithm::make picks the smallest of the 32, 64, 128 and 256 specializations that fits the
+// graph. Dynamic changes and reset() can't grow the graph over N. Otherwise the same as
+// AlgorithmCpu, without choice_info_precision, recombination_elites and pruning_factor.
+// Like on GPU, get_graph() is a synchronization point, which copies the pheromones to the graph.
+template <std::size_t N>
+class AlgorithmCpuSmall : public Algorithm {
+    static_assert(N > 0 && N <= 256, "City indices are stored in a single byte");
+    static_assert(N % 8 == 0, "Rows are made of whole blocks");
+
+  public:
+    friend class Algorithm;
+
+  private:
+    // Should be created via factory method.
+    explicit AlgorithmCpuSmall(std::mt19937& random_generator, Graph graph, Config config);
+
+  public:
+    // Accessors
+    const Graph& get_graph() const override;
+    const Path&  get_shortest_path() const override;
+
+    // Advance simulation by one step. Return best path from that iteration.
+    Path advance() override;
+
+    std::string info() const override;
+
+    Footprint get_footprint() const override;
+
+    // Throws std::invalid_argument if the graph would no longer fit
+    Graph::Index add_node(const std::vector<int>& costs) override;
+
+  protected:
+    // Throws std::invalid_argument if the new graph doesn't fit, before anything is replaced
+    void prepare_reset(const Graph& graph, const Config& config) override;
+    void reset_state() override;
+    void load_pheromone_row(Graph::Index row, float* values) const override;
+    void update_state(Path shortest_path) override;
+
+  private:
+    static void validate_size(std::size_t size);
+
+    using City = std::uint8_t;
+    using Tour = std::array<City, N>;
+
+    // Scores of a row are summed by blocks of this many cities, see build()
+    static constexpr std::size_t block = 8;
+
+    // Copy the costs and the pheromones from the graph. The choice info is updated by advance().
+    void load_graph();
+    void update_choice_info();
+
+    // Build the tour of an ant starting from the 'start' city, return its length
+    std::int64_t build(City start, Tour& tour);
+
+  private:
+    Path        shortest_path;
+    std::size_t nodes;
+
+    // Row stride N, zero outside of the graph
+    std::array<int, N * N>   costs;
+    std::array<float, N * N> pheromones;
+    std::array<float, N * N> choice_info;
+
+    // Workspaces, reused between iterations
+    std::vector<Tour>         tours;   // agents_count tours, the first 'nodes' cities of each
+    std::vector<std::int64_t> lengths; // Length of each tour
+    std::vector<Graph::Index> diagnosed_tours; // Flat copy of the tours, only for diagnostics
+};
+
+} // namespace aco
+
+#endif // ACO_ALGORITHM_CPU_SMALL_HPP
@@ -1,5 +1,6 @@
 #include "AcoAlgorithmGpu.hpp"
 
+#include <algorithm>
 #include <iostream>
 
 #include "Utils.hpp"
@@ -11,15 +12,19 @@ namespace aco {
 // TODO: Elementwise kernels (calculate_edge_scores, evaporate) don't need to be two-dimensional.
 // Verify if it would be faster to just make them one-dimensional.
 
-// Kernel that calculates scores for travelling from city to city
+// Kernel that calculates scores for travelling from city to city, same as ChoiceInfo::score()
 __global__ void kernel_calculate_edge_scores(int* costs, float* pheromones, float* out_scores,
-                                             std::size_t nodes) {
+                                             std::size_t nodes, float alpha, float beta) {
     int x = blockIdx.x * blockDim.x + threadIdx.x;
     int y = blockIdx.y * blockDim.y + threadIdx.y;
 
     if (x < nodes && y < nodes && x != y) {
         auto i = x * nodes + y;
-        out_scores[i] = pheromones[i] / costs[i];
+        if (alpha == 1.f && beta == 1.f) {
+            out_scores[i] = pheromones[i] / costs[i];
+        } else {
+            out_scores[i] = powf(pheromones[i], alpha) * powf(1.f / costs[i], beta);
+        }
     }
 }
 
@@ -119,7 +124,8 @@ template <typename T> void free_device_buffer(T* buffer) {
 }
 
 // Send buffer from host to device
-template <typename T> static void send_to_device(T* dst, const std::vector<T>& src) {
+template <typename T, typename Allocator>
+static void send_to_device(T* dst, const std::vector<T, Allocator>& src) {
     auto size_in_bytes = src.size() * sizeof(T);
     auto res = cudaMemcpy(dst, src.data(), size_in_bytes, cudaMemcpyHostToDevice);
 
@@ -130,34 +136,9 @@ template <typename T> static void send_to_device(T* dst, const std::vector<T>& s
     }
 }
 
-// Assumes vector of vectors of the same size
-template <typename T> static void send_to_device(T* dst, const std::vector<std::vector<T>>& src) {
-    if (src.empty()) {
-        // Nothing to send
-        return;
-    }
-
-    auto           chunks = src.size();
-    auto           chunk_size = src[0].size();
-    auto           elements_count = chunks * chunk_size;
-    std::vector<T> intermediate(elements_count);
-    for (std::size_t i = 0; i < chunks; ++i) {
-        for (std::size_t j = 0; j < chunk_size; ++j) {
-            intermediate[i * chunk_size + j] = src[i][j];
-        }
-    }
-    auto buffer_size_in_bytes = intermediate.size() * sizeof(T);
-    auto res = cudaMemcpy(dst, intermediate.data(), buffer_size_in_bytes, cudaMemcpyHostToDevice);
-
-    if (res != cudaSuccess) {
-        std::cerr << "Failed to send buffer to device! Error code: " << cudaGetErrorString(res)
-                  << "\n";
-        throw std::runtime_error("Failed to send buffer to device");
-    }
-}
-
 // Send buffer from device to host
-template <typename T> static void send_to_host(std::vector<T>& dst, T* src) {
+template <typename T, typename Allocator>
+static void send_to_host(std::vector<T, Allocator>& dst, T* src) {
     auto size_in_bytes = dst.size() * sizeof(T);
     auto res = cudaMemcpy(dst.data(), src, size_in_bytes, cudaMemcpyDeviceToHost);
 
@@ -170,17 +151,28 @@ template <typename T> static void send_to_host(std::vector<T>& dst, T* src) {
 
 AlgorithmGpu::AlgorithmGpu(std::mt19937& random_generator, Graph graph_arg, Config config_arg)
     : Algorithm(random_generator, std::move(graph_arg), config_arg), shortest_path(),
-      costs(nullptr), pheromones(nullptr), scores(nullptr), paths(nullptr) {
+      choice_info(graph.get_size()), tour_builder(graph.get_size()), costs(nullptr),
+      pheromones(nullptr), scores(nullptr), paths(nullptr), allocated_edges(0),
+      allocated_path_elements(0) {
+    initialize_cuda();
+    reset_state();
+}
+
+AlgorithmGpu::~AlgorithmGpu() {
+    // TODO: Some abstraction for buffers would be useful
+    free_device_buffer(costs);
+    free_device_buffer(pheromones);
+    free_device_buffer(scores);
+    free_device_buffer(paths);
+}
+
+void AlgorithmGpu::reset_state() {
     shortest_path = make_valid_path(graph);
+    choice_info.set_precision(config.choice_info_precision);
+    choice_info.set_exponents(config.alpha, config.beta);
 
-    // Initialize CUDA, allocate buffers
-    initialize_cuda();
-    auto nodes = graph.get_size();
-    auto edges = nodes * nodes;
-    costs = allocate_on_device<int>(edges);
-    pheromones = allocate_on_device<float>(edges);
-    scores = allocate_on_device<float>(edges);
-    paths = allocate_on_device<std::size_t>(config.agents_count * nodes);
+    // Allocate buffers, unless the ones from the previous problem are big enough
+    allocate_buffers();
 
     // Send costs from host graph to device (these never change, so it can be done just once)
     send_to_device(costs, graph.costs);
@@ -190,97 +182,116 @@ AlgorithmGpu::AlgorithmGpu(std::mt19937& random_generator, Graph graph_arg, Conf
     send_to_device(pheromones, graph.pheromones);
 }
 
-AlgorithmGpu::~AlgorithmGpu() {
-    // TODO: Some abstraction for buffers would be useful
-    free_device_buffer(costs);
-    free_device_buffer(pheromones);
-    free_device_buffer(scores);
+void AlgorithmGpu::update_state(Path repaired_shortest_path) {
+    shortest_path = std::move(repaired_shortest_path);
+
+    // Device buffers use the graph size as the row stride, so both buffers are sent again, even
+    // after a change of a single cost. Pheromones were synchronized to host before the change.
+    allocate_buffers();
+    send_to_device(costs, graph.costs);
+    send_to_device(pheromones, graph.pheromones);
+}
+
+void AlgorithmGpu::allocate_buffers() {
+    auto nodes = graph.get_size();
+    auto edges = nodes * nodes;
+    if (edges > allocated_edges) {
+        free_device_buffer(costs);
+        free_device_buffer(pheromones);
+        free_device_buffer(scores);
+        costs = allocate_on_device<int>(edges);
+        pheromones = allocate_on_device<float>(edges);
+        scores = allocate_on_device<float>(edges);
+        allocated_edges = edges;
+    }
+
+    auto path_elements = config.agents_count * nodes;
+    if (path_elements > allocated_path_elements) {
+        free_device_buffer(paths);
+        paths = allocate_on_device<std::size_t>(path_elements);
+        allocated_path_elements = path_elements;
+    }
 }
 
 // From GPU point of view, this operation is still logically constant, it doesn't manipulate any
 // data on the device. It is a synchronization point though, so it updates the pheromones graph
 // stored on host, to match the one on the device.
 const Graph& AlgorithmGpu::get_graph() const {
-    send_to_host(const_cast<std::vector<float>&>(graph.pheromones), pheromones);
+    send_to_host(const_cast<utils::LargeVector<float>&>(graph.pheromones), pheromones);
 
     return graph;
 }
 
+// A single row from the device, instead of the whole matrix like get_graph()
+void AlgorithmGpu::load_pheromone_row(Graph::Index row, float* values) const {
+    auto nodes = graph.get_size();
+    auto res = cudaMemcpy(values, pheromones + row * nodes, nodes * sizeof(float),
+                          cudaMemcpyDeviceToHost);
+
+    if (res != cudaSuccess) {
+        std::cerr << "Failed to send pheromone row from device to host! Error code: "
+                  << cudaGetErrorString(res) << "\n";
+        throw std::runtime_error("Failed to send pheromone row from device to host");
+    }
+}
+
+Footprint AlgorithmGpu::get_footprint() const {
+    auto result = Algorithm::get_footprint();
+    result.add("choice info", choice_info.get_memory_usage());
+    result.add("tours", Footprint::capacity_bytes(tours) + Footprint::capacity_bytes(lengths));
+    result.add("device costs", allocated_edges * sizeof(int));
+    result.add("device pheromones", allocated_edges * sizeof(float));
+    result.add("device scores", allocated_edges * sizeof(float));
+    result.add("device tours", allocated_path_elements * sizeof(std::size_t));
+    return result;
+}
+
 const AlgorithmGpu::Path& AlgorithmGpu::get_shortest_path() const {
     return shortest_path;
 }
 
 AlgorithmGpu::Path AlgorithmGpu::advance() {
     auto cities = graph.get_size();
-    Path iteration_best = make_valid_path(graph);
+    auto agents = config.agents_count;
 
     // Calculate path scores on GPU.
     // It works slower than CPU counterpart, because there's a lot of data movement.
-    auto path_scores = calculate_path_scores();
+    choice_info.assign(calculate_path_scores(), cities);
+
+    // Evaporation doesn't depend on this iteration's solutions. Kernel launches are asynchronous,
+    // so it runs on the device while the host constructs solutions below.
+    evaporate();
 
-    // Generate solutions
-    std::vector<Path> paths(config.agents_count);
+    // Generate solutions. Tours of all agents are stored one after the other, which is also the
+    // layout of the device buffer.
+    tours.resize(agents * cities);
     {
         auto scoped = utils::scoped_time_measurement("AlgorithmGpu: generate solutions");
-        for (std::size_t i = 0; i < config.agents_count; ++i) {
-            auto& path = paths[i];
-
+        for (std::size_t i = 0; i < agents; ++i) {
             // Start from a city with index 'i', modulo in case the number of agents is higher than
             // the number of cities
-            path.push_back(i % cities);
-
-            // Choose one new destination in every iteration
-            while (path.size() < cities) {
-                // Calculate the score (desire to go) for every city
-                auto               current_city = path.back();
-                std::vector<float> scores(cities);
-                for (std::size_t j = 0; j < cities; ++j) {
-                    if (utils::contains(path, j)) {
-                        // Path already visited - leave it a score of zero
-                        continue;
-                    }
-
-                    scores[j] = path_scores[current_city * cities + j];
-                }
-
-                // Choose the target city using roullette random algorithm
-                auto target = utils::roullette(scores, gen);
-                path.push_back(target);
-            }
-
-            // Path calculated - remember it if is shorter than the current best
-            if (path_length(path) < path_length(iteration_best)) {
-                iteration_best = path;
-            }
+            tour_builder.build(choice_info, i % cities, gen, tours.data() + i * cities);
         }
     }
 
-    // TODO: The first step (evaporation) can be done in parallel to the above computation.
-    // Update pheromones
-    update_pheromones(paths);
+    // Evaluate all solutions and find the best one
+    lengths.resize(agents);
+    graph.path_lengths(tours.data(), agents, lengths.data());
+    auto best = std::min_element(begin(lengths), end(lengths)) - begin(lengths);
+    Path iteration_best(tours.begin() + best * cities, tours.begin() + (best + 1) * cities);
+
+    // Pheromones left by ants, after the evaporation launched above
+    add_ants_pheromones(tours);
 
     // If the iteration best path is shortest than the global shortest (best so far), remember it
-    if (path_length(iteration_best) < path_length(shortest_path)) {
+    if (lengths[best] < path_length(shortest_path)) {
         shortest_path = iteration_best;
     }
 
+    diagnose(tours.data(), agents);
     return iteration_best;
 }
 
-int AlgorithmGpu::path_length(const Path& path) const {
-    int length = 0;
-    for (int i = 0; i < path.size(); ++i) {
-        // Path stores visited cities in order. It is a round trip, so the last distance is from the
-        // last city directly to the first one
-        auto src = path[i];
-        auto dst = path[(i + 1) % path.size()];
-
-        length += graph.get_cost(src, dst);
-    }
-
-    return length;
-}
-
 // Calculate on GPU. Works probably much slower than CPU, because of all these allocations and data
 // transfers.
 std::vector<float> AlgorithmGpu::calculate_path_scores() const {
@@ -295,7 +306,8 @@ std::vector<float> AlgorithmGpu::calculate_path_scores() const {
         (buffer_size + threads_per_block - 1) / threads_per_block; // Rounded up
     dim3 blocks_per_grid(blocks_per_grid_dim, blocks_per_grid_dim);
     kernel_calculate_edge_scores<<<blocks_per_grid, block_size>>>(costs, pheromones, scores,
-                                                                  cities);
+                                                                  cities, config.alpha,
+                                                                  config.beta);
 
     auto res = cudaGetLastError();
     if (res != cudaSuccess) {
@@ -311,15 +323,6 @@ std::vector<float> AlgorithmGpu::calculate_path_scores() const {
     return scores_host;
 }
 
-void AlgorithmGpu::update_pheromones(const std::vector<Path>& paths) {
-    auto scoped = utils::scoped_time_measurement("AlgorithmGpu: update pheromones");
-    // Step 1: evaporation
-    evaporate();
-
-    // Step 2: Pheromones left by ants.
-    add_ants_pheromones(paths);
-}
-
 void AlgorithmGpu::evaporate() {
     auto cities = graph.get_size();
     auto buffer_size = cities * cities;
@@ -341,7 +344,8 @@ void AlgorithmGpu::evaporate() {
     }
 }
 
-void AlgorithmGpu::add_ants_pheromones(const std::vector<Path>& travelled_paths) {
+void AlgorithmGpu::add_ants_pheromones(const std::vector<Graph::Index>& travelled_paths) {
+    auto scoped = utils::scoped_time_measurement("AlgorithmGpu: update pheromones");
     auto cities = graph.get_size();
     auto total_threads = config.agents_count;
 
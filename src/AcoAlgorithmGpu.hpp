@@ -1,4 +1,6 @@
 #include "AcoAlgorithm.hpp"
+#include "AcoChoiceInfo.hpp"
+#include "AcoTourBuilder.hpp"
 
 #ifndef ACO_ALGORITHM_GPU_HPP
 #define ACO_ALGORITHM_GPU_HPP
@@ -25,24 +27,37 @@ class AlgorithmGpu : public Algorithm {
 
     std::string info() const override { return "GPU"; }
 
-  public:
-    // TODO: Move the following method to aco::Graph
-    int path_length(const Path& path) const override;
+    Footprint get_footprint() const override;
+
+  protected:
+    void reset_state() override;
+    void update_state(Path shortest_path) override;
+    void load_pheromone_row(Graph::Index row, float* values) const override;
 
   private:
+    void               allocate_buffers();
     std::vector<float> calculate_path_scores() const;
-    void               update_pheromones(const std::vector<Path>& paths);
     void               evaporate();
-    void               add_ants_pheromones(const std::vector<Path>& paths);
+    void               add_ants_pheromones(const std::vector<Graph::Index>& paths);
 
   private:
     Path shortest_path;
 
+    // Host workspaces, reused between iterations
+    ChoiceInfo                choice_info;
+    TourBuilder               tour_builder;
+    std::vector<Graph::Index> tours;   // Flat, agents_count tours of get_size() cities each
+    std::vector<std::int64_t> lengths; // Length of each tour
+
     // Device buffers
     int*         costs;
     float*       pheromones;
     float*       scores;
     std::size_t* paths;
+
+    // Capacity of the device buffers, in elements
+    std::size_t allocated_edges;
+    std::size_t allocated_path_elements;
 };
 
 } // namespace aco
@@ -0,0 +1,126 @@
+#include "AcoAlgorithmReordered.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+namespace aco {
+
+AlgorithmReordered::AlgorithmReordered(DeviceType device, std::mt19937& random_generator,
+                                       Graph graph_arg, Config config_arg,
+                                       Reordering reordering_arg)
+    : Algorithm(random_generator, std::move(graph_arg), config_arg),
+      reordering(std::move(reordering_arg)) {
+    if (reordering.get_size() != graph.get_size()) {
+        std::cerr << "aco::AlgorithmReordered invalid argument. Reordering size: "
+                  << reordering.get_size() << ", graph size: " << graph.get_size() << "\n";
+        throw std::invalid_argument("aco::AlgorithmReordered invalid reordering size!");
+    }
+
+    inner = Algorithm::make(device, gen, take_internal_graph(), config);
+    reordering.to_original(inner->get_shortest_path(), shortest_path);
+}
+
+Graph AlgorithmReordered::take_internal_graph() {
+    auto result = reordering.apply(graph);
+    graph = Graph({}, {}, 0, /*initial_pheromone=*/0);
+    return result;
+}
+
+void AlgorithmReordered::validate_node(Graph::Index node) const {
+    if (node >= reordering.get_size()) {
+        std::cerr << "aco::AlgorithmReordered index out of range. Graph size: "
+                  << reordering.get_size() << ", index: " << node << "\n";
+        throw std::invalid_argument("aco::AlgorithmReordered index out of range!");
+    }
+}
+
+const Graph& AlgorithmReordered::get_graph() const {
+    if (!restored_graph) {
+        restored_graph = reordering.restore(inner->get_graph());
+    }
+    return *restored_graph;
+}
+
+// The inner algorithm holds the renumbered graph
+Footprint AlgorithmReordered::get_footprint() const {
+    auto result = inner->get_footprint();
+    if (restored_graph) {
+        result.add("restored graph", restored_graph->get_footprint().total());
+    }
+    return result;
+}
+
+std::int64_t AlgorithmReordered::path_length(const Path& path) const {
+    if (path.size() != reordering.get_size()) {
+        std::cerr << "aco::AlgorithmReordered invalid path size. Graph size: "
+                  << reordering.get_size() << ", path size: " << path.size() << "\n";
+        throw std::invalid_argument("aco::AlgorithmReordered invalid path size!");
+    }
+    std::for_each(begin(path), end(path), [&](auto node) { validate_node(node); });
+    return inner->path_length(reordering.to_internal(path));
+}
+
+const AlgorithmReordered::Path& AlgorithmReordered::get_shortest_path() const {
+    return shortest_path;
+}
+
+AlgorithmReordered::Path AlgorithmReordered::advance() {
+    auto iteration_best = inner->advance();
+    reordering.to_original(inner->get_shortest_path(), shortest_path);
+    restored_graph.reset();
+
+    reordering.to_original(iteration_best, internal_path);
+    return internal_path;
+}
+
+// The inner algorithm validates the arguments before anything else is changed, only the indices
+// are checked before they are mapped
+Graph::Index AlgorithmReordered::add_node(const std::vector<int>& costs) {
+    if (costs.size() != reordering.get_size()) {
+        std::cerr << "aco::AlgorithmReordered::add_node invalid costs size. Graph size: "
+                  << reordering.get_size() << ", costs size: " << costs.size() << "\n";
+        throw std::invalid_argument("aco::AlgorithmReordered::add_node invalid costs size!");
+    }
+
+    std::vector<int> internal_costs(costs.size());
+    for (std::size_t i = 0; i < costs.size(); ++i) {
+        internal_costs[i] = costs[reordering.to_original(i)];
+    }
+    auto node = inner->add_node(internal_costs);
+    reordering.add_node();
+
+    reordering.to_original(inner->get_shortest_path(), shortest_path);
+    restored_graph.reset();
+    return node;
+}
+
+void AlgorithmReordered::remove_node(Graph::Index node) {
+    validate_node(node);
+    inner->remove_node(reordering.to_internal(node));
+    reordering.remove_node(node);
+
+    reordering.to_original(inner->get_shortest_path(), shortest_path);
+    restored_graph.reset();
+}
+
+void AlgorithmReordered::set_cost(Graph::Index src, Graph::Index dst, int cost) {
+    validate_node(src);
+    validate_node(dst);
+    inner->set_cost(reordering.to_internal(src), reordering.to_internal(dst), cost);
+    restored_graph.reset();
+}
+
+void AlgorithmReordered::reset_state() {
+    reordering = Reordering::cuthill_mckee(graph);
+    inner->reset(take_internal_graph(), config);
+    reordering.to_original(inner->get_shortest_path(), shortest_path);
+    restored_graph.reset();
+}
+
+void AlgorithmReordered::update_state(Path repaired_shortest_path) {
+    // Not reached, dynamic changes are overridden and forwarded to the inner algorithm
+    shortest_path = std::move(repaired_shortest_path);
+}
+
+} // namespace aco
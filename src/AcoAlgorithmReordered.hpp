@@ -0,0 +1,80 @@
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "AcoAlgorithm.hpp"
+#include "AcoReordering.hpp"
+
+#ifndef ACO_ALGORITHM_REORDERED_HPP
+#define ACO_ALGORITHM_REORDERED_HPP
+
+namespace aco {
+
+// Decorator running any other algorithm on a renumbered graph (see Reordering), transparently:
+// paths, the graph and dynamic changes all use the original node indices, mapped on the way in and
+// out. Mapping a path is linear, the graph returned by get_graph() is restored from the inner one
+// (quadratic) only when requested after it changed. The matrices are kept only by the inner
+// algorithm, the graph of the base class is emptied once renumbered.
+// reset() renumbers the new graph with Reordering::cuthill_mckee, since the given order belongs to
+// another instance.
+class AlgorithmReordered : public Algorithm {
+  public:
+    friend class Algorithm;
+
+  private:
+    // Should be created via factory method. Throws std::invalid_argument if the reordering doesn't
+    // match the graph size.
+    explicit AlgorithmReordered(DeviceType device, std::mt19937& random_generator, Graph graph,
+                                Config config, Reordering reordering);
+
+  public:
+    // Accessors
+    const Graph& get_graph() const override;
+    const Path&  get_shortest_path() const override;
+
+    // Advance simulation by one step. Return best path from that iteration.
+    Path advance() override;
+
+    std::string info() const override { return inner->info() + " (reordered)"; }
+
+    Footprint get_footprint() const override;
+
+    // Through the inner graph, throws std::invalid_argument on an invalid path
+    std::int64_t path_length(const Path& path) const override;
+
+    const Diagnostics::Snapshot& get_diagnostics() const override {
+        return inner->get_diagnostics();
+    }
+
+    // Forwarded to the inner algorithm
+    Graph::Index add_node(const std::vector<int>& costs) override;
+    void         remove_node(Graph::Index node) override;
+    void         set_cost(Graph::Index src, Graph::Index dst, int cost) override;
+
+    const Reordering& get_reordering() const { return reordering; }
+
+  protected:
+    void reset_state() override;
+    void update_state(Path shortest_path) override;
+
+  private:
+    void validate_node(Graph::Index node) const;
+
+    // Renumbers the graph of the base class for the inner algorithm, and then empties it
+    Graph take_internal_graph();
+
+  private:
+    Reordering                 reordering;
+    std::unique_ptr<Algorithm> inner; // Works on the graph with internal indices
+    Path                       shortest_path;
+    Path                       internal_path; // Workspace
+
+    // Restored from the inner one on demand, empty when outdated
+    mutable std::optional<Graph> restored_graph;
+};
+
+} // namespace aco
+
+#endif // ACO_ALGORITHM_REORDERED_HPP
@@ -0,0 +1,126 @@
+#include "AcoBatchSolver.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include "../third_party/nlohmann/json.hpp"
+#include "ThreadPool.hpp"
+
+namespace aco {
+
+static Graph load_graph(const std::string& filename) {
+    if (!std::filesystem::exists(filename)) {
+        std::cerr << "BatchSolver: Could not open the file: " << filename << "\n";
+        throw std::runtime_error("Could not open the file!");
+    }
+    std::ifstream file(filename);
+    std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    return Graph::from_string(contents);
+}
+
+BatchSolver::BatchSolver(Config config_arg) : config(config_arg) {
+    if (config.agents_per_node == 0) {
+        std::cerr << "aco::BatchSolver invalid argument. Agents per node should be non-zero!\n";
+        throw std::invalid_argument("aco::BatchSolver invalid agents per node argument!");
+    }
+    // The same rules as for a single instance
+    Solver::validate(config.budget);
+}
+
+std::size_t BatchSolver::run(std::istream& input, std::ostream& output) {
+    utils::ThreadPool      pool(config.threads);
+    std::vector<Workspace> workspaces(pool.size());
+    std::mutex             output_mutex;
+
+    // Instances are scheduled as soon as they are read, so that solving can start before the whole
+    // input is available (e.g. when reading from stdin)
+    std::size_t count = 0;
+    std::string line;
+    while (std::getline(input, line)) {
+        std::istringstream line_stream(line);
+        Instance           instance{count, "", config.budget};
+        if (!(line_stream >> instance.filename) || instance.filename.front() == '#') {
+            continue;
+        }
+
+        int  max_iterations;
+        long time_limit_ms;
+        if (line_stream >> max_iterations) {
+            instance.budget.max_iterations = max_iterations;
+            if (line_stream >> time_limit_ms) {
+                instance.budget.time_limit = std::chrono::milliseconds(time_limit_ms);
+            }
+        }
+
+        pool.submit([this, instance, &workspaces, &output, &output_mutex](std::size_t worker) {
+            auto result = solve(instance, workspaces[worker]);
+
+            std::lock_guard<std::mutex> lock(output_mutex);
+            output << to_string(result) << std::endl;
+        });
+        ++count;
+    }
+
+    pool.wait();
+    return count;
+}
+
+std::string BatchSolver::to_string(const Result& result) {
+    nlohmann::json json;
+    json["instance"] = result.instance;
+    if (!result.error.empty()) {
+        json["error"] = result.error;
+    } else {
+        json["nodes"] = result.nodes;
+        json["length"] = result.length;
+        json["iterations"] = result.iterations;
+        json["time_ms"] = result.time_ms;
+        json["stop"] = result.stop;
+        json["path"] = result.path;
+    }
+    return json.dump();
+}
+
+BatchSolver::Result BatchSolver::solve(const Instance& instance, Workspace& workspace) const {
+    Result result{instance.filename, 0, 0, 0, 0, "", {}, ""};
+    try {
+        auto begin = std::chrono::steady_clock::now();
+        auto graph = load_graph(instance.filename);
+
+        // Results don't depend on which worker solves the instance
+        workspace.gen.seed(config.seed + instance.number);
+        Algorithm::Config algorithm_config{graph.get_size() * config.agents_per_node,
+                                           config.pheromone_evaporation};
+        if (!workspace.algorithm) {
+            workspace.algorithm =
+                Algorithm::make(config.device, workspace.gen, graph, algorithm_config);
+        } else {
+            workspace.algorithm->reset(graph, algorithm_config);
+        }
+
+        // Simulation
+        Solver solver(*workspace.algorithm, instance.budget);
+        auto   solution = solver.run();
+
+        result.nodes = graph.get_size();
+        result.path = std::move(solution.path);
+        result.length = solution.length;
+        result.iterations = solution.iterations;
+        std::ostringstream reason;
+        reason << solution.reason;
+        result.stop = reason.str();
+
+        auto end = std::chrono::steady_clock::now();
+        result.time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count();
+    } catch (const std::exception& e) {
+        result.error = e.what();
+    }
+
+    return result;
+}
+
+} // namespace aco
@@ -0,0 +1,93 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "AcoAlgorithm.hpp"
+#include "AcoGraph.hpp"
+#include "AcoSolver.hpp"
+
+#ifndef ACO_BATCH_SOLVER_HPP
+#define ACO_BATCH_SOLVER_HPP
+
+namespace aco {
+
+// Solves a stream of independent, usually small, problem instances concurrently.
+// Instances are scheduled on a work-stealing thread pool, every worker keeps its own algorithm
+// (along with the graph and workspaces inside), which is reset and reused for every instance it
+// solves, so that memory is not allocated per instance.
+//
+// Input is read line by line, every non-empty line describes a single instance:
+//     filename [max_iterations [time_limit_ms]]
+// where filename points to a serialized aco::Graph, and the optional numbers override the default
+// budget for this instance. Lines starting with '#' are ignored.
+//
+// Output is written as soon as an instance is solved (so not necessarily in the input order), one
+// JSON object per line, e.g.:
+//     {"instance":"a.json","nodes":64,"length":123,"iterations":100,"time_ms":12,
+//      "stop":"iterations","path":[...]}
+// or, if the instance couldn't be solved:
+//     {"instance":"a.json","error":"..."}
+class BatchSolver {
+  public:
+    // Limits for solving a single instance. The one reached first stops the simulation.
+    using Budget = Solver::StopCriteria;
+
+    struct Config {
+        DeviceType    device;
+        std::size_t   threads;         // Zero means one per hardware thread
+        std::size_t   agents_per_node; // Agents count is this times the number of nodes
+        float         pheromone_evaporation;
+        Budget        budget; // Default budget, can be overridden per instance
+        std::uint32_t seed;   // Every instance gets a generator seeded with seed + instance number
+    };
+
+    struct Result {
+        std::string     instance;
+        std::size_t     nodes;
+        std::int64_t    length;
+        int             iterations;
+        long            time_ms;
+        std::string     stop; // Stop reason
+        Algorithm::Path path;
+        std::string     error; // Empty on success
+    };
+
+  public:
+    // Throws std::invalid_argument on invalid configuration.
+    explicit BatchSolver(Config config);
+
+  public:
+    // Solve all instances from the input stream, write results to the output stream. Returns the
+    // number of processed instances (including the failed ones).
+    std::size_t run(std::istream& input, std::ostream& output);
+
+    static std::string to_string(const Result& result);
+
+  private:
+    // Everything a single worker needs, reused between instances
+    struct Workspace {
+        std::mt19937               gen;
+        std::unique_ptr<Algorithm> algorithm;
+    };
+
+    struct Instance {
+        std::size_t number;
+        std::string filename;
+        Budget      budget;
+    };
+
+    Result solve(const Instance& instance, Workspace& workspace) const;
+
+  private:
+    Config config;
+};
+
+} // namespace aco
+
+#endif // ACO_BATCH_SOLVER_HPP
@@ -0,0 +1,236 @@
+#include "AcoBenchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+#include "../third_party/nlohmann/json.hpp"
+
+namespace aco {
+
+static const double infinity = std::numeric_limits<double>::infinity();
+static const double not_available = std::numeric_limits<double>::quiet_NaN();
+
+// Percentile of sorted values, interpolated linearly between the closest ranks. Infinite values
+// (runs that didn't reach the target) can't be interpolated, anything next to them is infinite.
+static double percentile(const std::vector<double>& sorted, double fraction) {
+    if (sorted.empty()) {
+        return not_available;
+    }
+
+    auto position = fraction * (sorted.size() - 1);
+    auto lower = static_cast<std::size_t>(std::floor(position));
+    auto upper = static_cast<std::size_t>(std::ceil(position));
+    if (std::isinf(sorted[upper])) {
+        return infinity;
+    }
+    return sorted[lower] + (sorted[upper] - sorted[lower]) * (position - lower);
+}
+
+// Empty for values that are not finite
+static std::string csv_number(double value) {
+    return std::isfinite(value) ? std::to_string(value) : "";
+}
+
+Benchmark::Benchmark(Config config_arg) : config(std::move(config_arg)) {
+    if (config.profiles.empty()) {
+        std::cerr << "aco::Benchmark invalid argument. At least one profile is required!\n";
+        throw std::invalid_argument("aco::Benchmark no profiles!");
+    }
+    if (config.seeds == 0) {
+        std::cerr << "aco::Benchmark invalid argument. Seeds count should be non-zero!\n";
+        throw std::invalid_argument("aco::Benchmark invalid seeds argument!");
+    }
+    if (config.time_limit.count() <= 0) {
+        std::cerr << "aco::Benchmark invalid argument. Time limit should be positive!\n";
+        throw std::invalid_argument("aco::Benchmark invalid time limit argument!");
+    }
+    if (config.target_gap < 0) {
+        std::cerr << "aco::Benchmark invalid argument. Target gap can't be negative!\n";
+        throw std::invalid_argument("aco::Benchmark invalid target gap argument!");
+    }
+}
+
+Benchmark::Report Benchmark::run(const std::vector<Instance>& instances, std::ostream& log) const {
+    using clock = std::chrono::steady_clock;
+
+    Report report;
+    report.profiles = config.profiles;
+    for (const auto& instance : instances) {
+        report.instances.push_back(instance.name);
+    }
+
+    // Step 1: all the runs
+    for (std::size_t i = 0; i < instances.size(); ++i) {
+        const auto& graph = instances[i].graph;
+        for (std::size_t p = 0; p < config.profiles.size(); ++p) {
+            log << "Instance: " << instances[i].name << ", profile " << p + 1 << "/"
+                << config.profiles.size() << " (" << config.profiles[p].device << ")\n";
+            for (std::size_t s = 0; s < config.seeds; ++s) {
+                Run run{i, p, static_cast<std::uint32_t>(config.seed + s), 0, {}};
+
+                std::mt19937 gen(run.seed);
+                auto         algorithm = Algorithm::make(config.profiles[p].device, gen, graph,
+                                                         config.profiles[p].make_config(
+                                                             graph.get_size()));
+
+                // Record a point of the curve on every improvement
+                auto start = clock::now();
+                auto best = algorithm->path_length(algorithm->get_shortest_path());
+                run.curve.push_back({0.0, best});
+                while (clock::now() - start < config.time_limit) {
+                    algorithm->advance();
+                    ++run.iterations;
+
+                    auto length = algorithm->path_length(algorithm->get_shortest_path());
+                    if (length < best) {
+                        best = length;
+                        std::chrono::duration<double> seconds = clock::now() - start;
+                        run.curve.push_back({seconds.count(), best});
+                    }
+                }
+
+                log << "Seed " << run.seed << ": length: " << best
+                    << ", iterations: " << run.iterations << "\n";
+                report.runs.push_back(std::move(run));
+            }
+        }
+    }
+
+    // Step 2: statistics, once the best lengths of all runs are known
+    for (std::size_t i = 0; i < instances.size(); ++i) {
+        for (std::size_t p = 0; p < config.profiles.size(); ++p) {
+            report.summaries.push_back(summarize(report, i, p, instances[i].optimum));
+        }
+    }
+
+    return report;
+}
+
+Benchmark::Summary Benchmark::summarize(const Report& report, std::size_t instance,
+                                        std::size_t profile, std::int64_t optimum) const {
+    // Reference length: the optimum, or the best length of any run of this instance
+    std::int64_t reference = optimum;
+    if (reference <= 0) {
+        reference = std::numeric_limits<std::int64_t>::max();
+        for (const auto& run : report.runs) {
+            if (run.instance == instance) {
+                reference = std::min(reference, run.curve.back().length);
+            }
+        }
+    }
+
+    Summary summary{instance, profile, 0, 0, 0, 0, 0, 0, 0, 0};
+    summary.target = static_cast<std::int64_t>(std::floor(reference * (1 + config.target_gap)));
+    summary.best_length = std::numeric_limits<std::int64_t>::max();
+
+    std::vector<double> lengths;
+    std::vector<double> times;
+    for (const auto& run : report.runs) {
+        if (run.instance != instance || run.profile != profile) {
+            continue;
+        }
+
+        auto length = run.curve.back().length;
+        summary.best_length = std::min(summary.best_length, length);
+        lengths.push_back(length);
+
+        // The first point within the target, the curve is decreasing
+        auto reached = std::find_if(begin(run.curve), end(run.curve), [&](const Point& point) {
+            return point.length <= summary.target;
+        });
+        times.push_back(reached != end(run.curve) ? reached->seconds : infinity);
+        summary.reached += reached != end(run.curve);
+    }
+
+    std::sort(begin(lengths), end(lengths));
+    std::sort(begin(times), end(times));
+    summary.median_length = percentile(lengths, 0.5);
+    summary.median_gap = optimum > 0 ? (summary.median_length - optimum) / optimum : not_available;
+    summary.time_to_target_q1 = percentile(times, 0.25);
+    summary.time_to_target_median = percentile(times, 0.5);
+    summary.time_to_target_q3 = percentile(times, 0.75);
+    return summary;
+}
+
+Benchmark::Instance Benchmark::load_instance(const std::string& filename, std::int64_t optimum,
+                                             float initial_pheromone) {
+    if (!std::filesystem::exists(filename)) {
+        std::cerr << "Benchmark: Could not open the file: " << filename << "\n";
+        throw std::runtime_error("Could not open the file!");
+    }
+    std::ifstream file(filename);
+    std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    auto is_tsplib = std::filesystem::path(filename).extension() == ".tsp";
+    return {std::filesystem::path(filename).filename().string(),
+            is_tsplib ? Graph::from_tsplib(contents, initial_pheromone)
+                      : Graph::from_string(contents),
+            optimum};
+}
+
+void Benchmark::write_csv(const Report& report, std::ostream& output) {
+    output << "instance,device,agents_per_node,threads,pheromone_evaporation,alpha,beta,runs,"
+              "reached,target,best_length,median_length,median_gap,ttt_q1_s,ttt_median_s,"
+              "ttt_q3_s\n";
+    for (const auto& summary : report.summaries) {
+        const auto& profile = report.profiles[summary.profile];
+        auto        runs = std::count_if(begin(report.runs), end(report.runs), [&](const Run& run) {
+            return run.instance == summary.instance && run.profile == summary.profile;
+        });
+        output << report.instances[summary.instance] << "," << profile.device << ","
+               << profile.agents_per_node << "," << profile.threads << ","
+               << profile.pheromone_evaporation << "," << profile.alpha << "," << profile.beta
+               << "," << runs << "," << summary.reached << "," << summary.target << ","
+               << summary.best_length << "," << csv_number(summary.median_length) << ","
+               << csv_number(summary.median_gap) << ","
+               << csv_number(summary.time_to_target_q1) << ","
+               << csv_number(summary.time_to_target_median) << ","
+               << csv_number(summary.time_to_target_q3) << "\n";
+    }
+}
+
+void Benchmark::write_json(const Report& report, std::ostream& output) {
+    // Non-finite numbers are written as null
+    nlohmann::json json;
+    json["instances"] = report.instances;
+    json["profiles"] = nlohmann::json::array();
+    for (const auto& profile : report.profiles) {
+        json["profiles"].push_back(nlohmann::json::parse(profile.to_string()));
+    }
+
+    json["summaries"] = nlohmann::json::array();
+    for (const auto& summary : report.summaries) {
+        json["summaries"].push_back({{"instance", summary.instance},
+                                     {"profile", summary.profile},
+                                     {"reached", summary.reached},
+                                     {"target", summary.target},
+                                     {"best_length", summary.best_length},
+                                     {"median_length", summary.median_length},
+                                     {"median_gap", summary.median_gap},
+                                     {"time_to_target_q1", summary.time_to_target_q1},
+                                     {"time_to_target_median", summary.time_to_target_median},
+                                     {"time_to_target_q3", summary.time_to_target_q3}});
+    }
+
+    json["runs"] = nlohmann::json::array();
+    for (const auto& run : report.runs) {
+        auto curve = nlohmann::json::array();
+        for (const auto& point : run.curve) {
+            curve.push_back({point.seconds, point.length});
+        }
+        json["runs"].push_back({{"instance", run.instance},
+                                {"profile", run.profile},
+                                {"seed", run.seed},
+                                {"iterations", run.iterations},
+                                {"curve", curve}});
+    }
+
+    output << json.dump() << "\n";
+}
+
+} // namespace aco
@@ -0,0 +1,107 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "AcoAlgorithm.hpp"
+#include "AcoGraph.hpp"
+#include "AcoTuner.hpp"
+
+#ifndef ACO_BENCHMARK_HPP
+#define ACO_BENCHMARK_HPP
+
+namespace aco {
+
+// Anytime benchmark: solves a fixed set of instances with every configuration (given as a
+// profile, see Tuner) and every seed, recording the best length found so far against the time.
+// Runs of the same instance and profile are summarized over the seeds, so that an optimization can
+// be told apart from luck:
+// - the gap of the final length to the known optimum,
+// - time-to-target: the time it took to get within 'target_gap' of the reference length, which is
+//   the optimum if known, or else the best length of all runs of the instance. Reported as the
+//   median and the quartiles over the seeds, runs that never reached the target count as infinite.
+// Runs are sequential, so that they don't disturb each other's timing.
+class Benchmark {
+  public:
+    struct Instance {
+        std::string  name;
+        Graph        graph;
+        std::int64_t optimum = 0; // Zero if unknown
+    };
+
+    struct Config {
+        std::vector<Profile>      profiles;
+        std::size_t               seeds;      // Runs per instance and profile
+        std::uint32_t             seed;       // Run i is seeded with seed + i
+        std::chrono::milliseconds time_limit; // Per run, construction of the algorithm excluded
+        double                    target_gap; // e.g. 0.05 means within 5% of the reference
+    };
+
+    // A point of the anytime curve, a new best length was found at that time
+    struct Point {
+        double       seconds;
+        std::int64_t length;
+    };
+
+    struct Run {
+        std::size_t        instance; // Index of the instance
+        std::size_t        profile;  // Index of the profile
+        std::uint32_t      seed;
+        int                iterations;
+        std::vector<Point> curve; // Starts with the initial path at time zero
+    };
+
+    // Statistics of all seeds of a single instance and profile. NaN means not available (unknown
+    // optimum), infinity means the target wasn't reached.
+    struct Summary {
+        std::size_t  instance;
+        std::size_t  profile;
+        std::size_t  reached; // Runs that reached the target
+        std::int64_t target;  // Length considered as reaching the target
+        std::int64_t best_length;
+        double       median_length;
+        double       median_gap; // Relative to the optimum
+        double       time_to_target_q1;
+        double       time_to_target_median;
+        double       time_to_target_q3;
+    };
+
+    struct Report {
+        std::vector<std::string> instances;
+        std::vector<Profile>     profiles;
+        std::vector<Run>         runs;
+        std::vector<Summary>     summaries;
+    };
+
+  public:
+    // Throws std::invalid_argument on invalid configuration.
+    explicit Benchmark(Config config);
+
+  public:
+    // Run all instances with all profiles and seeds, report progress to 'log'
+    Report run(const std::vector<Instance>& instances, std::ostream& log) const;
+
+    // Load an instance: TSPLIB if the filename ends with ".tsp", a serialized Graph otherwise.
+    // Throws std::runtime_error if the file can't be read, std::invalid_argument if it's invalid.
+    static Instance load_instance(const std::string& filename, std::int64_t optimum,
+                                  float initial_pheromone);
+
+    // Summaries, one line per instance and profile, with a header
+    static void write_csv(const Report& report, std::ostream& output);
+
+    // Everything, including the curves of every run
+    static void write_json(const Report& report, std::ostream& output);
+
+  private:
+    Summary summarize(const Report& report, std::size_t instance, std::size_t profile,
+                      std::int64_t optimum) const;
+
+  private:
+    Config config;
+};
+
+} // namespace aco
+
+#endif // ACO_BENCHMARK_HPP
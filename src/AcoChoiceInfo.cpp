@@ -0,0 +1,160 @@
+#include "AcoChoiceInfo.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+#include "AcoKernels.hpp"
+
+namespace aco {
+
+std::ostream& operator<<(std::ostream& out, Precision precision) {
+    switch (precision) {
+    case Precision::Float:
+        out << "float";
+        return out;
+    case Precision::BFloat16:
+        out << "bfloat16";
+        return out;
+    }
+
+    out << "unknown";
+    return out;
+}
+
+ChoiceInfo::ChoiceInfo(std::size_t nodes_arg, Precision precision_arg)
+    : precision(precision_arg), alpha(1), beta(1), values(), compact_values(), cumulative(),
+      nodes(0) {
+    resize(nodes_arg);
+}
+
+void ChoiceInfo::update(const Graph& graph) {
+    resize(graph.get_size());
+    update_rows(graph, graph.pheromones.data(), 0, nodes);
+}
+
+void ChoiceInfo::update_rows(const Graph& graph, const float* pheromones, std::size_t first_row,
+                             std::size_t last_row) {
+    for (std::size_t i = first_row; i < last_row; ++i) {
+        const auto offset = i * nodes;
+
+        // In reduced precision, the cumulative row is a workspace until the values are rounded
+        auto* row = precision == Precision::Float ? values.data() + offset
+                                                  : cumulative.data() + offset;
+        for (std::size_t j = 0; j < nodes; ++j) {
+            // Basic heuristic - just a reciprocal of the distance, so that shorter paths are
+            // preferred in general. There's no edge to self, leave it a score of zero.
+            row[j] = i == j ? 0.f : score(pheromones[offset + j], graph.costs[offset + j]);
+        }
+        if (precision == Precision::BFloat16) {
+            kernels::to_bfloat16(row, compact_values.data() + offset, nodes);
+        }
+    }
+
+    update_cumulative(first_row, last_row);
+}
+
+void ChoiceInfo::assign(const std::vector<float>& values_arg, std::size_t nodes_arg) {
+    if (values_arg.size() != nodes_arg * nodes_arg) {
+        std::cerr << "ChoiceInfo::assign: Incorrect values vector size! Expected: "
+                  << nodes_arg * nodes_arg << ", got: " << values_arg.size() << "\n";
+        throw std::invalid_argument("ChoiceInfo::assign: Incorrect values vector size!");
+    }
+
+    resize(nodes_arg);
+    if (precision == Precision::Float) {
+        std::copy(begin(values_arg), end(values_arg), begin(values));
+        for (std::size_t i = 0; i < nodes; ++i) {
+            values[i * nodes + i] = 0;
+        }
+    } else {
+        // Zero is exact in bfloat16 too
+        kernels::to_bfloat16(values_arg.data(), compact_values.data(), values_arg.size());
+        for (std::size_t i = 0; i < nodes; ++i) {
+            compact_values[i * nodes + i] = 0;
+        }
+    }
+
+    update_cumulative(0, nodes);
+}
+
+Graph::Index ChoiceInfo::sample(Graph::Index src, std::mt19937& gen) const {
+    const auto first = begin(cumulative) + src * nodes;
+    const auto last = first + nodes;
+
+    // The last element of the cumulative row is the sum of the whole row
+    std::uniform_real_distribution<float> distrib(0, *(last - 1));
+    float                                 random = distrib(gen);
+
+    // The first element greater than the random number. Elements with a score of zero can't be
+    // chosen this way, because their cumulative value is equal to the previous one.
+    auto found = std::upper_bound(first, last, random);
+    if (found == last) {
+        // Possible only due to floating point rounding
+        --found;
+    }
+
+    return found - first;
+}
+
+float ChoiceInfo::get(Graph::Index src, Graph::Index dst) const {
+    const auto index = src * nodes + dst;
+    return precision == Precision::Float ? values[index]
+                                         : kernels::from_bfloat16(compact_values[index]);
+}
+
+void ChoiceInfo::load_row(Graph::Index src, float* out) const {
+    const auto offset = src * nodes;
+    if (precision == Precision::Float) {
+        std::copy(begin(values) + offset, begin(values) + offset + nodes, out);
+    } else {
+        kernels::from_bfloat16(compact_values.data() + offset, out, nodes);
+    }
+}
+
+std::size_t ChoiceInfo::get_memory_usage() const {
+    return Footprint::capacity_bytes(values) + Footprint::capacity_bytes(compact_values) +
+           Footprint::capacity_bytes(cumulative);
+}
+
+void ChoiceInfo::resize(std::size_t nodes_arg) {
+    nodes = nodes_arg;
+    values.resize(precision == Precision::Float ? nodes * nodes : 0);
+    compact_values.resize(precision == Precision::BFloat16 ? nodes * nodes : 0);
+    cumulative.resize(nodes * nodes);
+}
+
+void ChoiceInfo::set_precision(Precision precision_arg) {
+    if (precision == precision_arg) {
+        return;
+    }
+
+    // Release the storage of the previous precision
+    precision = precision_arg;
+    values.clear();
+    values.shrink_to_fit();
+    compact_values.clear();
+    compact_values.shrink_to_fit();
+    resize(nodes);
+}
+
+void ChoiceInfo::set_exponents(float alpha_arg, float beta_arg) {
+    alpha = alpha_arg;
+    beta = beta_arg;
+}
+
+void ChoiceInfo::update_cumulative(std::size_t first_row, std::size_t last_row) {
+    for (std::size_t i = first_row; i < last_row; ++i) {
+        // Prefix sums of the stored values, in place
+        auto* row = cumulative.data() + i * nodes;
+        load_row(i, row);
+
+        float partial = 0;
+        for (std::size_t j = 0; j < nodes; ++j) {
+            partial += row[j];
+            row[j] = partial;
+        }
+    }
+}
+
+} // namespace aco
@@ -0,0 +1,103 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "AcoGraph.hpp"
+#include "HugePageAllocator.hpp"
+
+#ifndef ACO_CHOICE_INFO_HPP
+#define ACO_CHOICE_INFO_HPP
+
+namespace aco {
+
+// Storage precision of the choice info values:
+// * Float    - 32-bit floats, exact
+// * BFloat16 - 16-bit bfloat16 (see kernels::to_bfloat16), with a relative error of at most 2^-8.
+//              Halves the memory traffic of the exact scan over a row, which dominates the tour
+//              construction on big graphs. bfloat16 is used instead of IEEE half floats, because
+//              choice info values (pheromone / cost) easily go below the range of the latter.
+enum class Precision { Float, BFloat16 };
+
+std::ostream& operator<<(std::ostream&, Precision);
+
+// Combined pheromone and heuristic information ("choice info") for every edge of a graph, which is
+// the desire of an ant to go from one city to the other: pheromone^alpha * (1 / cost)^beta.
+// Along with the values, cumulative (prefix-sum) rows are kept, so that a destination can be drawn
+// in O(log n) instead of summing a full row of scores on every step. Meant to be rebuilt once per
+// iteration, after the pheromone update, and then only read by the ants.
+// Cumulative rows are always floats, calculated from the stored (possibly rounded) values, so that
+// sampling and the exact scan follow the same probabilities.
+// Accessors don't validate indices, they are meant to be used in hot loops.
+class ChoiceInfo {
+  public:
+    explicit ChoiceInfo(std::size_t nodes = 0, Precision precision = Precision::Float);
+
+  public:
+    // Recalculate all values from the graph. Reuses already allocated memory if possible.
+    void update(const Graph& graph);
+
+    // Set values calculated elsewhere (e.g. on GPU), given as a full nodes * nodes matrix. Values
+    // on the diagonal are ignored. Throws std::invalid_argument on incorrect size.
+    void assign(const std::vector<float>& values, std::size_t nodes);
+
+    // Recalculate rows [first_row, last_row) from the graph costs and the given pheromones, instead
+    // of the graph ones (e.g. a back buffer of a pipeline). The size must already be set with
+    // resize(). Different rows can be updated concurrently.
+    void update_rows(const Graph& graph, const float* pheromones, std::size_t first_row,
+                     std::size_t last_row);
+
+    // Change the number of nodes, without recalculating anything
+    void resize(std::size_t nodes);
+
+    // Change the storage precision. Values have to be recalculated afterwards.
+    void      set_precision(Precision precision);
+    Precision get_precision() const { return precision; }
+
+    // Change the weights of the pheromone (alpha) and of the heuristic (beta). Values have to be
+    // recalculated afterwards.
+    void set_exponents(float alpha, float beta);
+
+    // The choice info of a single edge, as calculated by update()
+    float score(float pheromone, int cost) const { return score(pheromone, cost, alpha, beta); }
+
+    // The same with the given weights, for consumers which don't store a choice info
+    static float score(float pheromone, int cost, float alpha, float beta) {
+        // Plain division in the default case, pow() is expensive
+        if (alpha == 1.f && beta == 1.f) {
+            return pheromone / cost;
+        }
+        return std::pow(pheromone, alpha) * std::pow(1.f / cost, beta);
+    }
+
+    std::size_t get_size() const { return nodes; }
+    float       get(Graph::Index src, Graph::Index dst) const;
+
+    // Write the values of the row of 'src' to 'out', which must hold get_size() elements
+    void load_row(Graph::Index src, float* out) const;
+
+    // Bytes held by the values and the cumulative rows, including the reserved capacity
+    std::size_t get_memory_usage() const;
+
+    // Draw a destination from 'src' with probability proportional to its choice info. Visited
+    // cities are not taken into account, so it's up to the caller to reject them.
+    Graph::Index sample(Graph::Index src, std::mt19937& gen) const;
+
+  private:
+    void update_cumulative(std::size_t first_row, std::size_t last_row);
+
+  private:
+    Precision                         precision;
+    float                             alpha;
+    float                             beta;
+    utils::LargeVector<float>         values;         // Float precision only
+    utils::LargeVector<std::uint16_t> compact_values; // BFloat16 precision only
+    utils::LargeVector<float>         cumulative;
+    std::size_t                       nodes;
+};
+
+} // namespace aco
+
+#endif // ACO_CHOICE_INFO_HPP
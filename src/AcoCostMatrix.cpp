@@ -0,0 +1,121 @@
+#include "AcoCostMatrix.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+#include "ThreadPool.hpp"
+#include "Utils.hpp"
+
+namespace aco {
+
+CostMatrixBuilder::CostMatrixBuilder(const SparseGraph& network_arg, std::size_t threads_arg)
+    : network(network_arg), threads(threads_arg) {}
+
+Graph CostMatrixBuilder::build(const std::vector<Index>& stops, float initial_pheromone) const {
+    auto scoped = utils::scoped_time_measurement("CostMatrixBuilder: build");
+    auto nodes = stops.size();
+
+    // Step 1: the nodes of the network with a stop
+    std::vector<char> is_stop(network.get_size(), 0);
+    std::size_t       distinct = 0;
+    for (auto stop : stops) {
+        if (stop >= network.get_size()) {
+            std::cerr << "aco::CostMatrixBuilder invalid stop. Network size: "
+                      << network.get_size() << ", stop: " << stop << "\n";
+            throw std::invalid_argument("aco::CostMatrixBuilder invalid stop!");
+        }
+        distinct += !is_stop[stop];
+        is_stop[stop] = 1;
+    }
+
+    // Step 2: the graph, with the costs filled in place below
+    Graph graph({}, {}, 0, initial_pheromone);
+    graph.nodes = nodes;
+    graph.costs.resize(nodes * nodes);
+    graph.pheromones.assign(nodes * nodes, initial_pheromone);
+
+    // Step 3: a search per row, by chunks of rows so that tasks are not too small
+    utils::ThreadPool      pool(threads);
+    std::vector<Workspace> workspaces(pool.size());
+    const std::size_t      chunk = 16;
+    for (std::size_t first = 0; first < nodes; first += chunk) {
+        pool.submit([&, first](std::size_t worker) {
+            for (std::size_t source = first; source < std::min(nodes, first + chunk); ++source) {
+                search(stops, is_stop, distinct, source, workspaces[worker],
+                       graph.costs.data() + source * nodes);
+            }
+        });
+    }
+    pool.wait();
+
+    return graph;
+}
+
+void CostMatrixBuilder::search(const std::vector<Index>& stops, const std::vector<char>& is_stop,
+                               std::size_t distinct, std::size_t source, Workspace& workspace,
+                               int* row) const {
+    auto& distances = workspace.distances;
+    auto& reached = workspace.reached;
+    auto& heap = workspace.heap;
+
+    // Only the nodes reached by the previous search are reset, not the whole network
+    distances.resize(network.get_size(), -1);
+    for (auto node : reached) {
+        distances[node] = -1;
+    }
+    reached.clear();
+    heap.clear();
+
+    // Dijkstra with lazy deletion: a node may be in the heap more than once, only its first pop
+    // with the final distance counts
+    auto start = stops[source];
+    distances[start] = 0;
+    reached.push_back(start);
+    heap.push_back({0, start});
+
+    std::size_t settled = 0;
+    while (!heap.empty() && settled < distinct) {
+        std::pop_heap(begin(heap), end(heap), std::greater<>());
+        auto [distance, node] = heap.back();
+        heap.pop_back();
+        if (distance > distances[node]) {
+            continue;
+        }
+        settled += is_stop[node];
+
+        for (auto edge = network.edges_begin(node); edge < network.edges_end(node); ++edge) {
+            auto target = network.get_target(edge);
+            auto candidate = distance + network.get_cost(edge);
+            if (distances[target] < 0 || candidate < distances[target]) {
+                if (distances[target] < 0) {
+                    reached.push_back(target);
+                }
+                distances[target] = candidate;
+                heap.push_back({candidate, target});
+                std::push_heap(begin(heap), end(heap), std::greater<>());
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < stops.size(); ++i) {
+        auto distance = distances[stops[i]];
+        if (distance < 0) {
+            std::cerr << "aco::CostMatrixBuilder stop " << stops[i] << " is unreachable from "
+                      << start << "\n";
+            throw std::invalid_argument("aco::CostMatrixBuilder unreachable stop!");
+        }
+        if (distance > std::numeric_limits<int>::max()) {
+            std::cerr << "aco::CostMatrixBuilder path from " << start << " to " << stops[i]
+                      << " is too long: " << distance << "\n";
+            throw std::invalid_argument("aco::CostMatrixBuilder path too long!");
+        }
+        // Zero on the diagonal, like in the other graphs, but positive between two stops at the
+        // same node
+        row[i] = i == source ? 0 : std::max<int>(1, static_cast<int>(distance));
+    }
+}
+
+} // namespace aco
@@ -0,0 +1,55 @@
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "AcoGraph.hpp"
+#include "AcoSparseGraph.hpp"
+
+#ifndef ACO_COST_MATRIX_HPP
+#define ACO_COST_MATRIX_HPP
+
+namespace aco {
+
+// Builds the dense Graph over some nodes of a road network (e.g. delivery stops), where the cost
+// from one stop to another is the length of the shortest path between them in the network.
+// Every row of the matrix is a single Dijkstra search from its stop, stopped as soon as all the
+// stops are settled. The rows are independent, so they are spread over worker threads, each with
+// its own workspace (distances, heap), allocated once and reused for all its searches. The costs
+// are written straight into the graph, without an intermediate copy of the matrix, so that tens of
+// thousands of stops fit in memory.
+// One-way roads make the costs asymmetric. Two stops at the same node get a cost of 1, since
+// costs must be positive.
+class CostMatrixBuilder {
+  public:
+    using Index = SparseGraph::Index;
+
+  public:
+    // Zero threads means one per hardware thread
+    explicit CostMatrixBuilder(const SparseGraph& network, std::size_t threads = 0);
+
+    // Graph over the stops, node 'i' of the result is stops[i]. Throws std::invalid_argument on a
+    // stop out of range, a stop unreachable from another one, or a path too long for the costs.
+    Graph build(const std::vector<Index>& stops, float initial_pheromone) const;
+
+  private:
+    // Per thread, reused by all the searches of the thread
+    struct Workspace {
+        std::vector<std::int64_t>                   distances; // Per node, -1 when not reached
+        std::vector<Index>                          reached;   // To reset the above
+        std::vector<std::pair<std::int64_t, Index>> heap;      // Min-heap on distance
+    };
+
+    // Shortest paths from stops[source] to all the stops, into 'row'. 'is_stop' marks the nodes
+    // with a stop, 'distinct' is their number.
+    void search(const std::vector<Index>& stops, const std::vector<char>& is_stop,
+                std::size_t distinct, std::size_t source, Workspace& workspace, int* row) const;
+
+  private:
+    const SparseGraph& network;
+    std::size_t        threads;
+};
+
+} // namespace aco
+
+#endif // ACO_COST_MATRIX_HPP
@@ -0,0 +1,338 @@
+#include "AcoDecompositionSolver.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+#include "AcoReordering.hpp"
+#include "ThreadPool.hpp"
+
+namespace aco {
+
+// Candidates of every city for 2-opt
+static constexpr std::size_t neighbours_count = 8;
+
+// Cities around a stitch where 2-opt starts after the first round, on both sides
+static constexpr std::size_t stitch_window = 16;
+
+static constexpr float initial_pheromone = 0.01f;
+
+// Length of a path through the cities, without the way back
+static std::int64_t open_length(const std::vector<Point>& points, const Graph::Path& cities) {
+    std::int64_t length = 0;
+    for (std::size_t i = 0; i + 1 < cities.size(); ++i) {
+        length += DecompositionSolver::cost(points[cities[i]], points[cities[i + 1]]);
+    }
+    return length;
+}
+
+// Cut 'count' parts of nearly the same size from 'sequence', starting at 'offset', cyclically
+static std::vector<Graph::Path> cut(const Graph::Path& sequence, std::size_t count,
+                                    std::size_t offset) {
+    auto                     n = sequence.size();
+    std::vector<Graph::Path> parts(count);
+    for (std::size_t part = 0; part < count; ++part) {
+        for (auto i = part * n / count; i < (part + 1) * n / count; ++i) {
+            parts[part].push_back(sequence[(offset + i) % n]);
+        }
+    }
+    return parts;
+}
+
+// Append a closed tour to the path, opened at the edge that is the cheapest to enter from the last
+// city of the path, in either direction. The first tour is opened at its longest edge.
+static void stitch(const std::vector<Point>& points, const Graph::Path& tour, Graph::Path& path) {
+    using Solver = DecompositionSolver;
+    auto m = tour.size();
+
+    std::size_t best_edge = 0;
+    bool        best_forward = true;
+    auto        best_cost = std::numeric_limits<std::int64_t>::max();
+    for (std::size_t i = 0; i < m; ++i) {
+        // Edge from tour[i] to tour[i + 1] is removed
+        auto a = tour[i];
+        auto b = tour[(i + 1) % m];
+        auto removed = m > 1 ? Solver::cost(points[a], points[b]) : 0;
+        if (path.empty()) {
+            if (-removed < best_cost) {
+                best_cost = -removed;
+                best_edge = i;
+            }
+            continue;
+        }
+
+        const auto& last = points[path.back()];
+        auto        forward = Solver::cost(last, points[b]) - removed;  // b, ..., a
+        auto        backward = Solver::cost(last, points[a]) - removed; // a, ..., b
+        if (forward < best_cost) {
+            best_cost = forward;
+            best_edge = i;
+            best_forward = true;
+        }
+        if (backward < best_cost) {
+            best_cost = backward;
+            best_edge = i;
+            best_forward = false;
+        }
+    }
+
+    for (std::size_t i = 0; i < m; ++i) {
+        path.push_back(best_forward ? tour[(best_edge + 1 + i) % m]
+                                    : tour[(best_edge + m - i) % m]);
+    }
+}
+
+// 2-opt over the nearest neighbours, with a queue of cities to look at (the don't look bits are
+// off for the cities in the queue). Starts from the 'active' cities, the ends of every improving
+// move are looked at again. Segments are reversed on the shorter side of the tour.
+static void two_opt(const std::vector<Point>& points, const std::vector<SpatialIndex::Index>& lists,
+                    std::size_t k, Graph::Path& path, const std::vector<Graph::Index>& active) {
+    using Solver = DecompositionSolver;
+    const auto               n = path.size();
+    std::vector<std::size_t> position(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        position[path[i]] = i;
+    }
+    auto next = [&](Graph::Index city) { return path[(position[city] + 1) % n]; };
+    auto previous = [&](Graph::Index city) { return path[(position[city] + n - 1) % n]; };
+
+    // Reverse the cities from position 'first' to 'last' (inclusive, cyclically)
+    auto reverse = [&](std::size_t first, std::size_t last) {
+        auto length = (last + n - first) % n + 1;
+        if (2 * length > n) {
+            // The rest of the tour, the same tour in the other direction
+            auto rest_first = (last + 1) % n;
+            last = (first + n - 1) % n;
+            first = rest_first;
+            length = n - length;
+        }
+        for (std::size_t i = 0; i < length / 2; ++i) {
+            auto a = (first + i) % n;
+            auto b = (last + n - i) % n;
+            std::swap(path[a], path[b]);
+            position[path[a]] = a;
+            position[path[b]] = b;
+        }
+    };
+
+    std::deque<Graph::Index> queue;
+    std::vector<char>        queued(n, 0);
+    auto                     push = [&](Graph::Index city) {
+        if (!queued[city]) {
+            queued[city] = 1;
+            queue.push_back(city);
+        }
+    };
+    for (auto city : active) {
+        push(city);
+    }
+
+    while (!queue.empty()) {
+        auto a = queue.front();
+        queue.pop_front();
+        queued[a] = 0;
+
+        // Both tour edges of 'a': (a, succ(a)) replaced with (a, c), (succ(a), succ(c)), and
+        // (pred(a), a) replaced with (c, a), (pred(c), pred(a))
+        for (bool forward : {true, false}) {
+            auto b = forward ? next(a) : previous(a);
+            auto ab = Solver::cost(points[a], points[b]);
+
+            bool improved = false;
+            for (std::size_t i = 0; i < k && !improved; ++i) {
+                auto c = lists[a * k + i];
+                auto ac = Solver::cost(points[a], points[c]);
+                if (ac >= ab) {
+                    break; // Neighbours are sorted, none of the following can be better
+                }
+                auto d = forward ? next(c) : previous(c);
+                if (c == b || d == a) {
+                    continue;
+                }
+
+                auto bd = Solver::cost(points[b], points[d]);
+                auto cd = Solver::cost(points[c], points[d]);
+                if (ac + bd < ab + cd) {
+                    if (forward) {
+                        reverse(position[b], position[c]);
+                    } else {
+                        reverse(position[c], position[b]);
+                    }
+                    for (auto city : {a, b, c, d}) {
+                        push(city);
+                    }
+                    improved = true;
+                }
+            }
+            if (improved) {
+                break;
+            }
+        }
+    }
+}
+
+DecompositionSolver::DecompositionSolver(Config config_arg) : config(config_arg) {
+    if (config.cluster_size < 3) {
+        std::cerr << "aco::DecompositionSolver invalid argument. Cluster size should be at least "
+                     "3!\n";
+        throw std::invalid_argument("aco::DecompositionSolver invalid cluster size argument!");
+    }
+    if (config.agents_per_node == 0) {
+        std::cerr << "aco::DecompositionSolver invalid argument. Agents per node should be "
+                     "non-zero!\n";
+        throw std::invalid_argument("aco::DecompositionSolver invalid agents per node argument!");
+    }
+    if (config.rounds == 0) {
+        std::cerr << "aco::DecompositionSolver invalid argument. Rounds should be non-zero!\n";
+        throw std::invalid_argument("aco::DecompositionSolver invalid rounds argument!");
+    }
+    if (config.budget.max_iterations <= 0 && config.budget.time_limit.count() <= 0 &&
+        config.budget.max_stagnation <= 0) {
+        std::cerr << "aco::DecompositionSolver invalid argument. Budget should limit iterations, "
+                     "time or stagnation!\n";
+        throw std::invalid_argument("aco::DecompositionSolver invalid budget argument!");
+    }
+}
+
+int DecompositionSolver::cost(const Point& a, const Point& b) {
+    return std::max(1, static_cast<int>(std::hypot(a.x - b.x, a.y - b.y) + 0.5));
+}
+
+std::int64_t DecompositionSolver::tour_length(const std::vector<Point>& points,
+                                              const Graph::Path& path) {
+    if (path.empty()) {
+        return 0;
+    }
+    return open_length(points, path) + cost(points[path.back()], points[path.front()]);
+}
+
+DecompositionSolver::Result DecompositionSolver::solve(const std::vector<Point>& points) const {
+    if (points.size() < 3) {
+        std::cerr << "aco::DecompositionSolver::solve at least 3 points are required, got: "
+                  << points.size() << "\n";
+        throw std::invalid_argument("aco::DecompositionSolver::solve too few points!");
+    }
+    auto begin_time = std::chrono::steady_clock::now();
+    auto n = points.size();
+    auto parts = (n + config.cluster_size - 1) / config.cluster_size;
+
+    utils::ThreadPool      pool(config.threads);
+    std::vector<Workspace> workspaces(pool.size());
+
+    auto k = std::min(neighbours_count, n - 1);
+    auto lists = SpatialIndex(points).neighbour_lists(k, config.threads);
+
+    Result result{{}, 0, {}, parts, {}};
+
+    // Step 1: clusters along the curve, solved independently
+    auto                     clusters = cut(Reordering::hilbert(points).get_order(), parts, 0);
+    std::vector<Graph::Path> tours(parts);
+    for (std::size_t i = 0; i < parts; ++i) {
+        pool.submit([&, i](std::size_t worker) {
+            tours[i] = solve_part(points, clusters[i], false, config.seed + i, workspaces[worker]);
+        });
+    }
+    pool.wait();
+
+    // Step 2: stitching, and 2-opt around the stitches
+    std::vector<std::size_t> stitches;
+    for (const auto& tour : tours) {
+        stitches.push_back(result.path.size());
+        stitch(points, tour, result.path);
+    }
+    std::vector<Graph::Index> active;
+    for (auto stitch_position : stitches) {
+        for (std::size_t i = 0; i < std::min(2 * stitch_window, n); ++i) {
+            active.push_back(result.path[(stitch_position + n - stitch_window + i) % n]);
+        }
+    }
+    two_opt(points, lists, k, result.path, active);
+    result.round_lengths.push_back(tour_length(points, result.path));
+
+    // Step 3: segments of the tour, shifted in every round, re-solved with their ends fixed
+    for (std::size_t round = 1; round < config.rounds; ++round) {
+        auto offset = round * config.cluster_size / 2 % n;
+        auto segments = cut(result.path, parts, offset);
+        for (std::size_t i = 0; i < parts; ++i) {
+            pool.submit([&, round, i](std::size_t worker) {
+                auto seed = config.seed + round * parts + i;
+                auto segment = solve_part(points, segments[i], true, seed, workspaces[worker]);
+                if (!segment.empty() &&
+                    open_length(points, segment) < open_length(points, segments[i])) {
+                    segments[i] = std::move(segment);
+                }
+            });
+        }
+        pool.wait();
+
+        result.path.clear();
+        for (const auto& segment : segments) {
+            result.path.insert(end(result.path), begin(segment), end(segment));
+        }
+        auto all = result.path;
+        two_opt(points, lists, k, result.path, all);
+        result.round_lengths.push_back(tour_length(points, result.path));
+    }
+
+    result.length = result.round_lengths.back();
+    result.time = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - begin_time);
+    return result;
+}
+
+Graph::Path DecompositionSolver::solve_part(const std::vector<Point>& points,
+                                            const Graph::Path& cities, bool fixed_ends,
+                                            std::uint32_t seed, Workspace& workspace) const {
+    // Nothing to choose from
+    auto m = cities.size();
+    if (m < (fixed_ends ? 4 : 3)) {
+        return cities;
+    }
+
+    std::vector<Point> part_points;
+    for (auto city : cities) {
+        part_points.push_back(points[city]);
+    }
+    auto graph = Graph::from_points(part_points, initial_pheromone);
+    if (fixed_ends) {
+        graph.set_cost(0, m - 1, 1);
+        graph.set_cost(m - 1, 0, 1);
+    }
+
+    // Results don't depend on which worker solves the part
+    workspace.gen.seed(seed);
+    Algorithm::Config algorithm_config{m * config.agents_per_node, config.pheromone_evaporation};
+    algorithm_config.threads = 1;
+    if (!workspace.algorithm) {
+        workspace.algorithm =
+            Algorithm::make(config.device, workspace.gen, graph, algorithm_config);
+    } else {
+        workspace.algorithm->reset(graph, algorithm_config);
+    }
+    auto tour = Solver(*workspace.algorithm, config.budget).run().path;
+
+    // A closed tour can start anywhere, a path with fixed ends starts with the first city, and
+    // the last one must be next to it in the tour
+    auto first = std::find(begin(tour), end(tour), 0) - begin(tour);
+    bool forward = true;
+    if (fixed_ends) {
+        if (tour[(first + m - 1) % m] == m - 1) {
+            forward = true;
+        } else if (tour[(first + 1) % m] == m - 1) {
+            forward = false;
+        } else {
+            return {};
+        }
+    }
+
+    Graph::Path result(m);
+    for (std::size_t i = 0; i < m; ++i) {
+        result[i] = cities[tour[forward ? (first + i) % m : (first + m - i) % m]];
+    }
+    return result;
+}
+
+} // namespace aco
@@ -0,0 +1,87 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "AcoAlgorithm.hpp"
+#include "AcoGraph.hpp"
+#include "AcoSolver.hpp"
+#include "AcoSpatialIndex.hpp"
+
+#ifndef ACO_DECOMPOSITION_SOLVER_HPP
+#define ACO_DECOMPOSITION_SOLVER_HPP
+
+namespace aco {
+
+// Solves instances far too big for a single colony (and for a dense cost matrix), given by city
+// coordinates, by divide and conquer:
+// 1. cities are ordered along a Hilbert curve and cut into clusters of up to 'cluster_size'
+//    consecutive cities, so that every cluster is spatially compact,
+// 2. every cluster is solved as a small instance by its own algorithm (see Algorithm::make), in
+//    parallel,
+// 3. cluster tours are opened and stitched in the curve order,
+// 4. the stitched tour is refined by 2-opt over nearest-neighbour candidates, starting from the
+//    cities around the stitches,
+// 5. every following round cuts the tour into segments again, shifted by half a segment against
+//    the previous round, so that the earlier boundaries fall inside of the segments. Segments are
+//    re-solved in parallel with their ends fixed, a shorter one replaces the original, and the
+//    whole tour is refined by 2-opt again.
+// Costs are Euclidean distances rounded like in Graph::from_points. Results don't depend on the
+// number of threads.
+class DecompositionSolver {
+  public:
+    struct Config {
+        DeviceType           device;
+        std::size_t          threads;         // Zero means one per hardware thread
+        std::size_t          cluster_size;    // Cities per cluster or segment, at most
+        std::size_t          agents_per_node; // Agents count of a cluster is this times its size
+        float                pheromone_evaporation;
+        Solver::StopCriteria budget; // Per cluster or segment
+        std::size_t          rounds; // The first one solves the clusters, later ones the segments
+        std::uint32_t        seed;
+    };
+
+    struct Result {
+        Graph::Path               path;
+        std::int64_t              length;
+        std::vector<std::int64_t> round_lengths; // After every round, including the refinement
+        std::size_t               clusters;      // In the first round
+        std::chrono::milliseconds time;
+    };
+
+  public:
+    // Throws std::invalid_argument on invalid configuration.
+    explicit DecompositionSolver(Config config);
+
+  public:
+    // Throws std::invalid_argument if there are fewer than 3 points.
+    Result solve(const std::vector<Point>& points) const;
+
+    // Cost of the edge between two points, as in Graph::from_points
+    static int cost(const Point& a, const Point& b);
+
+    // Length of a closed tour through the points
+    static std::int64_t tour_length(const std::vector<Point>& points, const Graph::Path& path);
+
+  private:
+    // Everything a single worker needs, reused between sub-problems
+    struct Workspace {
+        std::mt19937               gen;
+        std::unique_ptr<Algorithm> algorithm;
+    };
+
+    // Solve the cities as a closed tour, returned in the order of the cities of the input. With
+    // 'fixed_ends', the first and the last city are made adjacent, and the tour is returned as a
+    // path between them, or empty if the algorithm didn't connect them.
+    Graph::Path solve_part(const std::vector<Point>& points, const Graph::Path& cities,
+                           bool fixed_ends, std::uint32_t seed, Workspace& workspace) const;
+
+  private:
+    Config config;
+};
+
+} // namespace aco
+
+#endif // ACO_DECOMPOSITION_SOLVER_HPP
@@ -0,0 +1,42 @@
+#include "AcoDepositBuffer.hpp"
+
+#include <iostream>
+#include <stdexcept>
+
+#include "AcoFootprint.hpp"
+
+namespace aco {
+
+void DepositBuffer::group_by_row(std::size_t nodes) {
+    // Step 1: count deposits per row, validate on the way
+    row_offsets.assign(nodes + 1, 0);
+    for (const auto& edge : edges) {
+        if (edge.a == edge.b || edge.a >= nodes || edge.b >= nodes) {
+            std::cerr << "aco::DepositBuffer invalid edge. Graph size: " << nodes
+                      << ", a: " << edge.a << ", b: " << edge.b << std::endl;
+            throw std::invalid_argument("aco::DepositBuffer invalid edge!");
+        }
+        ++row_offsets[edge.a + 1];
+        ++row_offsets[edge.b + 1];
+    }
+
+    // Step 2: prefix sum gives the first position of every row
+    for (std::size_t i = 0; i < nodes; ++i) {
+        row_offsets[i + 1] += row_offsets[i];
+    }
+
+    // Step 3: scatter, in order of addition. Positions are advanced in a copy of the offsets.
+    grouped.resize(size());
+    positions.assign(begin(row_offsets), end(row_offsets) - 1);
+    for (const auto& edge : edges) {
+        grouped[positions[edge.a]++] = {edge.b, edge.amount};
+        grouped[positions[edge.b]++] = {edge.a, edge.amount};
+    }
+}
+
+std::size_t DepositBuffer::get_memory_usage() const {
+    return Footprint::capacity_bytes(edges) + Footprint::capacity_bytes(grouped) +
+           Footprint::capacity_bytes(row_offsets) + Footprint::capacity_bytes(positions);
+}
+
+} // namespace aco
@@ -0,0 +1,60 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#ifndef ACO_DEPOSIT_BUFFER_HPP
+#define ACO_DEPOSIT_BUFFER_HPP
+
+namespace aco {
+
+// Pheromone deposits collected during an iteration, to be applied to the graph in a single pass.
+// Instead of scattering additions all over the pheromone matrix as ants are processed, deposits are
+// grouped by source row (stable counting sort), so that every row is updated while it's in cache,
+// in the same order as it was added.
+// Memory is reused between iterations.
+class DepositBuffer {
+  public:
+    // A single deposit, after grouping
+    struct Entry {
+        std::uint32_t dst;
+        float         amount;
+    };
+
+  public:
+    void clear() { edges.clear(); }
+    void reserve(std::size_t count) { edges.reserve(count); }
+
+    std::size_t size() const { return edges.size() * 2; }
+
+    // Add the same amount on both a -> b and b -> a edges.
+    void add_two_way(std::size_t a, std::size_t b, float amount) {
+        edges.push_back({static_cast<std::uint32_t>(a), static_cast<std::uint32_t>(b), amount});
+    }
+
+    // Group deposits by source row, for a graph with given number of nodes. Throws
+    // std::invalid_argument when any of the edges is invalid (out of range or to self).
+    void group_by_row(std::size_t nodes);
+
+    // Bytes held by the buffers, including the reserved capacity
+    std::size_t get_memory_usage() const;
+
+    // Grouped deposits of a single row, valid after group_by_row()
+    const Entry* row_begin(std::size_t row) const { return grouped.data() + row_offsets[row]; }
+    const Entry* row_end(std::size_t row) const { return grouped.data() + row_offsets[row + 1]; }
+
+  private:
+    struct Edge {
+        std::uint32_t a;
+        std::uint32_t b;
+        float         amount;
+    };
+
+    std::vector<Edge>        edges;
+    std::vector<Entry>       grouped;
+    std::vector<std::size_t> row_offsets;
+    std::vector<std::size_t> positions;
+};
+
+} // namespace aco
+
+#endif // ACO_DEPOSIT_BUFFER_HPP
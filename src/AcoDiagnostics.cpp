@@ -0,0 +1,143 @@
+#include "AcoDiagnostics.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace aco {
+
+Diagnostics::Diagnostics(float lambda_arg)
+    : lambda(lambda_arg), next_row(0), next_tour(0), row_values(), successors(), predecessors() {}
+
+// Copy of a row of the graph, the graph has no edge to self
+static void load_graph_row(const Graph& graph, Graph::Index row, float* values) {
+    for (Graph::Index j = 0; j < graph.get_size(); ++j) {
+        values[j] = j != row ? graph.get_pheromone(row, j) : 0.f;
+    }
+}
+
+Diagnostics::Snapshot Diagnostics::measure(const Graph& graph, const Graph::Index* tours,
+                                           std::size_t count, std::size_t samples) {
+    auto load_row = [&](Graph::Index row, float* values) { load_graph_row(graph, row, values); };
+    return measure(graph.get_size(), load_row, tours, count, samples);
+}
+
+Diagnostics::Snapshot Diagnostics::measure(std::size_t nodes, const RowLoader& load_row,
+                                           const Graph::Index* tours, std::size_t count,
+                                           std::size_t samples) {
+    Snapshot snapshot;
+    if (nodes < 2 || samples == 0) {
+        return snapshot;
+    }
+
+    // Step 1: rows, at most all of them
+    auto   rows = std::min(samples, nodes);
+    double branching_sum = 0;
+    double entropy_sum = 0;
+    row_values.resize(nodes);
+    for (std::size_t i = 0; i < rows; ++i) {
+        auto row = (next_row + i) % nodes;
+        load_row(row, row_values.data());
+        branching_sum += branching_factor(row_values.data(), nodes, row, lambda);
+        entropy_sum += entropy(row_values.data(), nodes, row);
+    }
+    next_row = (next_row + rows) % nodes;
+    snapshot.branching_factor = branching_sum / rows;
+    snapshot.entropy = entropy_sum / rows;
+
+    // Step 2: pairs of tours, half of the tours apart. Neighbouring tours start from neighbouring
+    // nodes, those apart are less likely to be correlated.
+    if (tours == nullptr || count < 2) {
+        return snapshot;
+    }
+    double distance_sum = 0;
+    for (std::size_t i = 0; i < samples; ++i) {
+        auto a = (next_tour + i) % count;
+        auto b = (a + count / 2) % count;
+        distance_sum += distance(tours + a * nodes, tours + b * nodes, nodes);
+    }
+    next_tour = (next_tour + samples) % count;
+    snapshot.diversity = distance_sum / samples;
+
+    return snapshot;
+}
+
+double Diagnostics::branching_factor(const Graph& graph, Graph::Index row, float lambda) {
+    std::vector<float> values(graph.get_size());
+    load_graph_row(graph, row, values.data());
+    return branching_factor(values.data(), values.size(), row, lambda);
+}
+
+double Diagnostics::entropy(const Graph& graph, Graph::Index row) {
+    std::vector<float> values(graph.get_size());
+    load_graph_row(graph, row, values.data());
+    return entropy(values.data(), values.size(), row);
+}
+
+double Diagnostics::branching_factor(const float* values, std::size_t nodes, Graph::Index row,
+                                     float lambda) {
+    float min = std::numeric_limits<float>::max();
+    float max = 0;
+    for (Graph::Index j = 0; j < nodes; ++j) {
+        if (j != row) {
+            min = std::min(min, values[j]);
+            max = std::max(max, values[j]);
+        }
+    }
+
+    auto        threshold = min + lambda * (max - min);
+    std::size_t branches = 0;
+    for (Graph::Index j = 0; j < nodes; ++j) {
+        branches += j != row && values[j] >= threshold;
+    }
+    return branches;
+}
+
+double Diagnostics::entropy(const float* values, std::size_t nodes, Graph::Index row) {
+    // With a single edge there is no choice, nothing to normalize by
+    if (nodes <= 2) {
+        return 0;
+    }
+
+    double sum = 0;
+    for (Graph::Index j = 0; j < nodes; ++j) {
+        sum += j != row ? values[j] : 0.f;
+    }
+    if (sum <= 0) {
+        return 0;
+    }
+
+    double result = 0;
+    for (Graph::Index j = 0; j < nodes; ++j) {
+        if (j == row) {
+            continue;
+        }
+        auto probability = values[j] / sum;
+        if (probability > 0) {
+            result -= probability * std::log(probability);
+        }
+    }
+    return result / std::log(double(nodes - 1));
+}
+
+double Diagnostics::distance(const Graph::Index* a, const Graph::Index* b, std::size_t nodes) {
+    if (nodes < 2) {
+        return 0;
+    }
+
+    successors.resize(nodes);
+    predecessors.resize(nodes);
+    for (std::size_t i = 0; i < nodes; ++i) {
+        successors[a[i]] = a[(i + 1) % nodes];
+        predecessors[a[(i + 1) % nodes]] = a[i];
+    }
+
+    std::size_t shared = 0;
+    for (std::size_t i = 0; i < nodes; ++i) {
+        auto src = b[i];
+        auto dst = b[(i + 1) % nodes];
+        shared += successors[src] == dst || predecessors[src] == dst;
+    }
+    return 1 - double(shared) / nodes;
+}
+
+} // namespace aco
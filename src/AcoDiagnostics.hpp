@@ -0,0 +1,78 @@
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#include "AcoGraph.hpp"
+
+#ifndef ACO_DIAGNOSTICS_HPP
+#define ACO_DIAGNOSTICS_HPP
+
+namespace aco {
+
+// Convergence signals of the search state, meant to decide when to stop or restart:
+// - lambda-branching factor: for a node, the number of edges whose pheromone is at least
+//   min + lambda * (max - min) of its row. Starts at nodes - 1 and goes down to about 2 (the two
+//   edges of a tour, pheromones are deposited both ways) when all ants follow the same tour.
+// - entropy of the pheromones of a row, seen as a probability distribution, divided by its
+//   maximum: 1 for uniform pheromones, close to 0 when converged.
+// - diversity: the mean edge distance between pairs of tours of an iteration, the fraction of
+//   edges of one tour that are not in the other one (in either direction). 0 when all the same.
+// Everything is sampled: a few rows and pairs of tours per call, rotating over all of them between
+// calls, so that the cost is linear in the number of nodes (an iteration is at least quadratic).
+class Diagnostics {
+  public:
+    struct Snapshot {
+        // NaN if not available, e.g. diversity when tours are not known
+        double branching_factor = std::numeric_limits<double>::quiet_NaN(); // Mean of the rows
+        double entropy = std::numeric_limits<double>::quiet_NaN();          // Mean of the rows
+        double diversity = std::numeric_limits<double>::quiet_NaN();        // Mean of the pairs
+    };
+
+    // Copies the pheromones of a row into 'values' (nodes of them, the one of the edge to self is
+    // ignored). Only the sampled rows are loaded, so algorithms keeping pheromones on a device
+    // don't have to copy all of them.
+    using RowLoader = std::function<void(Graph::Index row, float* values)>;
+
+  public:
+    explicit Diagnostics(float lambda = 0.05f);
+
+  public:
+    // Measure 'samples' rows of the pheromones and pairs of 'count' tours, given one after the
+    // other ('nodes' nodes each). 'tours' may be nullptr, then diversity is not measured.
+    Snapshot measure(std::size_t nodes, const RowLoader& load_row, const Graph::Index* tours,
+                     std::size_t count, std::size_t samples);
+
+    // Same as above, with the rows of 'graph'
+    Snapshot measure(const Graph& graph, const Graph::Index* tours, std::size_t count,
+                     std::size_t samples);
+
+    // Single row measurements, of the pheromones of 'row' given in 'values' (nodes of them). The
+    // edge to self is skipped.
+    static double branching_factor(const float* values, std::size_t nodes, Graph::Index row,
+                                   float lambda);
+    static double entropy(const float* values, std::size_t nodes, Graph::Index row);
+
+    // Same as above, with the row of 'graph'
+    static double branching_factor(const Graph& graph, Graph::Index row, float lambda);
+    static double entropy(const Graph& graph, Graph::Index row);
+
+    // Edge distance of two tours of 'nodes' nodes, in [0,1]
+    double distance(const Graph::Index* a, const Graph::Index* b, std::size_t nodes);
+
+  private:
+    float lambda;
+
+    // Rotation of the samples between calls
+    std::size_t next_row;
+    std::size_t next_tour;
+
+    // Workspaces: the sampled row, neighbours of every node in the first tour of a pair
+    std::vector<float>        row_values;
+    std::vector<Graph::Index> successors;
+    std::vector<Graph::Index> predecessors;
+};
+
+} // namespace aco
+
+#endif // ACO_DIAGNOSTICS_HPP
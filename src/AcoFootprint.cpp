@@ -0,0 +1,51 @@
+#include "AcoFootprint.hpp"
+
+#include <algorithm>
+#include <iomanip>
+
+namespace aco {
+
+void Footprint::add(const std::string& name, std::size_t bytes) {
+    auto found = std::find_if(begin(entries), end(entries),
+                              [&](const Entry& entry) { return entry.name == name; });
+    if (found != end(entries)) {
+        found->bytes += bytes;
+    } else {
+        entries.push_back({name, bytes});
+    }
+}
+
+void Footprint::add(const Footprint& other) {
+    for (const auto& entry : other.entries) {
+        add(entry.name, entry.bytes);
+    }
+}
+
+std::size_t Footprint::get(const std::string& name) const {
+    auto found = std::find_if(begin(entries), end(entries),
+                              [&](const Entry& entry) { return entry.name == name; });
+    return found != end(entries) ? found->bytes : 0;
+}
+
+std::size_t Footprint::total() const {
+    std::size_t result = 0;
+    for (const auto& entry : entries) {
+        result += entry.bytes;
+    }
+    return result;
+}
+
+std::ostream& operator<<(std::ostream& out, const Footprint& footprint) {
+    auto flags = out.flags();
+    auto precision = out.precision();
+    out << std::fixed << std::setprecision(2);
+    for (const auto& entry : footprint.get_entries()) {
+        out << entry.name << ": " << entry.bytes / double(1 << 20) << " MiB\n";
+    }
+    out << "total: " << footprint.total() / double(1 << 20) << " MiB\n";
+    out.flags(flags);
+    out.precision(precision);
+    return out;
+}
+
+} // namespace aco
@@ -0,0 +1,51 @@
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "HugePageAllocator.hpp"
+
+#ifndef ACO_FOOTPRINT_HPP
+#define ACO_FOOTPRINT_HPP
+
+namespace aco {
+
+// Memory held by the data structures of a solver, in bytes, by structure. Only the structures
+// which grow with nodes^2 or with agents * nodes are listed, per tour workspaces are negligible
+// next to them. See Algorithm::get_footprint and predict_footprint.
+class Footprint {
+  public:
+    struct Entry {
+        std::string name;
+        std::size_t bytes;
+    };
+
+  public:
+    // Adds to the entry of the same name if there is one, e.g. for replicas of a structure
+    void add(const std::string& name, std::size_t bytes);
+    void add(const Footprint& other);
+
+    std::size_t               get(const std::string& name) const; // Zero if not listed
+    std::size_t               total() const;
+    const std::vector<Entry>& get_entries() const { return entries; }
+
+    // Allocated memory of a vector, not just the used part
+    template <typename Vector> static std::size_t capacity_bytes(const Vector& vector) {
+        return vector.capacity() * sizeof(typename Vector::value_type);
+    }
+
+    // Large vectors are padded, up to a whole number of huge pages once they reach one
+    template <typename T> static std::size_t capacity_bytes(const utils::LargeVector<T>& vector) {
+        return utils::allocation_size(vector.capacity() * sizeof(T));
+    }
+
+  private:
+    std::vector<Entry> entries;
+};
+
+// One line per entry and then the total, in MiB
+std::ostream& operator<<(std::ostream&, const Footprint&);
+
+} // namespace aco
+
+#endif // ACO_FOOTPRINT_HPP
@@ -1,10 +1,15 @@
 #include "AcoGraph.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <sstream>
 #include <stdexcept>
+#include <thread>
 
 #include "../third_party/nlohmann/json.hpp"
+#include "AcoKernels.hpp"
 
 namespace aco {
 
@@ -26,7 +31,8 @@ Graph::Graph(std::mt19937& random_generator, std::size_t nodes_input, float init
 
 Graph::Graph(std::vector<int> costs_arg, std::vector<float> pheromones_arg, std::size_t nodes,
              float initial_pheromone)
-    : costs(std::move(costs_arg)), pheromones(std::move(pheromones_arg)), nodes(nodes),
+    : costs(begin(costs_arg), end(costs_arg)),
+      pheromones(begin(pheromones_arg), end(pheromones_arg)), nodes(nodes),
       initial_pheromone(initial_pheromone) {
     // Verify the sizes of containers
     const auto expected_size = nodes * nodes;
@@ -43,6 +49,22 @@ Graph::Graph(std::vector<int> costs_arg, std::vector<float> pheromones_arg, std:
     }
 }
 
+Graph Graph::from_points(const std::vector<Point>& points, float initial_pheromone) {
+    auto             nodes = points.size();
+    std::vector<int> costs(nodes * nodes);
+    for (std::size_t i = 0; i < nodes; ++i) {
+        for (std::size_t j = i + 1; j < nodes; ++j) {
+            auto distance = std::hypot(points[i].x - points[j].x, points[i].y - points[j].y);
+            auto cost = std::max(1, static_cast<int>(distance + 0.5));
+            costs[i * nodes + j] = cost;
+            costs[j * nodes + i] = cost;
+        }
+    }
+
+    std::vector<float> pheromones(nodes * nodes, initial_pheromone);
+    return Graph(std::move(costs), std::move(pheromones), nodes, initial_pheromone);
+}
+
 std::size_t Graph::get_size() const {
     return nodes;
 }
@@ -70,8 +92,203 @@ void Graph::add_pheromone_two_way(Index a, Index b, float amount) {
 }
 
 void Graph::update_all(float coefficient) {
-    std::transform(begin(pheromones), end(pheromones), begin(pheromones),
-                   [&](auto elem) { return std::max(elem * coefficient, initial_pheromone); });
+    kernels::evaporate(pheromones.data(), pheromones.size(), coefficient, initial_pheromone);
+}
+
+void Graph::update_all(float coefficient, DepositBuffer& deposits) {
+    deposits.group_by_row(nodes);
+
+    // Row by row, so that deposits are added while the row is still in cache
+    for (Index i = 0; i < nodes; ++i) {
+        auto* row = pheromones.data() + i * nodes;
+        kernels::evaporate(row, nodes, coefficient, initial_pheromone);
+        for (auto entry = deposits.row_begin(i); entry != deposits.row_end(i); ++entry) {
+            row[entry->dst] += entry->amount;
+        }
+    }
+}
+
+void Graph::reserve(std::size_t capacity) {
+    costs.reserve(capacity * capacity);
+    pheromones.reserve(capacity * capacity);
+}
+
+// Rows are moved to their new positions in place, starting from the last one, because every row
+// moves further in the buffer. Resizing the vectors grows them geometrically.
+Graph::Index Graph::add_node(const std::vector<int>& new_costs) {
+    if (new_costs.size() != nodes) {
+        std::cerr << "aco::Graph::add_node invalid costs size. Graph size: " << nodes
+                  << ", costs size: " << new_costs.size() << std::endl;
+        throw std::invalid_argument("AcoGraph::add_node invalid costs size!");
+    }
+    if (std::any_of(begin(new_costs), end(new_costs), [](int cost) { return cost <= 0; })) {
+        std::cerr << "aco::Graph::add_node costs must be positive" << std::endl;
+        throw std::invalid_argument("AcoGraph::add_node costs must be positive!");
+    }
+
+    // Step 1: spread the rows, the first one stays in place
+    auto old_nodes = nodes;
+    nodes = old_nodes + 1;
+    costs.resize(nodes * nodes);
+    pheromones.resize(nodes * nodes);
+    for (std::size_t i = old_nodes; i-- > 1;) {
+        std::copy_backward(begin(costs) + i * old_nodes, begin(costs) + (i + 1) * old_nodes,
+                           begin(costs) + i * nodes + old_nodes);
+        std::copy_backward(begin(pheromones) + i * old_nodes,
+                           begin(pheromones) + (i + 1) * old_nodes,
+                           begin(pheromones) + i * nodes + old_nodes);
+    }
+
+    // Step 2: fill the new column and the new row
+    auto node = old_nodes;
+    for (std::size_t i = 0; i < old_nodes; ++i) {
+        costs[i * nodes + node] = new_costs[i];
+        costs[node * nodes + i] = new_costs[i];
+        pheromones[i * nodes + node] = initial_pheromone;
+        pheromones[node * nodes + i] = initial_pheromone;
+    }
+    costs[node * nodes + node] = 0;
+    pheromones[node * nodes + node] = initial_pheromone;
+
+    return node;
+}
+
+// Opposite to add_node(): rows are compacted in place starting from the first one, skipping the
+// removed row and column.
+void Graph::remove_node(Index node) {
+    if (node >= nodes) {
+        std::cerr << "aco::Graph::remove_node index out of range. Graph size: " << nodes
+                  << ", index: " << node << std::endl;
+        throw std::invalid_argument("AcoGraph::remove_node index out of range!");
+    }
+
+    auto old_nodes = nodes;
+    nodes = old_nodes - 1;
+    auto compact = [&](auto& values) {
+        auto out = begin(values);
+        for (std::size_t i = 0; i < old_nodes; ++i) {
+            if (i == node) {
+                continue;
+            }
+            // The beginning of the first row stays in place
+            auto row = begin(values) + i * old_nodes;
+            out = out == row ? row + node : std::copy(row, row + node, out);
+            out = std::copy(row + node + 1, row + old_nodes, out);
+        }
+        values.resize(nodes * nodes);
+    };
+    compact(costs);
+    compact(pheromones);
+}
+
+void Graph::set_cost(Index src, Index dst, int cost) {
+    if (cost <= 0) {
+        std::cerr << "aco::Graph::set_cost cost must be positive, got: " << cost << std::endl;
+        throw std::invalid_argument("AcoGraph::set_cost cost must be positive!");
+    }
+
+    costs.at(internal_index(src, dst)) = cost;
+}
+
+std::int64_t Graph::path_length(const Path& path) const {
+    if (path.size() != nodes) {
+        std::cerr << "aco::Graph invalid path size. Graph size: " << nodes
+                  << ", path size: " << path.size() << std::endl;
+        throw std::invalid_argument("AcoGraph invalid path size!");
+    }
+
+    std::int64_t length;
+    path_lengths(path.data(), 1, &length);
+    return length;
+}
+
+void Graph::path_lengths(const Index* paths, std::size_t count, std::int64_t* lengths,
+                         std::size_t threads) const {
+    validate_paths(paths, count);
+
+    auto evaluate = [&](std::size_t first, std::size_t last) {
+        for (auto i = first; i < last; ++i) {
+            lengths[i] = kernels::tour_length(costs.data(), nodes, paths + i * nodes);
+        }
+    };
+
+    threads = std::max<std::size_t>(1, std::min(threads, count));
+    if (threads == 1) {
+        evaluate(0, count);
+        return;
+    }
+
+    // Split paths evenly, the calling thread takes the first chunk
+    std::vector<std::thread> workers;
+    auto                     chunk = (count + threads - 1) / threads;
+    for (std::size_t t = 1; t < threads; ++t) {
+        auto first = std::min(count, t * chunk);
+        auto last = std::min(count, first + chunk);
+        workers.emplace_back(evaluate, first, last);
+    }
+    evaluate(0, std::min(count, chunk));
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+std::vector<std::int64_t> Graph::path_lengths(const std::vector<Index>& paths,
+                                              std::size_t               threads) const {
+    if (nodes == 0 || paths.size() % nodes != 0) {
+        std::cerr << "aco::Graph invalid paths buffer size. Graph size: " << nodes
+                  << ", buffer size: " << paths.size() << std::endl;
+        throw std::invalid_argument("AcoGraph invalid paths buffer size!");
+    }
+
+    std::vector<std::int64_t> lengths(paths.size() / nodes);
+    path_lengths(paths.data(), lengths.size(), lengths.data(), threads);
+    return lengths;
+}
+
+Graph Graph::permuted(const Path& order) const {
+    std::vector<char> seen(nodes, 0);
+    bool              valid = order.size() == nodes;
+    for (std::size_t i = 0; valid && i < nodes; ++i) {
+        valid = order[i] < nodes && !seen[order[i]];
+        if (valid) {
+            seen[order[i]] = 1;
+        }
+    }
+    if (!valid) {
+        std::cerr << "aco::Graph::permuted order is not a permutation. Graph size: " << nodes
+                  << ", order size: " << order.size() << std::endl;
+        throw std::invalid_argument("AcoGraph::permuted order is not a permutation!");
+    }
+
+    Graph result = *this;
+    for (std::size_t i = 0; i < nodes; ++i) {
+        const auto* cost_row = costs.data() + order[i] * nodes;
+        const auto* pheromone_row = pheromones.data() + order[i] * nodes;
+        for (std::size_t j = 0; j < nodes; ++j) {
+            result.costs[i * nodes + j] = cost_row[order[j]];
+            result.pheromones[i * nodes + j] = pheromone_row[order[j]];
+        }
+    }
+    return result;
+}
+
+void Graph::nearest_costs(std::vector<int>& result) const {
+    result.assign(nodes, std::numeric_limits<int>::max());
+    for (Index i = 0; i < nodes; ++i) {
+        const auto* row = costs.data() + i * nodes;
+        for (Index j = 0; j < nodes; ++j) {
+            if (j != i) {
+                result[i] = std::min(result[i], row[j]);
+            }
+        }
+    }
+}
+
+Footprint Graph::get_footprint() const {
+    Footprint result;
+    result.add("graph costs", Footprint::capacity_bytes(costs));
+    result.add("graph pheromones", Footprint::capacity_bytes(pheromones));
+    return result;
 }
 
 std::string Graph::to_string() const {
@@ -97,6 +314,183 @@ Graph Graph::from_string(const std::string& string) {
     }
 }
 
+// Removes leading and trailing whitespace
+static std::string trim(const std::string& string) {
+    auto first = string.find_first_not_of(" \t\r");
+    auto last = string.find_last_not_of(" \t\r");
+    return first == std::string::npos ? "" : string.substr(first, last - first + 1);
+}
+
+[[noreturn]] static void tsplib_error(const std::string& message) {
+    std::cerr << "aco::Graph::from_tsplib: " << message << "\n";
+    throw std::invalid_argument("aco::Graph::from_tsplib: " + message);
+}
+
+// Distance between two cities, as defined by TSPLIB for the coordinate based edge weight types
+static int tsplib_distance(const std::string& type, Point a, Point b) {
+    auto dx = a.x - b.x;
+    auto dy = a.y - b.y;
+    if (type == "EUC_2D") {
+        return static_cast<int>(std::sqrt(dx * dx + dy * dy) + 0.5);
+    }
+    if (type == "CEIL_2D") {
+        return static_cast<int>(std::ceil(std::sqrt(dx * dx + dy * dy)));
+    }
+    if (type == "ATT") {
+        // Pseudo-Euclidean distance
+        auto r = std::sqrt((dx * dx + dy * dy) / 10.0);
+        auto t = static_cast<int>(r + 0.5);
+        return t < r ? t + 1 : t;
+    }
+
+    // GEO: coordinates are degrees and minutes (DDD.MM), the distance is in kilometers on an
+    // idealized sphere
+    auto radians = [](double value) {
+        const double pi = 3.141592;
+        auto         degrees = static_cast<int>(value);
+        return pi * (degrees + 5.0 * (value - degrees) / 3.0) / 180.0;
+    };
+    const double radius = 6378.388;
+    auto         q1 = std::cos(radians(a.y) - radians(b.y));
+    auto         q2 = std::cos(radians(a.x) - radians(b.x));
+    auto         q3 = std::cos(radians(a.x) + radians(b.x));
+    return static_cast<int>(radius * std::acos(0.5 * ((1.0 + q1) * q2 - (1.0 - q1) * q3)) + 1.0);
+}
+
+Graph Graph::from_tsplib(const std::string& string, float initial_pheromone) {
+    std::istringstream input(string);
+    std::size_t        nodes = 0;
+    std::string        weight_type;
+    std::string        weight_format = "FULL_MATRIX";
+    std::vector<int>   costs;
+
+    // Step 1: the specification part (KEY : VALUE lines) and the data sections
+    std::string line;
+    while (std::getline(input, line)) {
+        line = trim(line);
+        if (line.empty()) {
+            continue;
+        }
+        if (line == "EOF") {
+            break;
+        }
+
+        auto colon = line.find(':');
+        if (colon != std::string::npos) {
+            auto key = trim(line.substr(0, colon));
+            auto value = trim(line.substr(colon + 1));
+            if (key == "TYPE" && value != "TSP") {
+                tsplib_error("unsupported problem type: " + value);
+            } else if (key == "DIMENSION") {
+                std::istringstream dimension(value);
+                if (!(dimension >> nodes)) {
+                    tsplib_error("invalid DIMENSION: " + value);
+                }
+            } else if (key == "EDGE_WEIGHT_TYPE") {
+                weight_type = value;
+            } else if (key == "EDGE_WEIGHT_FORMAT") {
+                weight_format = value;
+            }
+            // Other keys (NAME, COMMENT, ...) don't affect the costs
+            continue;
+        }
+
+        if (nodes == 0) {
+            tsplib_error("data section before DIMENSION: " + line);
+        }
+        costs.resize(nodes * nodes);
+
+        if (line == "NODE_COORD_SECTION") {
+            if (weight_type != "EUC_2D" && weight_type != "CEIL_2D" && weight_type != "ATT" &&
+                weight_type != "GEO") {
+                tsplib_error("unsupported edge weight type: " + weight_type);
+            }
+
+            std::vector<Point> points(nodes);
+            for (std::size_t i = 0; i < nodes; ++i) {
+                std::size_t number;
+                Point       point;
+                if (!(input >> number >> point.x >> point.y) || number < 1 || number > nodes) {
+                    tsplib_error("invalid NODE_COORD_SECTION");
+                }
+                points[number - 1] = point;
+            }
+            for (std::size_t i = 0; i < nodes; ++i) {
+                for (std::size_t j = i + 1; j < nodes; ++j) {
+                    auto cost = std::max(1, tsplib_distance(weight_type, points[i], points[j]));
+                    costs[i * nodes + j] = cost;
+                    costs[j * nodes + i] = cost;
+                }
+            }
+        } else if (line == "EDGE_WEIGHT_SECTION") {
+            if (weight_type != "EXPLICIT") {
+                tsplib_error("EDGE_WEIGHT_SECTION requires EXPLICIT edge weight type");
+            }
+
+            // Matrix elements in the order of the format, (i, j) is the position in a full matrix
+            auto read = [&](std::size_t i, std::size_t j) {
+                int cost;
+                if (!(input >> cost)) {
+                    tsplib_error("invalid EDGE_WEIGHT_SECTION");
+                }
+                if (i != j) {
+                    costs[i * nodes + j] = std::max(1, cost);
+                    costs[j * nodes + i] = std::max(1, cost);
+                }
+            };
+            for (std::size_t i = 0; i < nodes; ++i) {
+                if (weight_format == "FULL_MATRIX") {
+                    // The problem is symmetric, so it doesn't matter which triangle wins
+                    for (std::size_t j = 0; j < nodes; ++j) {
+                        read(i, j);
+                    }
+                } else if (weight_format == "UPPER_ROW") {
+                    for (std::size_t j = i + 1; j < nodes; ++j) {
+                        read(i, j);
+                    }
+                } else if (weight_format == "UPPER_DIAG_ROW") {
+                    for (std::size_t j = i; j < nodes; ++j) {
+                        read(i, j);
+                    }
+                } else if (weight_format == "LOWER_ROW") {
+                    for (std::size_t j = 0; j < i; ++j) {
+                        read(i, j);
+                    }
+                } else if (weight_format == "LOWER_DIAG_ROW") {
+                    for (std::size_t j = 0; j <= i; ++j) {
+                        read(i, j);
+                    }
+                } else {
+                    tsplib_error("unsupported edge weight format: " + weight_format);
+                }
+            }
+        } else if (line == "DISPLAY_DATA_SECTION") {
+            // Coordinates for drawing only, skip them
+            std::string skipped;
+            for (std::size_t i = 0; i < nodes; ++i) {
+                std::getline(input >> std::ws, skipped);
+            }
+        } else {
+            tsplib_error("unsupported section: " + line);
+        }
+    }
+
+    // Step 2: validation
+    if (nodes == 0 || costs.size() != nodes * nodes) {
+        tsplib_error("no cities");
+    }
+    for (std::size_t i = 0; i < nodes; ++i) {
+        for (std::size_t j = 0; j < nodes; ++j) {
+            if (i != j && costs[i * nodes + j] == 0) {
+                tsplib_error("missing costs, no NODE_COORD_SECTION or EDGE_WEIGHT_SECTION");
+            }
+        }
+    }
+
+    std::vector<float> pheromones(nodes * nodes, initial_pheromone);
+    return Graph(std::move(costs), std::move(pheromones), nodes, initial_pheromone);
+}
+
 Graph::Index Graph::internal_index(Index src, Index dst) const {
     if (src == dst || src >= nodes || dst >= nodes) {
         std::cerr << "aco::Graph invalid arguments. Graph size: " << nodes << ", src : " << src
@@ -107,6 +501,18 @@ Graph::Index Graph::internal_index(Index src, Index dst) const {
     return src * nodes + dst;
 }
 
+// Only the range of indices is checked, not that every node is visited exactly once. Lengths of
+// such paths are meaningless, but at least memory is never accessed out of bounds.
+void Graph::validate_paths(const Index* paths, std::size_t count) const {
+    auto end = paths + count * nodes;
+    auto max = std::max_element(paths, end);
+    if (max != end && *max >= nodes) {
+        std::cerr << "aco::Graph invalid path. Graph size: " << nodes << ", index: " << *max
+                  << std::endl;
+        throw std::invalid_argument("AcoGraph invalid path index!");
+    }
+}
+
 bool operator==(const Graph& lhs, const Graph& rhs) {
     return lhs.costs == rhs.costs && lhs.pheromones == rhs.pheromones && lhs.nodes == rhs.nodes &&
            lhs.initial_pheromone == rhs.initial_pheromone;
@@ -1,7 +1,13 @@
+#include <cstdint>
 #include <memory>
 #include <random>
 #include <vector>
 
+#include "AcoDepositBuffer.hpp"
+#include "AcoFootprint.hpp"
+#include "AcoSpatialIndex.hpp"
+#include "HugePageAllocator.hpp"
+
 #ifndef ACO_GRAPH_HPP
 #define ACO_GRAPH_HPP
 
@@ -19,18 +25,32 @@ namespace aco {
 class Graph {
   public:
     using Index = std::size_t;
+    using Path  = std::vector<Index>; // Visiting order of all nodes, returning to the first one
 
     friend bool operator==(const Graph&, const Graph&);
+    friend class AlgorithmCpuAsync;
+    friend class AlgorithmCpuNuma;
+    friend class AlgorithmCpuPipelined;
+    template <std::size_t N>
+    friend class AlgorithmCpuSmall;
     friend class AlgorithmGpu;
+    friend class AlgorithmReordered;
+    friend class ChoiceInfo;
+    friend class CostMatrixBuilder;
+    friend class SimdTourBuilder;
 
   public:
     // Create a graph with a given number of nodes.
     // Currently there's only one, implicit initialization method:
-    // - full graph,
+    // - full graph (see SparseGraph for graphs with only some of the edges),
     // - initialize all cost edges using uniform distribution, but symmetrically
     // - all pheromones get the same amount of initial pheromone
     explicit Graph(std::mt19937& random_generator, std::size_t nodes, float initial_pheromone);
 
+    // Full symmetric graph of cities given by coordinates. Costs are Euclidean distances rounded
+    // to the nearest integer (as in TSPLIB's EUC_2D), but at least 1, since costs must be positive.
+    static Graph from_points(const std::vector<Point>& points, float initial_pheromone);
+
   private:
     // Value constructor, useful for testing
     explicit Graph(std::vector<int> costs, std::vector<float> pheromones, std::size_t nodes,
@@ -47,19 +67,69 @@ class Graph {
     void add_pheromone_two_way(Index a, Index b, float amount);
     void update_all(float coefficient);
 
+    // Multiply all pheromones by the coefficient, then add the deposits. Equivalent to
+    // update_all(coefficient) followed by add_pheromone_two_way() for every deposit, but done in a
+    // single pass over the pheromones. Groups the deposits by row (see DepositBuffer).
+    void update_all(float coefficient, DepositBuffer& deposits);
+
+    // Dynamic instances. The graph is modified in place, keeping the pheromones learned so far.
+    // Storage grows geometrically, reserve() can be used to avoid reallocations altogether.
+    // - add_node() appends a node, 'costs' are the costs between every existing node and the new
+    //   one (both ways). Pheromones on the new edges are set to the initial level. Returns the
+    //   index of the new node.
+    // - remove_node() removes the node along with its edges, indices of the following nodes are
+    //   decremented.
+    // - set_cost() changes the cost of a single, one-way edge.
+    // Costs must be positive.
+    void  reserve(std::size_t capacity);
+    Index add_node(const std::vector<int>& costs);
+    void  remove_node(Index node);
+    void  set_cost(Index src, Index dst, int cost);
+
+    // Tour evaluation. Length of a path visiting every node once, including the way back. Throws
+    // std::invalid_argument on invalid path size or indices.
+    std::int64_t path_length(const Path& path) const;
+
+    // Evaluate many paths at once, stored one after the other in a flat buffer ('count' paths of
+    // get_size() indices each), writing the results to 'lengths'. Evaluation can be split between
+    // multiple threads, which pays off only for big batches.
+    void path_lengths(const Index* paths, std::size_t count, std::int64_t* lengths,
+                      std::size_t threads = 1) const;
+    std::vector<std::int64_t> path_lengths(const std::vector<Index>& paths,
+                                           std::size_t               threads = 1) const;
+
+    // The same graph with renumbered nodes: node i of the result is node order[i] of this one.
+    // Throws std::invalid_argument unless 'order' is a permutation of the nodes.
+    Graph permuted(const Path& order) const;
+
+    // Cost of the cheapest edge leaving every node, for lower bounds of tour lengths: a tour
+    // leaves every node once. Written to 'result', resized to get_size().
+    void nearest_costs(std::vector<int>& result) const;
+
+    // Memory of the costs and the pheromones, including the reserved capacity
+    Footprint get_footprint() const;
+
     // Serialization. The idea here is to serialize to a human-readable format, not really for
     // efficiency.
     std::string  to_string() const;
     static Graph from_string(const std::string& string);
 
+    // Symmetric TSP in the TSPLIB format. Supported edge weight types are EUC_2D, CEIL_2D, ATT, GEO
+    // and EXPLICIT (with FULL_MATRIX, UPPER_ROW, LOWER_ROW, UPPER_DIAG_ROW or LOWER_DIAG_ROW
+    // format), distances follow the TSPLIB definitions. Costs of zero (e.g. duplicated cities) are
+    // raised to 1, since costs must be positive. Throws std::invalid_argument on invalid or
+    // unsupported input.
+    static Graph from_tsplib(const std::string& string, float initial_pheromone);
+
   private:
     Index internal_index(Index src, Index dst) const;
+    void  validate_paths(const Index* paths, std::size_t count) const;
 
   private:
-    std::vector<int>   costs;
-    std::vector<float> pheromones;
-    std::size_t        nodes;
-    float              initial_pheromone;
+    utils::LargeVector<int>   costs;
+    utils::LargeVector<float> pheromones;
+    std::size_t               nodes;
+    float                     initial_pheromone;
 };
 
 bool        operator==(const Graph& lhs, const Graph& rhs);
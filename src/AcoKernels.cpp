@@ -0,0 +1,314 @@
+#include "AcoKernels.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ACO_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+namespace aco {
+namespace kernels {
+
+std::ostream& operator<<(std::ostream& out, Isa isa) {
+    switch (isa) {
+    case Isa::Scalar:
+        out << "scalar";
+        return out;
+    case Isa::Avx2:
+        out << "AVX2";
+        return out;
+    case Isa::Avx512:
+        out << "AVX-512";
+        return out;
+    }
+
+    out << "unknown";
+    return out;
+}
+
+bool is_supported(Isa isa) {
+    switch (isa) {
+    case Isa::Scalar:
+        return true;
+#ifdef ACO_KERNELS_X86
+    case Isa::Avx2:
+        return __builtin_cpu_supports("avx2");
+    case Isa::Avx512:
+        return __builtin_cpu_supports("avx512f");
+#else
+    case Isa::Avx2:
+    case Isa::Avx512:
+        return false;
+#endif
+    }
+
+    return false;
+}
+
+Isa best_isa() {
+    static const Isa best = [] {
+        for (auto isa : {Isa::Avx512, Isa::Avx2}) {
+            if (is_supported(isa)) {
+                return isa;
+            }
+        }
+        return Isa::Scalar;
+    }();
+    return best;
+}
+
+static void evaporate_scalar(float* data, std::size_t count, float coefficient, float min_value) {
+    for (std::size_t i = 0; i < count; ++i) {
+        data[i] = std::max(data[i] * coefficient, min_value);
+    }
+}
+
+#ifdef ACO_KERNELS_X86
+// Note: max(min, value) order of arguments, so that NaN behaves like in std::max(value, min)
+__attribute__((target("avx2"))) static void
+evaporate_avx2(float* data, std::size_t count, float coefficient, float min_value) {
+    const auto  multiplier = _mm256_set1_ps(coefficient);
+    const auto  minimum = _mm256_set1_ps(min_value);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        auto value = _mm256_mul_ps(_mm256_loadu_ps(data + i), multiplier);
+        _mm256_storeu_ps(data + i, _mm256_max_ps(minimum, value));
+    }
+
+    // Remainder
+    evaporate_scalar(data + i, count - i, coefficient, min_value);
+}
+
+__attribute__((target("avx512f"))) static void
+evaporate_avx512(float* data, std::size_t count, float coefficient, float min_value) {
+    const auto  multiplier = _mm512_set1_ps(coefficient);
+    const auto  minimum = _mm512_set1_ps(min_value);
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        auto value = _mm512_mul_ps(_mm512_loadu_ps(data + i), multiplier);
+        _mm512_storeu_ps(data + i, _mm512_max_ps(minimum, value));
+    }
+
+    // Remainder, using a mask instead of a scalar loop
+    if (i < count) {
+        __mmask16 mask = (1u << (count - i)) - 1;
+        auto      value = _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, data + i), multiplier);
+        _mm512_mask_storeu_ps(data + i, mask, _mm512_max_ps(minimum, value));
+    }
+}
+#endif
+
+static std::int64_t tour_length_scalar(const int* costs, std::size_t nodes, const std::size_t* tour,
+                                       std::size_t first) {
+    std::int64_t length = 0;
+    for (std::size_t i = first; i < nodes; ++i) {
+        // Path stores visited cities in order. It is a round trip, so the last distance is from the
+        // last city directly to the first one
+        auto dst = i + 1 < nodes ? tour[i + 1] : tour[0];
+        length += costs[tour[i] * nodes + dst];
+    }
+    return length;
+}
+
+#if defined(ACO_KERNELS_X86) && defined(__x86_64__)
+// Four edges at a time: cost indices (src * nodes + dst) are computed in 64-bit lanes, costs are
+// gathered and accumulated in 64-bit lanes, so that long tours can't overflow. Assumes nodes and
+// indices fit in 32 bits, which is the case for any graph that fits in memory.
+__attribute__((target("avx2"))) static std::int64_t
+tour_length_avx2(const int* costs, std::size_t nodes, const std::size_t* tour) {
+    static_assert(sizeof(std::size_t) == sizeof(long long), "64-bit indices expected");
+
+    const auto  stride = _mm256_set1_epi64x(nodes);
+    auto        sum = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 4 < nodes; i += 4) {
+        auto src = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tour + i));
+        auto dst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tour + i + 1));
+        auto index = _mm256_add_epi64(_mm256_mul_epu32(src, stride), dst);
+        auto gathered = _mm256_i64gather_epi32(costs, index, sizeof(int));
+        sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(gathered));
+    }
+
+    // Horizontal sum, then the remainder (including the edge back to the first city)
+    alignas(32) std::int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sum);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + tour_length_scalar(costs, nodes, tour, i);
+}
+#endif
+
+std::int64_t tour_length(const int* costs, std::size_t nodes, const std::size_t* tour) {
+    // AVX-512 doesn't add anything over AVX2 gathers here
+    auto isa = best_isa() == Isa::Scalar ? Isa::Scalar : Isa::Avx2;
+    return tour_length(isa, costs, nodes, tour);
+}
+
+std::int64_t tour_length(Isa isa, const int* costs, std::size_t nodes, const std::size_t* tour) {
+    if (!is_supported(isa)) {
+        std::cerr << "aco::kernels::tour_length: instruction set not supported: " << isa << "\n";
+        throw std::invalid_argument("aco::kernels::tour_length: instruction set not supported!");
+    }
+
+#if defined(ACO_KERNELS_X86) && defined(__x86_64__)
+    if (isa != Isa::Scalar) {
+        return tour_length_avx2(costs, nodes, tour);
+    }
+#endif
+    return tour_length_scalar(costs, nodes, tour, 0);
+}
+
+static void to_bfloat16_scalar(const float* src, std::uint16_t* dst, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        dst[i] = to_bfloat16(src[i]);
+    }
+}
+
+static void from_bfloat16_scalar(const std::uint16_t* src, float* dst, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        dst[i] = from_bfloat16(src[i]);
+    }
+}
+
+#ifdef ACO_KERNELS_X86
+// Rounding to nearest even in integer arithmetic, like the scalar version
+__attribute__((target("avx2"))) static void
+to_bfloat16_avx2(const float* src, std::uint16_t* dst, std::size_t count) {
+    const auto  bias = _mm256_set1_epi32(0x7fff);
+    const auto  one = _mm256_set1_epi32(1);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        auto bits = _mm256_castps_si256(_mm256_loadu_ps(src + i));
+        auto odd = _mm256_and_si256(_mm256_srli_epi32(bits, 16), one);
+        auto rounded = _mm256_srli_epi32(_mm256_add_epi32(bits, _mm256_add_epi32(bias, odd)), 16);
+
+        // Pack works within 128-bit lanes, gather both lanes' results in the lower half
+        auto packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(rounded, rounded), 0x08);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm256_castsi256_si128(packed));
+    }
+
+    // Remainder
+    to_bfloat16_scalar(src + i, dst + i, count - i);
+}
+
+__attribute__((target("avx2"))) static void
+from_bfloat16_avx2(const std::uint16_t* src, float* dst, std::size_t count) {
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        auto halves = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        auto bits = _mm256_slli_epi32(_mm256_cvtepu16_epi32(halves), 16);
+        _mm256_storeu_ps(dst + i, _mm256_castsi256_ps(bits));
+    }
+
+    // Remainder
+    from_bfloat16_scalar(src + i, dst + i, count - i);
+}
+
+__attribute__((target("avx512f"))) static void
+to_bfloat16_avx512(const float* src, std::uint16_t* dst, std::size_t count) {
+    const auto bias = _mm512_set1_epi32(0x7fff);
+    const auto one = _mm512_set1_epi32(1);
+    for (std::size_t i = 0; i < count; i += 16) {
+        // Remainder handled with a mask, the narrowing store of AVX-512F supports it
+        auto remaining = count - i;
+        auto mask = remaining >= 16 ? __mmask16(0xffff) : __mmask16((1u << remaining) - 1);
+
+        auto bits = _mm512_castps_si512(_mm512_maskz_loadu_ps(mask, src + i));
+        auto odd = _mm512_and_si512(_mm512_srli_epi32(bits, 16), one);
+        auto rounded = _mm512_srli_epi32(_mm512_add_epi32(bits, _mm512_add_epi32(bias, odd)), 16);
+        _mm512_mask_cvtepi32_storeu_epi16(dst + i, mask, rounded);
+    }
+}
+
+__attribute__((target("avx512f"))) static void
+from_bfloat16_avx512(const std::uint16_t* src, float* dst, std::size_t count) {
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        auto halves = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        auto bits = _mm512_slli_epi32(_mm512_cvtepu16_epi32(halves), 16);
+        _mm512_storeu_ps(dst + i, _mm512_castsi512_ps(bits));
+    }
+
+    // Remainder
+    from_bfloat16_scalar(src + i, dst + i, count - i);
+}
+#endif
+
+void to_bfloat16(const float* src, std::uint16_t* dst, std::size_t count) {
+    to_bfloat16(best_isa(), src, dst, count);
+}
+
+void to_bfloat16(Isa isa, const float* src, std::uint16_t* dst, std::size_t count) {
+    if (!is_supported(isa)) {
+        std::cerr << "aco::kernels::to_bfloat16: instruction set not supported: " << isa << "\n";
+        throw std::invalid_argument("aco::kernels::to_bfloat16: instruction set not supported!");
+    }
+
+    switch (isa) {
+#ifdef ACO_KERNELS_X86
+    case Isa::Avx512:
+        to_bfloat16_avx512(src, dst, count);
+        return;
+    case Isa::Avx2:
+        to_bfloat16_avx2(src, dst, count);
+        return;
+#endif
+    default:
+        to_bfloat16_scalar(src, dst, count);
+        return;
+    }
+}
+
+void from_bfloat16(const std::uint16_t* src, float* dst, std::size_t count) {
+    from_bfloat16(best_isa(), src, dst, count);
+}
+
+void from_bfloat16(Isa isa, const std::uint16_t* src, float* dst, std::size_t count) {
+    if (!is_supported(isa)) {
+        std::cerr << "aco::kernels::from_bfloat16: instruction set not supported: " << isa << "\n";
+        throw std::invalid_argument("aco::kernels::from_bfloat16: instruction set not supported!");
+    }
+
+    switch (isa) {
+#ifdef ACO_KERNELS_X86
+    case Isa::Avx512:
+        from_bfloat16_avx512(src, dst, count);
+        return;
+    case Isa::Avx2:
+        from_bfloat16_avx2(src, dst, count);
+        return;
+#endif
+    default:
+        from_bfloat16_scalar(src, dst, count);
+        return;
+    }
+}
+
+void evaporate(float* data, std::size_t count, float coefficient, float min_value) {
+    evaporate(best_isa(), data, count, coefficient, min_value);
+}
+
+void evaporate(Isa isa, float* data, std::size_t count, float coefficient, float min_value) {
+    if (!is_supported(isa)) {
+        std::cerr << "aco::kernels::evaporate: instruction set not supported: " << isa << "\n";
+        throw std::invalid_argument("aco::kernels::evaporate: instruction set not supported!");
+    }
+
+    switch (isa) {
+#ifdef ACO_KERNELS_X86
+    case Isa::Avx512:
+        evaporate_avx512(data, count, coefficient, min_value);
+        return;
+    case Isa::Avx2:
+        evaporate_avx2(data, count, coefficient, min_value);
+        return;
+#endif
+    default:
+        evaporate_scalar(data, count, coefficient, min_value);
+        return;
+    }
+}
+
+} // namespace kernels
+} // namespace aco
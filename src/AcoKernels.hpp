@@ -0,0 +1,57 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+#ifndef ACO_KERNELS_HPP
+#define ACO_KERNELS_HPP
+
+namespace aco {
+namespace kernels {
+
+// Instruction sets the kernels are implemented for. The best one supported by the CPU is chosen at
+// runtime, so that the binary doesn't need to be compiled for a specific CPU.
+enum class Isa { Scalar, Avx2, Avx512 };
+
+std::ostream& operator<<(std::ostream&, Isa);
+
+// The best instruction set supported by both the build and the CPU.
+Isa  best_isa();
+bool is_supported(Isa isa);
+
+// Evaporation: data[i] = max(data[i] * coefficient, min_value) for every element.
+void evaporate(float* data, std::size_t count, float coefficient, float min_value);
+void evaporate(Isa isa, float* data, std::size_t count, float coefficient, float min_value);
+
+// Length of a round trip over all 'nodes' cities of the tour, given a full nodes * nodes costs
+// matrix. Indices are not validated.
+std::int64_t tour_length(const int* costs, std::size_t nodes, const std::size_t* tour);
+std::int64_t tour_length(Isa isa, const int* costs, std::size_t nodes, const std::size_t* tour);
+
+// bfloat16 is the upper half of a float: the same 8-bit exponent (so the same range), but only 7
+// bits of mantissa. Conversion from float rounds to the nearest even, so that the relative error is
+// at most 2^-8 (about 0.4%). NaNs are not expected.
+inline std::uint16_t to_bfloat16(float value) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    bits += 0x7fff + ((bits >> 16) & 1);
+    return static_cast<std::uint16_t>(bits >> 16);
+}
+
+inline float from_bfloat16(std::uint16_t value) {
+    std::uint32_t bits = std::uint32_t(value) << 16;
+    float         result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+// Bulk conversions of 'count' elements, same results as the functions above.
+void to_bfloat16(const float* src, std::uint16_t* dst, std::size_t count);
+void to_bfloat16(Isa isa, const float* src, std::uint16_t* dst, std::size_t count);
+void from_bfloat16(const std::uint16_t* src, float* dst, std::size_t count);
+void from_bfloat16(Isa isa, const std::uint16_t* src, float* dst, std::size_t count);
+
+} // namespace kernels
+} // namespace aco
+
+#endif // ACO_KERNELS_HPP
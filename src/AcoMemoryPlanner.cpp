@@ -0,0 +1,142 @@
+#include "AcoMemoryPlanner.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+
+#include "AcoAlgorithmCpuSmall.hpp"
+#include "AcoSimdTourBuilder.hpp"
+#include "HugePageAllocator.hpp"
+#include "Topology.hpp"
+
+namespace aco {
+
+// Buffers of nodes^2 elements are LargeVectors, which are padded to whole huge pages
+static std::size_t large_bytes(std::size_t bytes) {
+    return utils::allocation_size(bytes);
+}
+
+// Values and cumulative rows, see ChoiceInfo
+static std::size_t choice_info_bytes(std::size_t edges, Precision precision) {
+    auto value_bytes = precision == Precision::Float ? sizeof(float) : sizeof(std::uint16_t);
+    return large_bytes(edges * value_bytes) + large_bytes(edges * sizeof(float));
+}
+
+// Edges as added, then grouped by row both ways, plus the row offsets, see DepositBuffer
+static std::size_t deposit_bytes(std::size_t nodes, std::size_t agents) {
+    auto edges = agents * nodes;
+    return edges * (2 * sizeof(std::uint32_t) + sizeof(float)) +
+           2 * edges * sizeof(DepositBuffer::Entry) + (2 * nodes + 1) * sizeof(std::size_t);
+}
+
+// Flat tours and their lengths
+static std::size_t tour_bytes(std::size_t nodes, std::size_t agents) {
+    return agents * (nodes * sizeof(Graph::Index) + sizeof(std::int64_t));
+}
+
+Footprint predict_footprint(DeviceType device, std::size_t nodes,
+                            const Algorithm::Config& config) {
+    const auto edges = nodes * nodes;
+    const auto agents = config.agents_count;
+    const auto choice_info = choice_info_bytes(edges, config.choice_info_precision);
+
+    Footprint result;
+    result.add("graph costs", large_bytes(edges * sizeof(int)));
+    result.add("graph pheromones", large_bytes(edges * sizeof(float)));
+
+    switch (device) {
+    case DeviceType::CPU: {
+        // With recombination, the best so far deposits like one more ant
+        auto elitist = config.recombination_elites > 0 ? 1 : 0;
+        result.add("choice info", choice_info);
+        result.add("tours", tour_bytes(nodes, agents));
+        result.add("deposits", deposit_bytes(nodes, agents + elitist));
+        return result;
+    }
+    case DeviceType::GPU:
+        result.add("choice info", choice_info);
+        result.add("tours", tour_bytes(nodes, agents));
+        result.add("device costs", edges * sizeof(int));
+        result.add("device pheromones", edges * sizeof(float));
+        result.add("device scores", edges * sizeof(float));
+        result.add("device tours", agents * nodes * sizeof(std::size_t));
+        return result;
+    case DeviceType::CPU_NUMA: {
+        // Nodes without any worker are not used
+        auto topology = utils::Topology::detect();
+        auto threads = config.threads != 0 ? config.threads : topology.cpu_count();
+        auto replicas = std::min(threads, topology.get_nodes().size());
+        result.add("replica costs", replicas * large_bytes(edges * sizeof(int)));
+        result.add("replica choice info", replicas * choice_info);
+        result.add("replica deposits", replicas * large_bytes(edges * sizeof(float)));
+        result.add("tours", tour_bytes(nodes, agents) + agents * sizeof(Graph::Path));
+        return result;
+    }
+    case DeviceType::CPU_ASYNC:
+        // The current choice info and the previous one, the scores are shared by the workers
+        result.add("shared pheromones", large_bytes(edges * sizeof(std::atomic<float>)));
+        result.add("cost copy", large_bytes(edges * sizeof(int)));
+        result.add("choice info", 2 * choice_info);
+        result.add("refresh scores", edges * sizeof(float));
+        return result;
+    case DeviceType::CPU_PIPELINED:
+        result.add("choice info", choice_info);
+        result.add("back choice info", choice_info);
+        result.add("back pheromones", large_bytes(edges * sizeof(float)));
+        result.add("tours", tour_bytes(nodes, agents));
+        result.add("deposits", deposit_bytes(nodes, agents));
+        return result;
+    case DeviceType::CPU_SIMD: {
+        // Float scores of every edge, without a choice info, and the state of every lane: 32-bit
+        // availability of every city, row offset, random state and the chosen city
+        auto lanes = SimdTourBuilder().get_lanes();
+        result.add("tour builder", large_bytes(edges * sizeof(float)) +
+                                       (nodes * lanes + 3 * lanes) * sizeof(float));
+        result.add("tours", tour_bytes(nodes, agents));
+        result.add("deposits", deposit_bytes(nodes, agents));
+        return result;
+    }
+    case DeviceType::CPU_SMALL: {
+        auto capacity = small_capacity(nodes);
+        if (capacity == 0) {
+            std::cerr << "aco::predict_footprint graph too big for CPU_SMALL: " << nodes
+                      << " nodes\n";
+            throw std::invalid_argument("aco::predict_footprint graph too big for CPU_SMALL");
+        }
+
+        // Costs, pheromones and choice info, tours of one byte per city
+        auto diagnosed = config.diagnostics_samples > 0 ? agents * nodes * sizeof(Graph::Index) : 0;
+        result.add("fixed matrices", capacity * capacity * (sizeof(int) + 2 * sizeof(float)));
+        result.add("tours", agents * (capacity + sizeof(std::int64_t)) + diagnosed);
+        return result;
+    }
+    }
+
+    std::cerr << "aco::predict_footprint unknown device type: " << (int)device << "\n";
+    throw std::invalid_argument("aco::predict_footprint unknown device type");
+}
+
+std::optional<MemoryPlan> plan_memory(const std::vector<DeviceType>& devices, std::size_t nodes,
+                                      const Algorithm::Config& config, std::size_t limit) {
+    // Cheaper storage, in the order of preference
+    std::vector<Algorithm::Config> configs{config};
+    if (config.choice_info_precision != Precision::BFloat16) {
+        configs.push_back(config);
+        configs.back().choice_info_precision = Precision::BFloat16;
+    }
+
+    for (auto device : devices) {
+        if (device == DeviceType::CPU_SMALL && small_capacity(nodes) == 0) {
+            continue;
+        }
+        for (const auto& candidate : configs) {
+            auto footprint = predict_footprint(device, nodes, candidate);
+            if (footprint.total() <= limit) {
+                return MemoryPlan{device, candidate, std::move(footprint)};
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+} // namespace aco
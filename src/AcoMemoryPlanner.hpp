@@ -0,0 +1,40 @@
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "AcoAlgorithm.hpp"
+#include "AcoFootprint.hpp"
+
+#ifndef ACO_MEMORY_PLANNER_HPP
+#define ACO_MEMORY_PLANNER_HPP
+
+namespace aco {
+
+// Predicted footprint of an algorithm made by Algorithm::make for a graph of 'nodes' nodes, once
+// the first iteration allocated the workspaces. Entries are the same as of
+// Algorithm::get_footprint. Multithreaded devices use config.threads, or all CPUs (and NUMA nodes)
+// if zero, as the algorithms do. Exact, apart from:
+// * CPU_NUMA - agents_count tours are predicted, but every worker keeps the most tours it built
+//              in a single iteration, so with uneven load they take more, in the worst case
+//              threads times as much,
+// * CPU_ASYNC - the previous choice info lives only while ants still use it, and a third one is
+//               allocated by a refresh in the meantime.
+// Throws std::invalid_argument if the graph doesn't fit the device (CPU_SMALL).
+Footprint predict_footprint(DeviceType device, std::size_t nodes, const Algorithm::Config& config);
+
+// Device and configuration for a job, see plan_memory
+struct MemoryPlan {
+    DeviceType        device;
+    Algorithm::Config config;
+    Footprint         footprint; // Predicted
+};
+
+// Plans a job of 'nodes' nodes within 'limit' bytes. Devices are tried in the given order of
+// preference, each first with 'config', then with cheaper storage: bfloat16 choice info (see
+// Precision). Devices the graph doesn't fit are skipped. Returns nothing if nothing fits.
+std::optional<MemoryPlan> plan_memory(const std::vector<DeviceType>& devices, std::size_t nodes,
+                                      const Algorithm::Config& config, std::size_t limit);
+
+} // namespace aco
+
+#endif // ACO_MEMORY_PLANNER_HPP
@@ -0,0 +1,135 @@
+#include "AcoRecombination.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace aco {
+
+Recombination::Recombination(std::size_t nodes)
+    : first_next(nodes), first_prev(nodes), second_next(nodes), second_prev(nodes),
+      components(nodes), crossings(nodes), first_costs(nodes), second_costs(nodes),
+      neighbours(2 * nodes), degrees(nodes) {}
+
+bool Recombination::crossover(const Graph& graph, const Graph::Index* first,
+                              const Graph::Index* second, Path& child) {
+    const auto n = graph.get_size();
+    if (n < 4) {
+        return false;
+    }
+    first_next.resize(n);
+    first_prev.resize(n);
+    second_next.resize(n);
+    second_prev.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        first_next[first[i]] = first[(i + 1) % n];
+        first_prev[first[(i + 1) % n]] = first[i];
+        second_next[second[i]] = second[(i + 1) % n];
+        second_prev[second[(i + 1) % n]] = second[i];
+    }
+    auto shared = [&](Graph::Index a, Graph::Index b) {
+        return second_next[a] == b || second_prev[a] == b;
+    };
+
+    // Step 1: components of the edges that are not shared. Nodes with shared edges only are
+    // components on their own, which never contain any choice.
+    components.resize(n);
+    std::iota(begin(components), end(components), 0);
+    for (Graph::Index a = 0; a < n; ++a) {
+        auto b = first_next[a];
+        if (!shared(a, b)) {
+            components[find(a)] = find(b);
+        }
+        auto c = second_next[a];
+        if (first_next[a] != c && first_prev[a] != c) {
+            components[find(a)] = find(c);
+        }
+    }
+
+    // Step 2: shared edges leaving every component, and the cost of both parents inside of it
+    crossings.assign(n, 0);
+    first_costs.assign(n, 0);
+    second_costs.assign(n, 0);
+    bool any_difference = false;
+    for (Graph::Index a = 0; a < n; ++a) {
+        auto b = first_next[a];
+        if (shared(a, b)) {
+            if (find(a) != find(b)) {
+                ++crossings[find(a)];
+                ++crossings[find(b)];
+            }
+        } else {
+            first_costs[find(a)] += graph.get_cost(a, b);
+            any_difference = true;
+        }
+        auto c = second_next[a];
+        if (first_next[a] != c && first_prev[a] != c) {
+            second_costs[find(a)] += graph.get_cost(a, c);
+        }
+    }
+    if (!any_difference) {
+        return false;
+    }
+
+    // Step 3: the edges of the child. The second parent is taken only in the feasible partitions
+    // where it's cheaper.
+    auto take_second = [&](Graph::Index root) {
+        return crossings[root] == 2 && second_costs[root] < first_costs[root];
+    };
+    neighbours.resize(2 * n);
+    degrees.assign(n, 0);
+    auto add_edge = [&](Graph::Index a, Graph::Index b) {
+        if (degrees[a] < 2 && degrees[b] < 2) {
+            neighbours[2 * a + degrees[a]++] = b;
+            neighbours[2 * b + degrees[b]++] = a;
+        }
+    };
+    bool any_taken = false;
+    for (Graph::Index a = 0; a < n; ++a) {
+        auto b = first_next[a];
+        if (shared(a, b) || !take_second(find(a))) {
+            add_edge(a, b);
+        }
+        auto c = second_next[a];
+        if (first_next[a] != c && first_prev[a] != c && take_second(find(a))) {
+            add_edge(a, c);
+            any_taken = true;
+        }
+    }
+    if (!any_taken) {
+        return false;
+    }
+
+    // Step 4: walk the edges, they must form a single tour
+    child.resize(n);
+    Graph::Index previous = neighbours[1];
+    Graph::Index current = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (degrees[current] != 2 || (i > 0 && current == 0)) {
+            return false;
+        }
+        child[i] = current;
+        auto next = neighbours[2 * current] != previous ? neighbours[2 * current]
+                                                        : neighbours[2 * current + 1];
+        previous = current;
+        current = next;
+    }
+    if (current != 0) {
+        return false;
+    }
+
+    // The partitions were chosen by the costs in the parents' directions, which may differ in the
+    // child for asymmetric costs
+    auto length = graph.path_length(child);
+    return length < graph.path_length(Path(first, first + n)) &&
+           length < graph.path_length(Path(second, second + n));
+}
+
+Graph::Index Recombination::find(Graph::Index node) {
+    while (components[node] != node) {
+        components[node] = components[components[node]];
+        node = components[node];
+    }
+    return node;
+}
+
+} // namespace aco
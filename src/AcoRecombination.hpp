@@ -0,0 +1,51 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "AcoGraph.hpp"
+
+#ifndef ACO_RECOMBINATION_HPP
+#define ACO_RECOMBINATION_HPP
+
+namespace aco {
+
+// Partition crossover (GPX) of two tours. Edges present in only one of the parents form connected
+// components. A component that both parents enter and leave only once, through the same pair of
+// shared edges, is a feasible partition: either parent's edges inside of it can be taken
+// independently of the other components. The child takes the cheaper parent in every feasible
+// partition, and the first parent everywhere else, so it is never longer than the first parent,
+// and when the parents are good in different regions, it is shorter than both.
+// Linear in the number of nodes. Holds the workspace, so it should be reused between calls.
+class Recombination {
+  public:
+    using Path = Graph::Path;
+
+  public:
+    explicit Recombination(std::size_t nodes = 0);
+
+  public:
+    // Write the child of the parents (get_size() cities each) to 'child', if it's strictly shorter
+    // than both of them. Returns false otherwise, e.g. for identical parents.
+    bool crossover(const Graph& graph, const Graph::Index* first, const Graph::Index* second,
+                   Path& child);
+
+  private:
+    Graph::Index find(Graph::Index node);
+
+  private:
+    // Workspace
+    std::vector<Graph::Index> first_next;  // Successor of every node in the first parent
+    std::vector<Graph::Index> first_prev;  // Predecessor of every node in the first parent
+    std::vector<Graph::Index> second_next; // Successor of every node in the second parent
+    std::vector<Graph::Index> second_prev; // Predecessor of every node in the second parent
+    std::vector<Graph::Index> components;  // Union-find parents, roots identify components
+    std::vector<int>          crossings;   // Shared edges leaving the component, per root
+    std::vector<std::int64_t> first_costs; // Cost of the first parent's edges, per root
+    std::vector<std::int64_t> second_costs;
+    std::vector<Graph::Index> neighbours; // Two per node, the edges of the child
+    std::vector<char>         degrees;
+};
+
+} // namespace aco
+
+#endif // ACO_RECOMBINATION_HPP
@@ -0,0 +1,219 @@
+#include "AcoReordering.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+
+namespace aco {
+
+// Index of a point of a 2^bits x 2^bits grid along the Hilbert curve
+static std::uint64_t hilbert_index(std::uint32_t x, std::uint32_t y, int bits) {
+    const std::uint32_t side = std::uint32_t(1) << bits;
+    std::uint64_t       index = 0;
+    for (std::uint32_t s = side / 2; s > 0; s /= 2) {
+        std::uint32_t rx = (x & s) > 0;
+        std::uint32_t ry = (y & s) > 0;
+        index += std::uint64_t(s) * s * ((3 * rx) ^ ry);
+
+        // Rotate the quadrant, so that the curve inside of it has the canonical orientation
+        if (ry == 0) {
+            if (rx == 1) {
+                x = side - 1 - x;
+                y = side - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return index;
+}
+
+Reordering::Reordering(std::size_t nodes) : order(nodes), positions(nodes) {
+    std::iota(begin(order), end(order), 0);
+    std::iota(begin(positions), end(positions), 0);
+}
+
+Reordering Reordering::from_order(Path order) {
+    Reordering result;
+    result.positions.assign(order.size(), order.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        if (order[i] >= order.size() || result.positions[order[i]] != order.size()) {
+            std::cerr << "aco::Reordering invalid argument. Order is not a permutation!\n";
+            throw std::invalid_argument("aco::Reordering order is not a permutation!");
+        }
+        result.positions[order[i]] = i;
+    }
+    result.order = std::move(order);
+    return result;
+}
+
+Reordering Reordering::hilbert(const std::vector<Point>& points) {
+    if (points.empty()) {
+        return Reordering();
+    }
+    const int bits = 16;
+    double    min_x = points[0].x, max_x = points[0].x;
+    double    min_y = points[0].y, max_y = points[0].y;
+    for (const auto& point : points) {
+        min_x = std::min(min_x, point.x);
+        max_x = std::max(max_x, point.x);
+        min_y = std::min(min_y, point.y);
+        max_y = std::max(max_y, point.y);
+    }
+    auto scale = ((1 << bits) - 1) / std::max({max_x - min_x, max_y - min_y, 1e-9});
+
+    std::vector<std::uint64_t> keys(points.size());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        keys[i] = hilbert_index(static_cast<std::uint32_t>((points[i].x - min_x) * scale),
+                                static_cast<std::uint32_t>((points[i].y - min_y) * scale), bits);
+    }
+
+    Path order(points.size());
+    std::iota(begin(order), end(order), 0);
+    std::stable_sort(begin(order), end(order), [&](Index a, Index b) { return keys[a] < keys[b]; });
+    return from_order(std::move(order));
+}
+
+Reordering Reordering::nearest_neighbour(const Graph& graph) {
+    auto n = graph.get_size();
+    if (n == 0) {
+        return Reordering();
+    }
+
+    std::vector<char> visited(n, 0);
+    Path              order{0};
+    visited[0] = 1;
+    while (order.size() < n) {
+        auto current = order.back();
+        auto next = n;
+        int  next_cost = 0;
+        for (Index j = 0; j < n; ++j) {
+            if (!visited[j] && (next == n || graph.get_cost(current, j) < next_cost)) {
+                next = j;
+                next_cost = graph.get_cost(current, j);
+            }
+        }
+        visited[next] = 1;
+        order.push_back(next);
+    }
+    return from_order(std::move(order));
+}
+
+Reordering Reordering::cuthill_mckee(const Graph& graph, std::size_t k) {
+    auto n = graph.get_size();
+    k = std::min(k, n > 0 ? n - 1 : 0);
+
+    // Step 1: the k cheapest edges of every node, in both directions
+    std::vector<Path> neighbours(n);
+    Path              candidates;
+    for (Index i = 0; i < n; ++i) {
+        candidates.clear();
+        for (Index j = 0; j < n; ++j) {
+            if (j != i) {
+                candidates.push_back(j);
+            }
+        }
+        std::partial_sort(begin(candidates), begin(candidates) + k, end(candidates),
+                          [&](Index a, Index b) {
+                              auto cost_a = graph.get_cost(i, a);
+                              auto cost_b = graph.get_cost(i, b);
+                              return cost_a != cost_b ? cost_a < cost_b : a < b;
+                          });
+        for (std::size_t c = 0; c < k; ++c) {
+            neighbours[i].push_back(candidates[c]);
+            neighbours[candidates[c]].push_back(i);
+        }
+    }
+    for (auto& list : neighbours) {
+        std::sort(begin(list), end(list));
+        list.erase(std::unique(begin(list), end(list)), end(list));
+    }
+    auto by_degree = [&](Index a, Index b) {
+        return neighbours[a].size() != neighbours[b].size()
+                   ? neighbours[a].size() < neighbours[b].size()
+                   : a < b;
+    };
+
+    // Step 2: breadth-first search of every component, starting from a node of the lowest degree,
+    // visiting the neighbours of every node by increasing degree
+    Path starts(n);
+    std::iota(begin(starts), end(starts), 0);
+    std::sort(begin(starts), end(starts), by_degree);
+
+    std::vector<char> visited(n, 0);
+    Path              order;
+    order.reserve(n);
+    for (auto start : starts) {
+        if (visited[start]) {
+            continue;
+        }
+        visited[start] = 1;
+        order.push_back(start);
+        for (auto head = order.size() - 1; head < order.size(); ++head) {
+            auto first = order.size();
+            for (auto neighbour : neighbours[order[head]]) {
+                if (!visited[neighbour]) {
+                    visited[neighbour] = 1;
+                    order.push_back(neighbour);
+                }
+            }
+            std::sort(begin(order) + first, end(order), by_degree);
+        }
+    }
+
+    // Step 3: reversed, which keeps the same bandwidth but usually reduces the profile
+    std::reverse(begin(order), end(order));
+    return from_order(std::move(order));
+}
+
+void Reordering::to_internal(const Path& path, Path& result) const {
+    result.resize(path.size());
+    for (std::size_t i = 0; i < path.size(); ++i) {
+        result[i] = positions[path[i]];
+    }
+}
+
+void Reordering::to_original(const Path& path, Path& result) const {
+    result.resize(path.size());
+    for (std::size_t i = 0; i < path.size(); ++i) {
+        result[i] = order[path[i]];
+    }
+}
+
+Reordering::Path Reordering::to_internal(const Path& path) const {
+    Path result;
+    to_internal(path, result);
+    return result;
+}
+
+Reordering::Path Reordering::to_original(const Path& path) const {
+    Path result;
+    to_original(path, result);
+    return result;
+}
+
+void Reordering::add_node() {
+    order.push_back(order.size());
+    positions.push_back(positions.size());
+}
+
+void Reordering::remove_node(Index original) {
+    if (original >= order.size()) {
+        std::cerr << "aco::Reordering::remove_node index out of range. Size: " << order.size()
+                  << ", index: " << original << "\n";
+        throw std::invalid_argument("aco::Reordering::remove_node index out of range!");
+    }
+
+    // Both numberings are compacted, like the graph
+    order.erase(begin(order) + positions[original]);
+    for (auto& elem : order) {
+        elem -= elem > original ? 1 : 0;
+    }
+    positions.resize(order.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        positions[order[i]] = i;
+    }
+}
+
+} // namespace aco
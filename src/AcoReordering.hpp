@@ -0,0 +1,73 @@
+#include <cstddef>
+#include <vector>
+
+#include "AcoGraph.hpp"
+#include "AcoSpatialIndex.hpp"
+
+#ifndef ACO_REORDERING_HPP
+#define ACO_REORDERING_HPP
+
+namespace aco {
+
+// Renumbering of the nodes of a graph, so that nodes close to each other get close indices.
+// Node indices of an instance are arbitrary, so consecutive steps of an ant jump between distant
+// rows of the matrices, and the likely candidates of a row are scattered all over it. Ants mostly
+// move between near cities, so with a locality-preserving order they stay in nearby rows, and the
+// candidates of a row share cache lines. See AlgorithmReordered, which maps the paths back.
+// Internal indices are the ones of the reordered graph, original are the ones of the input.
+class Reordering {
+  public:
+    using Index = Graph::Index;
+    using Path  = Graph::Path;
+
+  public:
+    // Identity
+    explicit Reordering(std::size_t nodes = 0);
+
+    // 'order' is the original index of every internal node. Throws std::invalid_argument unless
+    // it's a permutation.
+    static Reordering from_order(Path order);
+
+    // Along the Hilbert curve over the bounding box, for instances given by coordinates (as in
+    // Graph::from_points). O(n log n).
+    static Reordering hilbert(const std::vector<Point>& points);
+
+    // Greedy nearest-neighbour chain from the first node, for instances given by a matrix: every
+    // next node is the cheapest one to go to from the previous node. O(n^2).
+    static Reordering nearest_neighbour(const Graph& graph);
+
+    // Reverse Cuthill-McKee over the graph of the 'k' cheapest edges of every node (taken both
+    // ways), for instances given by a matrix. Keeps the neighbours of every node within a narrow
+    // band of indices. O(n^2 log k).
+    static Reordering cuthill_mckee(const Graph& graph, std::size_t k = 8);
+
+  public:
+    std::size_t get_size() const { return order.size(); }
+    const Path& get_order() const { return order; }
+
+    Index to_internal(Index original) const { return positions[original]; }
+    Index to_original(Index internal) const { return order[internal]; }
+
+    // Map every node of the path, into 'result' to reuse its memory
+    void to_internal(const Path& path, Path& result) const;
+    void to_original(const Path& path, Path& result) const;
+    Path to_internal(const Path& path) const;
+    Path to_original(const Path& path) const;
+
+    // The graph with internal indices, and back
+    Graph apply(const Graph& original) const { return original.permuted(order); }
+    Graph restore(const Graph& internal) const { return internal.permuted(positions); }
+
+    // Follow the dynamic changes of the graph (see Graph::add_node and Graph::remove_node). A new
+    // node is the last one in both numberings.
+    void add_node();
+    void remove_node(Index original);
+
+  private:
+    Path order;     // Original index of every internal node
+    Path positions; // Internal index of every original node
+};
+
+} // namespace aco
+
+#endif // ACO_REORDERING_HPP
@@ -0,0 +1,121 @@
+#include "AcoRunLog.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+namespace aco {
+
+// NaN and infinities are not valid JSON numbers
+static void write_number(std::ostream& out, float value) {
+    if (std::isfinite(value)) {
+        out << value;
+    } else {
+        out << "null";
+    }
+}
+
+RunLog::RunLog(const std::string& path, Format format_arg, std::size_t capacity,
+               std::size_t tour_capacity)
+    : format(format_arg),
+      file(path, format_arg == Format::Binary ? std::ios::out | std::ios::binary : std::ios::out),
+      records(capacity), tours(tour_capacity), dropped_records(0), finished(false) {
+    if (!file) {
+        std::cerr << "RunLog: Could not open the file: " << path << "\n";
+        throw std::runtime_error("Could not open the file!");
+    }
+    writer = std::thread(&RunLog::drain, this);
+}
+
+RunLog::~RunLog() {
+    finished.store(true, std::memory_order_release);
+    writer.join();
+}
+
+bool RunLog::log(const Record& record, const Graph::Index* tour) {
+    // The tour goes first, so that it's there once the writer sees the record
+    if (records.free() < 1 || tours.free() < record.tour_size) {
+        dropped_records.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    tours.push(tour, record.tour_size);
+    records.push(record);
+    return true;
+}
+
+void RunLog::write_ndjson(std::ostream& out, const Record& record, const Graph::Index* tour) {
+    out << "{\"algorithm\":" << record.algorithm << ",\"iteration\":" << record.iteration
+        << ",\"best_length\":" << record.best_length
+        << ",\"iteration_length\":" << record.iteration_length
+        << ",\"elapsed_ns\":" << record.elapsed_ns << ",\"advance_ns\":" << record.advance_ns
+        << ",\"solver_ns\":" << record.solver_ns << ",\"branching_factor\":";
+    write_number(out, record.branching_factor);
+    out << ",\"entropy\":";
+    write_number(out, record.entropy);
+    out << ",\"diversity\":";
+    write_number(out, record.diversity);
+    if (record.tour_size > 0) {
+        out << ",\"tour\":[";
+        for (std::uint32_t i = 0; i < record.tour_size; ++i) {
+            out << (i > 0 ? "," : "") << tour[i];
+        }
+        out << "]";
+    }
+    out << "}\n";
+}
+
+void RunLog::convert(std::istream& binary, std::ostream& ndjson) {
+    Record                    record;
+    std::vector<Graph::Index> tour;
+    while (binary.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+        tour.resize(record.tour_size);
+        if (!binary.read(reinterpret_cast<char*>(tour.data()),
+                         tour.size() * sizeof(Graph::Index))) {
+            std::cerr << "RunLog: Truncated binary log!\n";
+            throw std::runtime_error("Truncated binary log!");
+        }
+        write_ndjson(ndjson, record, tour.data());
+    }
+    // A partial record at the end
+    if (binary.gcount() != 0) {
+        std::cerr << "RunLog: Truncated binary log!\n";
+        throw std::runtime_error("Truncated binary log!");
+    }
+}
+
+void RunLog::drain() {
+    while (true) {
+        // Check before draining, records logged before finishing are written in any case
+        auto last = finished.load(std::memory_order_acquire);
+        bool any = false;
+        while (write_next()) {
+            any = true;
+        }
+        if (last) {
+            break;
+        }
+        if (!any) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    file.flush();
+}
+
+bool RunLog::write_next() {
+    Record record;
+    if (!records.pop(record)) {
+        return false;
+    }
+    tour.resize(record.tour_size);
+    tours.pop(tour.data(), tour.size());
+
+    if (format == Format::Binary) {
+        file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        file.write(reinterpret_cast<const char*>(tour.data()), tour.size() * sizeof(Graph::Index));
+    } else {
+        write_ndjson(file, record, tour.data());
+    }
+    return true;
+}
+
+} // namespace aco
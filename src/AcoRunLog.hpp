@@ -0,0 +1,88 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AcoGraph.hpp"
+#include "RingBuffer.hpp"
+
+#ifndef ACO_RUN_LOG_HPP
+#define ACO_RUN_LOG_HPP
+
+namespace aco {
+
+// Structured log of a run, written in the background. The producer (e.g. Solver) only copies
+// compact records to a lock-free ring buffer, a writer thread drains it to a file, so that the
+// simulation never waits for formatting or I/O. Tours are logged only with the records of
+// improvements. The producer never blocks either: records that don't fit are dropped and counted.
+class RunLog {
+  public:
+    enum class Format {
+        Binary, // Raw records, each followed by its tour_size indices (see convert)
+        Ndjson, // One JSON object per line
+    };
+
+    struct Record {
+        std::uint32_t algorithm = 0; // Chosen by the producer, e.g. index of the algorithm
+        std::uint32_t iteration = 0;
+        std::int64_t  best_length = 0;      // Best so far, after the iteration
+        std::int64_t  iteration_length = 0; // Iteration best
+        std::int64_t  elapsed_ns = 0;       // Since the start of the run
+        std::int64_t  advance_ns = 0;       // Spent in Algorithm::advance()
+        std::int64_t  solver_ns = 0;        // Spent in the solver outside of advance()
+        float         branching_factor = 0; // See Diagnostics, NaN when not measured
+        float         entropy = 0;
+        float         diversity = 0;
+        std::uint32_t tour_size = 0; // Cities of the best tour, zero if it didn't improve
+    };
+
+  public:
+    // 'capacity' records and 'tour_capacity' cities of their tours can wait for the writer.
+    // Throws std::runtime_error if the file can't be opened.
+    RunLog(const std::string& path, Format format, std::size_t capacity = 4096,
+           std::size_t tour_capacity = std::size_t(1) << 20);
+
+    // Writes the remaining records and closes the file
+    ~RunLog();
+
+    RunLog(const RunLog&) = delete;
+    RunLog& operator=(const RunLog&) = delete;
+
+  public:
+    // Producer side, must be called from a single thread only. 'tour' is required when
+    // record.tour_size is non-zero. Returns false if the record was dropped, as the writer
+    // couldn't keep up.
+    bool log(const Record& record, const Graph::Index* tour = nullptr);
+
+    // Records dropped so far
+    std::size_t dropped() const { return dropped_records.load(std::memory_order_relaxed); }
+
+    // Format a record (and its tour, if any) as a single NDJSON line. NaN is written as null.
+    static void write_ndjson(std::ostream& out, const Record& record, const Graph::Index* tour);
+
+    // Convert a log in the Binary format to NDJSON. Throws std::runtime_error on truncated input.
+    static void convert(std::istream& binary, std::ostream& ndjson);
+
+  private:
+    // Writer thread
+    void drain();
+    bool write_next();
+
+  private:
+    Format                          format;
+    std::ofstream                   file;
+    utils::RingBuffer<Record>       records;
+    utils::RingBuffer<Graph::Index> tours; // Tours of the records, in the same order
+    std::vector<Graph::Index>       tour;  // Writer's buffer
+    std::atomic<std::size_t>        dropped_records;
+    std::atomic<bool>               finished;
+    std::thread                     writer;
+};
+
+} // namespace aco
+
+#endif // ACO_RUN_LOG_HPP
@@ -0,0 +1,261 @@
+#include "AcoSimdTourBuilder.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ACO_SIMD_TOUR_BUILDER_X86
+#include <immintrin.h>
+#endif
+
+namespace aco {
+
+// Lanes emulated by the scalar version
+static constexpr std::size_t scalar_lanes = 8;
+
+// xorshift32, returns a number in [0, 1) built from the upper 24 bits
+static float next_random(std::uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return (state >> 8) * (1.f / 16777216);
+}
+
+// Roulette over the unvisited cities of every lane, in two passes: the total score, and then the
+// first city where the running sum exceeds the random threshold. Lanes that found nothing (only
+// possible due to floating point rounding, or with no score left at all) are marked with -1.
+static void choose_scalar(const float* scores, std::size_t nodes, const std::uint32_t* available,
+                          const std::int32_t* row_offsets, std::uint32_t* random,
+                          std::int32_t* chosen) {
+    for (std::size_t lane = 0; lane < scalar_lanes; ++lane) {
+        const auto* row = scores + row_offsets[lane];
+        float       total = 0;
+        for (std::size_t j = 0; j < nodes; ++j) {
+            total += available[j * scalar_lanes + lane] ? row[j] : 0.f;
+        }
+
+        float threshold = next_random(random[lane]) * total;
+        float partial = 0;
+        chosen[lane] = -1;
+        for (std::size_t j = 0; j < nodes; ++j) {
+            partial += available[j * scalar_lanes + lane] ? row[j] : 0.f;
+            if (partial > threshold) {
+                chosen[lane] = j;
+                break;
+            }
+        }
+    }
+}
+
+#ifdef ACO_SIMD_TOUR_BUILDER_X86
+// Scores of city j for every lane, zero if the lane already visited it
+__attribute__((target("avx2"))) static inline __m256
+gather_avx2(const float* scores, const std::uint32_t* available, __m256i offsets, std::size_t j) {
+    auto mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(available + j * 8));
+    auto index = _mm256_add_epi32(offsets, _mm256_set1_epi32(j));
+    auto score = _mm256_i32gather_ps(scores, index, sizeof(float));
+    return _mm256_and_ps(score, _mm256_castsi256_ps(mask));
+}
+
+__attribute__((target("avx2"))) static void
+choose_avx2(const float* scores, std::size_t nodes, const std::uint32_t* available,
+            const std::int32_t* row_offsets, std::uint32_t* random, std::int32_t* chosen) {
+    const auto offsets = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row_offsets));
+
+    auto total = _mm256_setzero_ps();
+    for (std::size_t j = 0; j < nodes; ++j) {
+        total = _mm256_add_ps(total, gather_avx2(scores, available, offsets, j));
+    }
+
+    // xorshift32 of every lane, same as next_random()
+    auto state = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(random));
+    state = _mm256_xor_si256(state, _mm256_slli_epi32(state, 13));
+    state = _mm256_xor_si256(state, _mm256_srli_epi32(state, 17));
+    state = _mm256_xor_si256(state, _mm256_slli_epi32(state, 5));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(random), state);
+    auto uniform = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(state, 8)),
+                                 _mm256_set1_ps(1.f / 16777216));
+    auto threshold = _mm256_mul_ps(uniform, total);
+
+    const auto not_found = _mm256_set1_epi32(-1);
+    auto       result = not_found;
+    auto       partial = _mm256_setzero_ps();
+    for (std::size_t j = 0; j < nodes; ++j) {
+        partial = _mm256_add_ps(partial, gather_avx2(scores, available, offsets, j));
+
+        // Only lanes which haven't found their city yet
+        auto pending = _mm256_cmpeq_epi32(result, not_found);
+        auto hit = _mm256_and_si256(
+            _mm256_castps_si256(_mm256_cmp_ps(partial, threshold, _CMP_GT_OQ)), pending);
+        result = _mm256_blendv_epi8(result, _mm256_set1_epi32(j), hit);
+        if (_mm256_testz_si256(_mm256_cmpeq_epi32(result, not_found), not_found)) {
+            break;
+        }
+    }
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(chosen), result);
+}
+
+// Same as gather_avx2(), but cities already visited are not gathered at all
+__attribute__((target("avx512f"))) static inline __m512
+gather_avx512(const float* scores, const std::uint32_t* available, __m512i offsets, std::size_t j) {
+    auto mask = _mm512_loadu_si512(available + j * 16);
+    auto index = _mm512_add_epi32(offsets, _mm512_set1_epi32(j));
+    return _mm512_mask_i32gather_ps(_mm512_setzero_ps(), _mm512_test_epi32_mask(mask, mask), index,
+                                    scores, sizeof(float));
+}
+
+__attribute__((target("avx512f"))) static void
+choose_avx512(const float* scores, std::size_t nodes, const std::uint32_t* available,
+              const std::int32_t* row_offsets, std::uint32_t* random, std::int32_t* chosen) {
+    const auto offsets = _mm512_loadu_si512(row_offsets);
+
+    auto total = _mm512_setzero_ps();
+    for (std::size_t j = 0; j < nodes; ++j) {
+        total = _mm512_add_ps(total, gather_avx512(scores, available, offsets, j));
+    }
+
+    // xorshift32 of every lane, same as next_random()
+    auto state = _mm512_loadu_si512(random);
+    state = _mm512_xor_si512(state, _mm512_slli_epi32(state, 13));
+    state = _mm512_xor_si512(state, _mm512_srli_epi32(state, 17));
+    state = _mm512_xor_si512(state, _mm512_slli_epi32(state, 5));
+    _mm512_storeu_si512(random, state);
+    auto uniform = _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_srli_epi32(state, 8)),
+                                 _mm512_set1_ps(1.f / 16777216));
+    auto threshold = _mm512_mul_ps(uniform, total);
+
+    auto      result = _mm512_set1_epi32(-1);
+    auto      partial = _mm512_setzero_ps();
+    __mmask16 pending = 0xffff;
+    for (std::size_t j = 0; j < nodes && pending; ++j) {
+        partial = _mm512_add_ps(partial, gather_avx512(scores, available, offsets, j));
+        auto hit = _mm512_mask_cmp_ps_mask(pending, partial, threshold, _CMP_GT_OQ);
+        result = _mm512_mask_mov_epi32(result, hit, _mm512_set1_epi32(j));
+        pending &= ~hit;
+    }
+
+    _mm512_storeu_si512(chosen, result);
+}
+#endif
+
+SimdTourBuilder::SimdTourBuilder(kernels::Isa isa_arg)
+    : isa(isa_arg), lanes(isa == kernels::Isa::Avx512 ? 16 : scalar_lanes), nodes(0), scores(),
+      available(), row_offsets(), random(), chosen() {
+    if (!kernels::is_supported(isa)) {
+        std::cerr << "aco::SimdTourBuilder: instruction set not supported: " << isa << "\n";
+        throw std::invalid_argument("aco::SimdTourBuilder: instruction set not supported!");
+    }
+}
+
+std::size_t SimdTourBuilder::get_memory_usage() const {
+    return Footprint::capacity_bytes(scores) + Footprint::capacity_bytes(available) +
+           Footprint::capacity_bytes(row_offsets) + Footprint::capacity_bytes(random) +
+           Footprint::capacity_bytes(chosen);
+}
+
+void SimdTourBuilder::resize(std::size_t nodes_arg) {
+    if (nodes_arg * nodes_arg > std::size_t(std::numeric_limits<std::int32_t>::max())) {
+        std::cerr << "aco::SimdTourBuilder: graph too big: " << nodes_arg << " nodes\n";
+        throw std::invalid_argument("aco::SimdTourBuilder: graph too big!");
+    }
+    nodes = nodes_arg;
+    scores.resize(nodes * nodes);
+}
+
+void SimdTourBuilder::update(const Graph& graph, float alpha, float beta) {
+    resize(graph.get_size());
+    for (std::size_t i = 0; i < nodes; ++i) {
+        const auto offset = i * nodes;
+        for (std::size_t j = 0; j < nodes; ++j) {
+            // There's no edge to self, leave it a score of zero
+            scores[offset + j] = i == j ? 0.f
+                                        : ChoiceInfo::score(graph.pheromones[offset + j],
+                                                            graph.costs[offset + j], alpha, beta);
+        }
+    }
+}
+
+void SimdTourBuilder::load(const ChoiceInfo& choice_info) {
+    resize(choice_info.get_size());
+    for (Graph::Index i = 0; i < nodes; ++i) {
+        choice_info.load_row(i, scores.data() + i * nodes);
+    }
+}
+
+void SimdTourBuilder::build(const ChoiceInfo& choice_info, std::size_t count, std::mt19937& gen,
+                            Graph::Index* tours) {
+    load(choice_info);
+    build(count, gen, tours);
+}
+
+void SimdTourBuilder::build(std::size_t count, std::mt19937& gen, Graph::Index* tours) {
+    if (nodes == 0) {
+        return;
+    }
+
+    // Step 1: the state of every lane, every step gathers from different rows of the scores
+    available.resize(nodes * lanes);
+    row_offsets.resize(lanes);
+    random.resize(lanes);
+    chosen.resize(lanes);
+
+    for (std::size_t first = 0; first < count; first += lanes) {
+        // Step 2: start cities. Lanes past 'count' build a tour which is thrown away.
+        auto batch = std::min(lanes, count - first);
+        std::fill(begin(available), end(available), ~std::uint32_t(0));
+        for (std::size_t lane = 0; lane < lanes; ++lane) {
+            auto start = (first + lane) % nodes;
+            available[start * lanes + lane] = 0;
+            row_offsets[lane] = start * nodes;
+            random[lane] = gen() | 1; // xorshift state must not be zero
+            if (lane < batch) {
+                tours[(first + lane) * nodes] = start;
+            }
+        }
+
+        // Step 3: all lanes choose their next city together
+        for (std::size_t step = 1; step < nodes; ++step) {
+            choose();
+            for (std::size_t lane = 0; lane < lanes; ++lane) {
+                auto city = chosen[lane];
+                if (city < 0) {
+                    // Nothing found due to rounding, take the last unvisited city
+                    city = nodes - 1;
+                    while (!available[city * lanes + lane]) {
+                        --city;
+                    }
+                }
+
+                available[city * lanes + lane] = 0;
+                row_offsets[lane] = city * nodes;
+                if (lane < batch) {
+                    tours[(first + lane) * nodes + step] = city;
+                }
+            }
+        }
+    }
+}
+
+void SimdTourBuilder::choose() {
+    switch (isa) {
+#ifdef ACO_SIMD_TOUR_BUILDER_X86
+    case kernels::Isa::Avx512:
+        choose_avx512(scores.data(), nodes, available.data(), row_offsets.data(), random.data(),
+                      chosen.data());
+        return;
+    case kernels::Isa::Avx2:
+        choose_avx2(scores.data(), nodes, available.data(), row_offsets.data(), random.data(),
+                    chosen.data());
+        return;
+#endif
+    default:
+        choose_scalar(scores.data(), nodes, available.data(), row_offsets.data(), random.data(),
+                      chosen.data());
+        return;
+    }
+}
+
+} // namespace aco
@@ -0,0 +1,79 @@
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "AcoChoiceInfo.hpp"
+#include "AcoGraph.hpp"
+#include "AcoKernels.hpp"
+#include "HugePageAllocator.hpp"
+
+#ifndef ACO_SIMD_TOUR_BUILDER_HPP
+#define ACO_SIMD_TOUR_BUILDER_HPP
+
+namespace aco {
+
+// Constructs the tours of many ants in lockstep, one ant per SIMD lane (16 with AVX-512, 8
+// otherwise). Every lane has its own current city, visited cities and random generator, and in
+// every step all lanes choose their next city together, with the exact roulette over unvisited
+// cities. Scores of a step are gathered from the score rows of the current cities, which are either
+// calculated straight from the graph or loaded from a choice info.
+// This is the CPU counterpart of the one thread per ant model of the GPU. It keeps small graphs (up
+// to a few hundred cities) fully vectorized, where vectorizing a single ant over candidate cities
+// leaves most of the registers unused.
+// Tours depend only on the number of lanes, not on the instruction set: the scalar version
+// emulates 8 lanes, with the same random numbers and the same order of floating point operations.
+// Holds the workspace of a batch of ants, so it should be reused between iterations.
+class SimdTourBuilder {
+  public:
+    // Throws std::invalid_argument if the instruction set is not supported
+    explicit SimdTourBuilder(kernels::Isa isa = kernels::best_isa());
+
+  public:
+    kernels::Isa get_isa() const { return isa; }
+    std::size_t  get_lanes() const { return lanes; }
+
+    // Recalculate the scores of all edges from the graph, with the weights of the pheromone (alpha)
+    // and of the heuristic (beta), see ChoiceInfo::score. A single pass over the matrices, without
+    // the values and cumulative rows of a ChoiceInfo in between.
+    // Throws std::invalid_argument if the graph is too big to be indexed with 32-bit integers.
+    void update(const Graph& graph, float alpha, float beta);
+
+    // Take the scores from a choice info instead. Throws like update().
+    void load(const ChoiceInfo& choice_info);
+
+    // Build 'count' tours with the current scores, written one after the other to 'tours' (as
+    // many cities each as the graph). Tour i starts from city i modulo the number of cities, like
+    // the agents of other algorithms.
+    void build(std::size_t count, std::mt19937& gen, Graph::Index* tours);
+
+    // load() and build()
+    void build(const ChoiceInfo& choice_info, std::size_t count, std::mt19937& gen,
+               Graph::Index* tours);
+
+    // Bytes held by the workspace, including the reserved capacity
+    std::size_t get_memory_usage() const;
+
+  private:
+    // Resize the scores for a graph of 'nodes' cities, throws if it's too big
+    void resize(std::size_t nodes);
+
+    // Choose the next city of every lane, writes to 'chosen'
+    void choose();
+
+  private:
+    kernels::Isa isa;
+    std::size_t  lanes;
+    std::size_t  nodes;
+
+    // Workspace
+    utils::LargeVector<float>  scores;      // Score of every edge, nodes * nodes
+    std::vector<std::uint32_t> available;   // nodes * lanes, all ones if the lane may go there
+    std::vector<std::int32_t>  row_offsets; // Offset of the current city's row, for every lane
+    std::vector<std::uint32_t> random;      // xorshift32 state of every lane
+    std::vector<std::int32_t>  chosen;      // The next city of every lane
+};
+
+} // namespace aco
+
+#endif // ACO_SIMD_TOUR_BUILDER_HPP
@@ -0,0 +1,169 @@
+#include "AcoSolver.hpp"
+
+#include <iostream>
+#include <stdexcept>
+
+namespace aco {
+
+std::ostream& operator<<(std::ostream& out, Solver::StopReason reason) {
+    switch (reason) {
+    case Solver::StopReason::Iterations:
+        out << "iterations";
+        return out;
+    case Solver::StopReason::Time:
+        out << "time";
+        return out;
+    case Solver::StopReason::Stagnation:
+        out << "stagnation";
+        return out;
+    case Solver::StopReason::Target:
+        out << "target";
+        return out;
+    case Solver::StopReason::Convergence:
+        out << "convergence";
+        return out;
+    case Solver::StopReason::Request:
+        out << "request";
+        return out;
+    }
+
+    out << "unknown";
+    return out;
+}
+
+static std::int64_t nanoseconds(Solver::Clock::duration duration) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+}
+
+void Solver::validate(const StopCriteria& criteria) {
+    if (criteria.max_iterations < 0 || criteria.time_limit.count() < 0 ||
+        criteria.max_stagnation < 0 || criteria.target_length < 0 ||
+        criteria.min_branching_factor < 0) {
+        std::cerr << "aco::Solver invalid argument. Stop criteria can't be negative!\n";
+        throw std::invalid_argument("aco::Solver negative stop criteria!");
+    }
+    if (criteria.max_iterations == 0 && criteria.time_limit.count() == 0 &&
+        criteria.max_stagnation == 0 && criteria.target_length == 0 &&
+        criteria.min_branching_factor == 0) {
+        std::cerr << "aco::Solver invalid argument. At least one stop criterion is required!\n";
+        throw std::invalid_argument("aco::Solver no stop criteria!");
+    }
+}
+
+Solver::Solver(Algorithm& algorithm_arg, StopCriteria criteria_arg, RunLog* run_log_arg,
+               std::uint32_t log_id_arg)
+    : algorithm(algorithm_arg), criteria(criteria_arg), run_log(run_log_arg), log_id(log_id_arg),
+      stop_requested(false), snapshots() {
+    validate(criteria);
+}
+
+Solver::Result Solver::run() {
+    const auto begin = Clock::now();
+    const auto deadline = begin + criteria.time_limit;
+    stop_requested = false;
+
+    auto best = algorithm.get_shortest_path();
+    auto best_length = algorithm.path_length(best);
+    publish(best, best_length, 0);
+
+    Result result{{}, 0, 0, {}, StopReason::Iterations};
+    int    stagnation = 0;
+    while (true) {
+        // Advance simulation
+        auto iteration_begin = Clock::now();
+        auto iteration_best = algorithm.advance();
+        auto iteration_end = Clock::now();
+        ++result.iterations;
+
+        // Publish if improved
+        const auto& shortest = algorithm.get_shortest_path();
+        auto        length = algorithm.path_length(shortest);
+        bool        improved = length < best_length;
+        if (improved) {
+            best = shortest;
+            best_length = length;
+            stagnation = 0;
+            publish(best, best_length, result.iterations);
+        } else {
+            ++stagnation;
+        }
+        if (run_log != nullptr) {
+            auto           now = Clock::now();
+            RunLog::Record record;
+            record.iteration = result.iterations;
+            record.best_length = best_length;
+            record.iteration_length = algorithm.path_length(iteration_best);
+            record.elapsed_ns = nanoseconds(now - begin);
+            record.advance_ns = nanoseconds(iteration_end - iteration_begin);
+            record.solver_ns = nanoseconds(now - iteration_end);
+            log(record, improved ? &best : nullptr);
+        }
+
+        // Check stop criteria
+        if (criteria.target_length > 0 && best_length <= criteria.target_length) {
+            result.reason = StopReason::Target;
+            break;
+        }
+        // Not available (NaN) compares false, if diagnostics are disabled
+        if (criteria.min_branching_factor > 0 &&
+            algorithm.get_diagnostics().branching_factor <= criteria.min_branching_factor) {
+            result.reason = StopReason::Convergence;
+            break;
+        }
+        if (criteria.max_iterations > 0 && result.iterations >= criteria.max_iterations) {
+            result.reason = StopReason::Iterations;
+            break;
+        }
+        if (criteria.max_stagnation > 0 && stagnation >= criteria.max_stagnation) {
+            result.reason = StopReason::Stagnation;
+            break;
+        }
+        if (criteria.time_limit.count() > 0 &&
+            iteration_end + (iteration_end - iteration_begin) > deadline) {
+            result.reason = StopReason::Time;
+            break;
+        }
+        if (stop_requested) {
+            result.reason = StopReason::Request;
+            break;
+        }
+    }
+
+    result.path = std::move(best);
+    result.length = best_length;
+    result.time = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - begin);
+    return result;
+}
+
+void Solver::request_stop() {
+    stop_requested = true;
+}
+
+const Solver::Snapshot& Solver::best() {
+    snapshots.update();
+    return snapshots.front();
+}
+
+void Solver::log(RunLog::Record record, const Algorithm::Path* improved_path) {
+    auto diagnostics = algorithm.get_diagnostics();
+    record.algorithm = log_id;
+    record.branching_factor = diagnostics.branching_factor;
+    record.entropy = diagnostics.entropy;
+    record.diversity = diagnostics.diversity;
+    if (improved_path != nullptr) {
+        record.tour_size = improved_path->size();
+        run_log->log(record, improved_path->data());
+    } else {
+        run_log->log(record);
+    }
+}
+
+void Solver::publish(const Algorithm::Path& path, std::int64_t length, int iteration) {
+    auto& snapshot = snapshots.back();
+    snapshot.path = path;
+    snapshot.length = length;
+    snapshot.iteration = iteration;
+    snapshots.publish();
+}
+
+} // namespace aco
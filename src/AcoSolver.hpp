@@ -0,0 +1,95 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+#include "AcoAlgorithm.hpp"
+#include "AcoRunLog.hpp"
+#include "TripleBuffer.hpp"
+
+#ifndef ACO_SOLVER_HPP
+#define ACO_SOLVER_HPP
+
+namespace aco {
+
+// Drives an algorithm until one of the stop criteria is met.
+// While it runs, the best path found so far is published after every improvement, so that another
+// thread can take it at any moment, without locks and without pausing the simulation.
+class Solver {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    // Every criterion is optional (zero means disabled), but at least one has to be set.
+    // The one met first stops the simulation.
+    struct StopCriteria {
+        int                       max_iterations = 0;
+        std::chrono::milliseconds time_limit{0}; // Wall-clock time, measured from run() start
+        int                       max_stagnation = 0; // Iterations without improvement
+        std::int64_t              target_length = 0;  // Stop once the path is at least this short
+        float                     min_branching_factor = 0; // Stop once the search converged,
+                                                            // see Diagnostics. Needs diagnostics
+                                                            // enabled in algorithm's Config.
+    };
+
+    enum class StopReason { Iterations, Time, Stagnation, Target, Convergence, Request };
+
+    struct Result {
+        Algorithm::Path           path;
+        std::int64_t              length;
+        int                       iterations;
+        std::chrono::milliseconds time;
+        StopReason                reason;
+    };
+
+    // Best path found so far, published by run()
+    struct Snapshot {
+        Algorithm::Path path;
+        std::int64_t    length = 0;
+        int             iteration = 0; // Iteration that found it, zero for the initial path
+    };
+
+  public:
+    // The algorithm must outlive the solver, and so must the run log, if given. Every iteration is
+    // logged to it as a record of 'log_id', with the best tour on improvements. Throws
+    // std::invalid_argument when no stop criterion is set.
+    explicit Solver(Algorithm& algorithm, StopCriteria criteria, RunLog* run_log = nullptr,
+                    std::uint32_t log_id = 0);
+
+    // The validation of the constructor, for drivers that check the criteria upfront. Throws
+    // std::invalid_argument on a negative criterion, or when none is set.
+    static void validate(const StopCriteria& criteria);
+
+  public:
+    // Run the simulation until one of the criteria is met. Time limit is treated as a deadline: an
+    // iteration is not started if it's not expected to finish before it, based on the duration of
+    // the previous one. At least one iteration is always run.
+    Result run();
+
+    // Thread-safe, meant to be called while run() is in progress. Makes run() return after the
+    // current iteration.
+    void request_stop();
+
+    // Consumer side of the best path publication, must be called from a single thread only.
+    // Returns the most recently published snapshot, which stays valid until the next call.
+    const Snapshot& best();
+
+  private:
+    void publish(const Algorithm::Path& path, std::int64_t length, int iteration);
+
+    // Complete the record of an iteration and push it to the run log
+    void log(RunLog::Record record, const Algorithm::Path* improved_path);
+
+  private:
+    Algorithm&                    algorithm;
+    StopCriteria                  criteria;
+    RunLog*                       run_log;
+    std::uint32_t                 log_id;
+    std::atomic<bool>             stop_requested;
+    utils::TripleBuffer<Snapshot> snapshots;
+};
+
+std::ostream& operator<<(std::ostream&, Solver::StopReason);
+
+} // namespace aco
+
+#endif // ACO_SOLVER_HPP
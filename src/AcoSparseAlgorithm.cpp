@@ -0,0 +1,207 @@
+#include "AcoSparseAlgorithm.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+
+#include "Utils.hpp"
+
+namespace aco {
+
+static void validate_config(SparseAlgorithm::Config config) {
+    if (config.agents_count == 0) {
+        std::cerr << "aco::SparseAlgorithm invalid argument. Agent count should be non-zero!\n";
+        throw std::invalid_argument("aco::SparseAlgorithm invalid agents count argument!");
+    }
+    if (config.pheromone_evaporation < 0 || config.pheromone_evaporation > 1) {
+        std::cerr << "aco::SparseAlgorithm invalid pheromone evaporation argument! Expected in "
+                     "range [0,1], got: "
+                  << config.pheromone_evaporation << "\n";
+        throw std::invalid_argument("aco::SparseAlgorithm invalid pheromone evaporation argument!");
+    }
+    if (config.missing_edge_cost <= 0) {
+        std::cerr << "aco::SparseAlgorithm invalid missing edge cost argument! Expected positive, "
+                     "got: "
+                  << config.missing_edge_cost << "\n";
+        throw std::invalid_argument("aco::SparseAlgorithm invalid missing edge cost argument!");
+    }
+    if (config.alpha < 0 || config.beta < 0) {
+        std::cerr << "aco::SparseAlgorithm invalid alpha or beta argument! Expected non-negative, "
+                     "got: "
+                  << config.alpha << ", " << config.beta << "\n";
+        throw std::invalid_argument("aco::SparseAlgorithm invalid alpha or beta argument!");
+    }
+}
+
+SparseAlgorithm::SparseAlgorithm(std::mt19937& random_generator, SparseGraph graph_arg,
+                                 Config config_arg)
+    : gen(random_generator), graph(std::move(graph_arg)), config(config_arg), shortest_path(),
+      choice_info(), tours(), tour_edges(), lengths(), visited(), unvisited(), positions() {
+    validate_config(config);
+    if (graph.get_size() == 0) {
+        std::cerr << "aco::SparseAlgorithm the graph is empty\n";
+        throw std::invalid_argument("aco::SparseAlgorithm the graph is empty!");
+    }
+
+    // Initialize shortest path just to be valid
+    shortest_path.resize(graph.get_size());
+    std::iota(begin(shortest_path), end(shortest_path), 0);
+}
+
+SparseAlgorithm::Path SparseAlgorithm::advance() {
+    auto cities = graph.get_size();
+    auto agents = config.agents_count;
+
+    {
+        auto scoped = utils::scoped_time_measurement("SparseAlgorithm: update choice info");
+        update_choice_info();
+    }
+
+    // Generate solutions, evaluated on the way
+    tours.resize(agents * cities);
+    tour_edges.resize(agents * cities);
+    lengths.resize(agents);
+    {
+        auto scoped = utils::scoped_time_measurement("SparseAlgorithm: generate solutions");
+        for (std::size_t i = 0; i < agents; ++i) {
+            // Start from a city with index 'i', modulo in case the number of agents is higher than
+            // the number of cities
+            lengths[i] =
+                build(i % cities, tours.data() + i * cities, tour_edges.data() + i * cities);
+        }
+    }
+    auto best = std::min_element(begin(lengths), end(lengths)) - begin(lengths);
+    Path iteration_best(tours.begin() + best * cities, tours.begin() + (best + 1) * cities);
+
+    {
+        auto scoped = utils::scoped_time_measurement("SparseAlgorithm: update pheromones");
+        // Step 1: evaporation of all edges
+        graph.update_all(config.pheromone_evaporation);
+
+        // Step 2: pheromones left by ants, inversely proportional to the tour length, and
+        // proportional to the section length. Jumps leave nothing.
+        for (std::size_t agent = 0; agent < agents; ++agent) {
+            const auto* edges = tour_edges.data() + agent * cities;
+            float       total_pheromone = 1.f / lengths[agent];
+            for (std::size_t i = 0; i < cities; ++i) {
+                auto edge = edges[i];
+                if (edge != SparseGraph::no_edge) {
+                    graph.add_pheromone(edge, total_pheromone / graph.get_cost(edge));
+                }
+            }
+        }
+    }
+
+    // If the iteration best path is shortest than the global shortest (best so far), remember it
+    if (lengths[best] < path_length(shortest_path)) {
+        shortest_path = iteration_best;
+    }
+    return iteration_best;
+}
+
+std::int64_t SparseAlgorithm::path_length(const Path& path) const {
+    return graph.path_length(path, config.missing_edge_cost);
+}
+
+Footprint SparseAlgorithm::get_footprint() const {
+    auto result = graph.get_footprint();
+    result.add("shortest path", Footprint::capacity_bytes(shortest_path));
+    result.add("choice info", Footprint::capacity_bytes(choice_info));
+    result.add("tours", Footprint::capacity_bytes(tours) + Footprint::capacity_bytes(tour_edges) +
+                            Footprint::capacity_bytes(lengths));
+    result.add("tour builder", Footprint::capacity_bytes(visited) +
+                                   Footprint::capacity_bytes(unvisited) +
+                                   Footprint::capacity_bytes(positions));
+    return result;
+}
+
+void SparseAlgorithm::update_choice_info() {
+    const bool plain = config.alpha == 1.f && config.beta == 1.f;
+    choice_info.resize(graph.get_edge_count());
+    for (std::size_t edge = 0; edge < choice_info.size(); ++edge) {
+        float pheromone = graph.get_pheromone(edge);
+        float cost = static_cast<float>(graph.get_cost(edge));
+        // Plain division in the default case, pow() is expensive
+        choice_info[edge] = plain ? pheromone / cost
+                                  : std::pow(pheromone, config.alpha) *
+                                        std::pow(1.f / cost, config.beta);
+    }
+}
+
+std::int64_t SparseAlgorithm::build(Index start, Index* tour, std::size_t* edges) {
+    auto cities = graph.get_size();
+
+    // Step 1: every city is still to visit, but the first one
+    visited.assign(cities, 0);
+    unvisited.resize(cities);
+    positions.resize(cities);
+    std::iota(begin(unvisited), end(unvisited), 0);
+    std::iota(begin(positions), end(positions), 0);
+    auto visit = [&](Index city) {
+        visited[city] = 1;
+        // Swap with the last one, the order doesn't matter
+        auto moved = unvisited.back();
+        unvisited[positions[city]] = moved;
+        positions[moved] = positions[city];
+        unvisited.pop_back();
+    };
+    tour[0] = start;
+    visit(start);
+
+    // Step 2: roulette over the unvisited neighbours, or a jump if there are none
+    std::int64_t length = 0;
+    Index        current = start;
+    for (std::size_t step = 1; step < cities; ++step) {
+        auto first = graph.edges_begin(current);
+        auto last = graph.edges_end(current);
+
+        float       total = 0.f;
+        std::size_t chosen = SparseGraph::no_edge;
+        for (auto edge = first; edge < last; ++edge) {
+            if (!visited[graph.get_target(edge)]) {
+                total += choice_info[edge];
+                // Fallback, in case all the scores underflowed
+                chosen = chosen == SparseGraph::no_edge ? edge : chosen;
+            }
+        }
+        if (total > 0.f) {
+            std::uniform_real_distribution<float> distrib(0, total);
+            float                                 random = distrib(gen);
+            for (auto edge = first; edge < last; ++edge) {
+                if (!visited[graph.get_target(edge)]) {
+                    // The last candidate takes the rest, in case of floating point rounding
+                    chosen = edge;
+                    random -= choice_info[edge];
+                    if (random < 0.f) {
+                        break;
+                    }
+                }
+            }
+        }
+
+        Index next;
+        if (chosen != SparseGraph::no_edge) {
+            next = graph.get_target(chosen);
+            length += graph.get_cost(chosen);
+        } else {
+            std::uniform_int_distribution<std::size_t> distrib(0, unvisited.size() - 1);
+            next = unvisited[distrib(gen)];
+            length += config.missing_edge_cost;
+        }
+
+        tour[step] = next;
+        edges[step - 1] = chosen;
+        visit(next);
+        current = next;
+    }
+
+    // Round trip
+    auto closing = cities > 1 ? graph.find_edge(current, start) : SparseGraph::no_edge;
+    edges[cities - 1] = closing;
+    return length + (closing != SparseGraph::no_edge ? graph.get_cost(closing)
+                                                       : config.missing_edge_cost);
+}
+
+} // namespace aco
@@ -0,0 +1,84 @@
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "AcoFootprint.hpp"
+#include "AcoSparseGraph.hpp"
+
+#ifndef ACO_SPARSE_ALGORITHM_HPP
+#define ACO_SPARSE_ALGORITHM_HPP
+
+namespace aco {
+
+// CPU implementation of the ACO algorithm on a SparseGraph, e.g. a road network. Ants only move
+// along existing edges, so memory and the cost of a step are proportional to the number of edges
+// (the degree of the current city) instead of nodes^2.
+// A tour over existing edges may be hard to find, or may not exist at all. An ant with every
+// neighbour already visited jumps to a random unvisited city instead, and every such jump, as well
+// as a missing closing edge, costs Config::missing_edge_cost (see SparseGraph::path_length).
+// Pheromones are left only on the edges actually used, so that dead ends lose their attraction.
+// A tour with zero SparseGraph::missing_edges is a feasible one.
+// Otherwise the same as AlgorithmCpu, pheromones are left on directed edges.
+class SparseAlgorithm {
+  public:
+    using Path = SparseGraph::Path;
+
+    // Algorithm configuration, see Algorithm::Config
+    struct Config {
+        std::size_t agents_count;          // The number of agents per iteration
+        float       pheromone_evaporation; // In [0,1] range, 1 means no evaporation
+        int         missing_edge_cost; // Cost of a jump, should be higher than any detour, e.g.
+                                       // the sum of a few of the most expensive edges
+        float alpha = 1; // Weight of the pheromone in the choice info: pheromone^alpha
+        float beta = 1;  // Weight of the heuristic in the choice info: (1 / cost)^beta
+    };
+
+  public:
+    // Throws std::invalid_argument on invalid configuration, or an empty graph
+    explicit SparseAlgorithm(std::mt19937& random_generator, SparseGraph graph, Config config);
+
+  public:
+    // Accessors
+    const SparseGraph& get_graph() const { return graph; }
+    const Path&        get_shortest_path() const { return shortest_path; }
+
+    // Advance simulation by one step. Return best path from that iteration.
+    Path advance();
+
+    // With the missing edge cost of the configuration
+    std::int64_t path_length(const Path& path) const;
+
+    // Memory of the graph and of the workspaces
+    Footprint get_footprint() const;
+
+  private:
+    using Index = SparseGraph::Index;
+
+    void update_choice_info();
+
+    // Build the tour of an ant starting from the 'start' city, return its length. 'edges' gets the
+    // edge taken by every step, the closing one last, no_edge for the jumps.
+    std::int64_t build(Index start, Index* tour, std::size_t* edges);
+
+  private:
+    std::mt19937& gen;
+    SparseGraph   graph;
+    Config        config;
+    Path          shortest_path;
+
+    // Per edge, pheromone^alpha * (1 / cost)^beta
+    std::vector<float> choice_info;
+
+    // Workspaces, reused between iterations
+    std::vector<Index>        tours;      // agents_count tours, one after the other
+    std::vector<std::size_t>  tour_edges; // Edges taken by the tours, in the same layout
+    std::vector<std::int64_t> lengths;    // Length of each tour
+    std::vector<char>         visited;    // Per city, of the ant being built
+    std::vector<Index>        unvisited;  // Cities still to visit, in any order, for the jumps
+    std::vector<std::size_t>  positions;  // Index of every city in 'unvisited'
+};
+
+} // namespace aco
+
+#endif // ACO_SPARSE_ALGORITHM_HPP
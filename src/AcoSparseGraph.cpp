@@ -0,0 +1,172 @@
+#include "AcoSparseGraph.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+
+#include "AcoKernels.hpp"
+
+namespace aco {
+
+SparseGraph::SparseGraph(std::size_t nodes_arg, std::vector<Edge> edges,
+                         float initial_pheromone_arg)
+    : nodes(nodes_arg), offsets(nodes_arg + 1, 0), targets(), costs(), pheromones(),
+      initial_pheromone(initial_pheromone_arg) {
+    if (nodes > std::numeric_limits<std::uint32_t>::max()) {
+        std::cerr << "aco::SparseGraph too many nodes: " << nodes << "\n";
+        throw std::invalid_argument("aco::SparseGraph too many nodes!");
+    }
+    for (const auto& edge : edges) {
+        if (edge.src >= nodes || edge.dst >= nodes || edge.src == edge.dst || edge.cost <= 0) {
+            std::cerr << "aco::SparseGraph invalid edge. Graph size: " << nodes
+                      << ", src: " << edge.src << ", dst: " << edge.dst << ", cost: " << edge.cost
+                      << "\n";
+            throw std::invalid_argument("aco::SparseGraph invalid edge!");
+        }
+    }
+
+    // Step 1: order of the CSR arrays, by source and then by target
+    auto by_nodes = [](const Edge& a, const Edge& b) {
+        return std::tie(a.src, a.dst) < std::tie(b.src, b.dst);
+    };
+    std::sort(begin(edges), end(edges), by_nodes);
+    auto same_nodes = [](const Edge& a, const Edge& b) { return a.src == b.src && a.dst == b.dst; };
+    auto duplicate = std::adjacent_find(begin(edges), end(edges), same_nodes);
+    if (duplicate != end(edges)) {
+        std::cerr << "aco::SparseGraph duplicate edge. src: " << duplicate->src
+                  << ", dst: " << duplicate->dst << "\n";
+        throw std::invalid_argument("aco::SparseGraph duplicate edge!");
+    }
+
+    // Step 2: count the edges of every node, the offsets are their running sum
+    for (const auto& edge : edges) {
+        ++offsets[edge.src + 1];
+    }
+    std::partial_sum(begin(offsets), end(offsets), begin(offsets));
+
+    targets.resize(edges.size());
+    costs.resize(edges.size());
+    pheromones.assign(edges.size(), initial_pheromone);
+    for (std::size_t i = 0; i < edges.size(); ++i) {
+        targets[i] = static_cast<std::uint32_t>(edges[i].dst);
+        costs[i] = edges[i].cost;
+    }
+}
+
+[[noreturn]] static void dimacs_error(const std::string& message) {
+    std::cerr << "aco::SparseGraph::from_dimacs: " << message << "\n";
+    throw std::invalid_argument("aco::SparseGraph::from_dimacs: " + message);
+}
+
+SparseGraph SparseGraph::from_dimacs(const std::string& string, float initial_pheromone) {
+    std::istringstream input(string);
+    std::size_t        nodes = 0;
+    bool               problem_seen = false;
+    std::vector<Edge>  edges;
+
+    std::string line;
+    while (std::getline(input, line)) {
+        std::istringstream fields(line);
+        std::string        kind;
+        if (!(fields >> kind) || kind == "c") {
+            continue;
+        }
+
+        if (kind == "p") {
+            std::string format;
+            std::size_t arcs = 0;
+            if (problem_seen || !(fields >> format >> nodes >> arcs) || format != "sp") {
+                dimacs_error("invalid problem line: " + line);
+            }
+            problem_seen = true;
+            edges.reserve(arcs);
+        } else if (kind == "a") {
+            long long src = 0;
+            long long dst = 0;
+            long long cost = 0;
+            if (!problem_seen) {
+                dimacs_error("arc before the problem line: " + line);
+            }
+            if (!(fields >> src >> dst >> cost) || src < 1 || dst < 1 ||
+                static_cast<std::size_t>(src) > nodes || static_cast<std::size_t>(dst) > nodes ||
+                cost <= 0 || cost > std::numeric_limits<int>::max()) {
+                dimacs_error("invalid arc: " + line);
+            }
+            // Some road networks have self loops, they are never part of a tour
+            if (src != dst) {
+                edges.push_back({static_cast<Index>(src - 1), static_cast<Index>(dst - 1),
+                                 static_cast<int>(cost)});
+            }
+        } else {
+            dimacs_error("unsupported line: " + line);
+        }
+    }
+    if (!problem_seen || nodes == 0) {
+        dimacs_error("no nodes");
+    }
+
+    // Parallel arcs: the cheapest one comes first, and is the one kept
+    std::sort(begin(edges), end(edges), [](const Edge& a, const Edge& b) {
+        return std::tie(a.src, a.dst, a.cost) < std::tie(b.src, b.dst, b.cost);
+    });
+    auto last = std::unique(begin(edges), end(edges), [](const Edge& a, const Edge& b) {
+        return a.src == b.src && a.dst == b.dst;
+    });
+    edges.erase(last, end(edges));
+
+    return SparseGraph(nodes, std::move(edges), initial_pheromone);
+}
+
+std::size_t SparseGraph::find_edge(Index src, Index dst) const {
+    validate_node(src);
+    validate_node(dst);
+
+    auto first = targets.begin() + offsets[src];
+    auto last = targets.begin() + offsets[src + 1];
+    auto found = std::lower_bound(first, last, dst);
+    return found != last && *found == dst ? found - targets.begin() : no_edge;
+}
+
+void SparseGraph::update_all(float coefficient) {
+    kernels::evaporate(pheromones.data(), pheromones.size(), coefficient, initial_pheromone);
+}
+
+std::int64_t SparseGraph::path_length(const Path& path, int missing_edge_cost) const {
+    std::int64_t result = 0;
+    for (std::size_t i = 0; i < path.size(); ++i) {
+        auto edge = find_edge(path[i], path[(i + 1) % path.size()]);
+        result += edge == no_edge ? missing_edge_cost : costs[edge];
+    }
+    return result;
+}
+
+std::size_t SparseGraph::missing_edges(const Path& path) const {
+    std::size_t result = 0;
+    for (std::size_t i = 0; i < path.size(); ++i) {
+        result += find_edge(path[i], path[(i + 1) % path.size()]) == no_edge;
+    }
+    return result;
+}
+
+Footprint SparseGraph::get_footprint() const {
+    Footprint result;
+    result.add("graph offsets", Footprint::capacity_bytes(offsets));
+    result.add("graph targets", Footprint::capacity_bytes(targets));
+    result.add("graph costs", Footprint::capacity_bytes(costs));
+    result.add("graph pheromones", Footprint::capacity_bytes(pheromones));
+    return result;
+}
+
+void SparseGraph::validate_node(Index node) const {
+    if (node >= nodes) {
+        std::cerr << "aco::SparseGraph invalid node. Graph size: " << nodes << ", node: " << node
+                  << "\n";
+        throw std::invalid_argument("aco::SparseGraph invalid node!");
+    }
+}
+
+} // namespace aco
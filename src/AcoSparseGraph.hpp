@@ -0,0 +1,94 @@
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "AcoFootprint.hpp"
+#include "AcoGraph.hpp"
+#include "HugePageAllocator.hpp"
+
+#ifndef ACO_SPARSE_GRAPH_HPP
+#define ACO_SPARSE_GRAPH_HPP
+
+namespace aco {
+
+// Directed graph with only some of the edges present, e.g. a road network, stored in the CSR
+// (compressed sparse row) form: outgoing edges of all nodes one after the other, sorted by source
+// and then by target, with costs and pheromones per edge. Memory is linear in the number of edges,
+// unlike Graph, which is always complete.
+// Edges are addressed by their position in the CSR arrays. Per edge accessors don't validate it,
+// they are meant to be used in hot loops, the other functions throw std::invalid_argument on
+// invalid nodes, like Graph.
+// It is not possible to go under initial pheromone level, the same as in Graph.
+class SparseGraph {
+  public:
+    using Index = Graph::Index;
+    using Path  = Graph::Path;
+
+    struct Edge {
+        Index src;
+        Index dst;
+        int   cost;
+    };
+
+    // Returned by find_edge() if there's no such edge
+    static constexpr std::size_t no_edge = std::numeric_limits<std::size_t>::max();
+
+  public:
+    // A two-way road needs an edge in both directions. Throws std::invalid_argument on an edge out
+    // of range, to self, with non-positive cost, or given twice.
+    explicit SparseGraph(std::size_t nodes, std::vector<Edge> edges, float initial_pheromone);
+
+    // The DIMACS shortest path format (.gr), as used by the road networks of the 9th DIMACS
+    // challenge: "p sp <nodes> <arcs>" followed by "a <src> <dst> <cost>" lines, with nodes
+    // numbered from 1, and "c" comment lines. Arcs given more than once keep the cheapest cost.
+    // Throws std::invalid_argument on invalid input.
+    static SparseGraph from_dimacs(const std::string& string, float initial_pheromone);
+
+  public:
+    std::size_t get_size() const { return nodes; }
+    std::size_t get_edge_count() const { return targets.size(); }
+
+    // Outgoing edges of 'src' are [edges_begin(src), edges_end(src))
+    std::size_t edges_begin(Index src) const { return offsets[src]; }
+    std::size_t edges_end(Index src) const { return offsets[src + 1]; }
+
+    Index get_target(std::size_t edge) const { return targets[edge]; }
+    int   get_cost(std::size_t edge) const { return costs[edge]; }
+    float get_pheromone(std::size_t edge) const { return pheromones[edge]; }
+
+    // The edge from 'src' to 'dst', or no_edge. O(log degree).
+    std::size_t find_edge(Index src, Index dst) const;
+
+    // Evaporate all edges by the coefficient, pheromones don't go under the initial level
+    void update_all(float coefficient);
+
+    // Deposit on a single edge
+    void add_pheromone(std::size_t edge, float amount) { pheromones[edge] += amount; }
+
+    // Length of the round trip, where every pair of consecutive nodes without an edge costs
+    // 'missing_edge_cost'. Throws std::invalid_argument on an index out of range.
+    std::int64_t path_length(const Path& path, int missing_edge_cost) const;
+
+    // The number of pairs of consecutive nodes without an edge, zero for a feasible tour
+    std::size_t missing_edges(const Path& path) const;
+
+    // Memory of the CSR arrays, including the reserved capacity
+    Footprint get_footprint() const;
+
+  private:
+    void validate_node(Index node) const;
+
+  private:
+    std::size_t                       nodes;
+    std::vector<std::size_t>          offsets; // nodes + 1, the first edge of every node
+    utils::LargeVector<std::uint32_t> targets;
+    utils::LargeVector<int>           costs;
+    utils::LargeVector<float>         pheromones;
+    float                             initial_pheromone;
+};
+
+} // namespace aco
+
+#endif // ACO_SPARSE_GRAPH_HPP
@@ -0,0 +1,213 @@
+#include "AcoSpatialIndex.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+
+#include "ThreadPool.hpp"
+
+namespace aco {
+
+// Points per task when building neighbour lists in parallel
+static constexpr std::size_t points_per_task = 1024;
+
+static double coordinate(const Point& point, int axis) {
+    return axis == 0 ? point.x : point.y;
+}
+
+static double distance_squared(const Point& a, const Point& b) {
+    auto dx = a.x - b.x;
+    auto dy = a.y - b.y;
+    return dx * dx + dy * dy;
+}
+
+SpatialIndex::SpatialIndex(std::vector<Point> points_arg)
+    : points(std::move(points_arg)), tree_points(), tree_indices(points.size()),
+      split_axis(points.size()) {
+    std::iota(begin(tree_indices), end(tree_indices), 0);
+    build(0, points.size());
+
+    tree_points.reserve(points.size());
+    for (auto index : tree_indices) {
+        tree_points.push_back(points[index]);
+    }
+}
+
+const Point& SpatialIndex::get_point(Index index) const {
+    validate_index(index);
+    return points[index];
+}
+
+std::vector<SpatialIndex::Index> SpatialIndex::nearest(Index index, std::size_t k) const {
+    validate_index(index);
+
+    std::vector<Candidate> heap;
+    heap.reserve(k + 1);
+    search_nearest(points[index], index, k, 0, points.size(), heap);
+
+    // The heap keeps the farthest candidate on top, sort it back to increasing distance
+    std::sort_heap(begin(heap), end(heap), [](const Candidate& a, const Candidate& b) {
+        return a.distance < b.distance || (a.distance == b.distance && a.index < b.index);
+    });
+
+    std::vector<Index> result(heap.size());
+    std::transform(begin(heap), end(heap), begin(result), [](const auto& c) { return c.index; });
+    return result;
+}
+
+std::vector<SpatialIndex::Index> SpatialIndex::neighbour_lists(std::size_t k,
+                                                               std::size_t threads) const {
+    auto size = get_size();
+    k = std::min(k, size == 0 ? 0 : size - 1);
+    std::vector<Index> result(size * k);
+
+    // Every task fills its own part of the result, no synchronization needed
+    auto fill = [&](std::size_t first, std::size_t last) {
+        for (auto i = first; i < last; ++i) {
+            auto neighbours = nearest(i, k);
+            std::copy(begin(neighbours), end(neighbours), begin(result) + i * k);
+        }
+    };
+
+    if (size <= points_per_task || threads == 1) {
+        fill(0, size);
+        return result;
+    }
+
+    utils::ThreadPool pool(threads);
+    for (std::size_t first = 0; first < size; first += points_per_task) {
+        auto last = std::min(size, first + points_per_task);
+        pool.submit([&fill, first, last](std::size_t) { fill(first, last); });
+    }
+    pool.wait();
+
+    return result;
+}
+
+std::vector<SpatialIndex::Index> SpatialIndex::within_radius(const Point& center,
+                                                             double       radius) const {
+    std::vector<Index> result;
+    if (radius >= 0) {
+        search_radius(center, radius * radius, 0, points.size(), result);
+    }
+
+    std::sort(begin(result), end(result));
+    return result;
+}
+
+std::vector<SpatialIndex::Index> SpatialIndex::within_radius(Index index, double radius) const {
+    validate_index(index);
+
+    auto result = within_radius(points[index], radius);
+    result.erase(std::remove(begin(result), end(result), index), end(result));
+    return result;
+}
+
+// Split on the median along the axis with the bigger spread, so that clustered instances still get
+// a balanced tree
+void SpatialIndex::build(std::size_t first, std::size_t last) {
+    if (last - first <= 1) {
+        return;
+    }
+
+    // Step 1: choose the axis
+    auto [min_x, max_x] = std::minmax_element(
+        begin(tree_indices) + first, begin(tree_indices) + last,
+        [&](Index a, Index b) { return points[a].x < points[b].x; });
+    auto [min_y, max_y] = std::minmax_element(
+        begin(tree_indices) + first, begin(tree_indices) + last,
+        [&](Index a, Index b) { return points[a].y < points[b].y; });
+    int axis = points[*max_x].x - points[*min_x].x >= points[*max_y].y - points[*min_y].y ? 0 : 1;
+
+    // Step 2: partition around the median
+    auto middle = first + (last - first) / 2;
+    std::nth_element(begin(tree_indices) + first, begin(tree_indices) + middle,
+                     begin(tree_indices) + last, [&](Index a, Index b) {
+                         return coordinate(points[a], axis) < coordinate(points[b], axis);
+                     });
+    split_axis[middle] = static_cast<char>(axis);
+
+    // Step 3: subtrees
+    build(first, middle);
+    build(middle + 1, last);
+}
+
+// Bounded max-heap of the best candidates so far. The far half of a range is visited only if the
+// splitting line is not farther than the worst candidate (ties included, to keep the ordering by
+// index exact).
+void SpatialIndex::search_nearest(const Point& center, Index skip, std::size_t k,
+                                  std::size_t first, std::size_t last,
+                                  std::vector<Candidate>& heap) const {
+    if (first >= last || k == 0) {
+        return;
+    }
+
+    auto closer = [](const Candidate& a, const Candidate& b) {
+        return a.distance < b.distance || (a.distance == b.distance && a.index < b.index);
+    };
+
+    auto middle = first + (last - first) / 2;
+    auto index = tree_indices[middle];
+    if (index != skip) {
+        Candidate candidate{distance_squared(center, tree_points[middle]), index};
+        if (heap.size() < k) {
+            heap.push_back(candidate);
+            std::push_heap(begin(heap), end(heap), closer);
+        } else if (closer(candidate, heap.front())) {
+            std::pop_heap(begin(heap), end(heap), closer);
+            heap.back() = candidate;
+            std::push_heap(begin(heap), end(heap), closer);
+        }
+    }
+
+    auto axis = split_axis[middle];
+    auto offset = coordinate(center, axis) - coordinate(tree_points[middle], axis);
+    bool left_first = offset < 0;
+
+    // Near half first, it most likely shrinks the search radius
+    if (left_first) {
+        search_nearest(center, skip, k, first, middle, heap);
+    } else {
+        search_nearest(center, skip, k, middle + 1, last, heap);
+    }
+
+    if (heap.size() < k || offset * offset <= heap.front().distance) {
+        if (left_first) {
+            search_nearest(center, skip, k, middle + 1, last, heap);
+        } else {
+            search_nearest(center, skip, k, first, middle, heap);
+        }
+    }
+}
+
+void SpatialIndex::search_radius(const Point& center, double radius_squared, std::size_t first,
+                                 std::size_t last, std::vector<Index>& result) const {
+    if (first >= last) {
+        return;
+    }
+
+    auto middle = first + (last - first) / 2;
+    if (distance_squared(center, tree_points[middle]) <= radius_squared) {
+        result.push_back(tree_indices[middle]);
+    }
+
+    auto axis = split_axis[middle];
+    auto offset = coordinate(center, axis) - coordinate(tree_points[middle], axis);
+    if (offset <= 0 || offset * offset <= radius_squared) {
+        search_radius(center, radius_squared, first, middle, result);
+    }
+    if (offset >= 0 || offset * offset <= radius_squared) {
+        search_radius(center, radius_squared, middle + 1, last, result);
+    }
+}
+
+void SpatialIndex::validate_index(Index index) const {
+    if (index >= points.size()) {
+        std::cerr << "aco::SpatialIndex index out of range. Size: " << points.size()
+                  << ", index: " << index << std::endl;
+        throw std::invalid_argument("aco::SpatialIndex index out of range!");
+    }
+}
+
+} // namespace aco
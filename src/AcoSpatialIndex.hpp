@@ -0,0 +1,72 @@
+#include <cstddef>
+#include <vector>
+
+#ifndef ACO_SPATIAL_INDEX_HPP
+#define ACO_SPATIAL_INDEX_HPP
+
+namespace aco {
+
+// City location, for instances defined by coordinates
+struct Point {
+    double x;
+    double y;
+};
+
+// Static 2D k-d tree over a set of points, for building nearest-neighbour candidate lists and for
+// fixed-radius queries, without comparing every pair of points.
+// Points are referred to by their index in the input vector, which is also their node index in a
+// graph created from the same points (see Graph::from_points).
+// The tree is immutable after construction, so concurrent queries are safe.
+class SpatialIndex {
+  public:
+    using Index = std::size_t;
+
+  public:
+    // Build the tree in O(n log n).
+    explicit SpatialIndex(std::vector<Point> points);
+
+  public:
+    std::size_t  get_size() const { return points.size(); }
+    const Point& get_point(Index index) const;
+
+    // Up to 'k' points nearest to the given one (excluding itself), sorted by increasing distance.
+    // Points at the same distance are ordered by index, so the result is deterministic.
+    // Throws std::invalid_argument on index out of range.
+    std::vector<Index> nearest(Index index, std::size_t k) const;
+
+    // Nearest neighbours of every point, as a flat buffer of min(k, get_size() - 1) indices per
+    // point, in the order of nearest(). Points are split between 'threads' workers (zero means one
+    // per hardware thread).
+    std::vector<Index> neighbour_lists(std::size_t k, std::size_t threads = 0) const;
+
+    // All points within 'radius' (inclusive) from the center, sorted by index. The variant taking
+    // an index excludes the point itself and throws std::invalid_argument on index out of range.
+    std::vector<Index> within_radius(const Point& center, double radius) const;
+    std::vector<Index> within_radius(Index index, double radius) const;
+
+  private:
+    struct Candidate {
+        double distance; // Squared
+        Index  index;
+    };
+
+    void build(std::size_t first, std::size_t last);
+    void search_nearest(const Point& center, Index skip, std::size_t k, std::size_t first,
+                        std::size_t last, std::vector<Candidate>& heap) const;
+    void search_radius(const Point& center, double radius_squared, std::size_t first,
+                       std::size_t last, std::vector<Index>& result) const;
+    void validate_index(Index index) const;
+
+  private:
+    std::vector<Point> points; // In the input order
+
+    // Implicit tree: the median of every range is the node, both halves are its subtrees. Points
+    // are stored in tree order, so that subtrees are contiguous in memory.
+    std::vector<Point> tree_points;
+    std::vector<Index> tree_indices;
+    std::vector<char>  split_axis; // 0 for x, 1 for y, per tree position
+};
+
+} // namespace aco
+
+#endif // ACO_SPATIAL_INDEX_HPP
@@ -0,0 +1,100 @@
+#include "AcoTourBuilder.hpp"
+
+#include "Utils.hpp"
+
+namespace aco {
+
+TourBuilder::TourBuilder(std::size_t nodes) : visited(nodes), scores(nodes) {}
+
+void TourBuilder::build(const ChoiceInfo& choice_info, Graph::Index start, std::mt19937& gen,
+                        Path& path) {
+    path.resize(choice_info.get_size());
+    build(choice_info, start, gen, path.data());
+}
+
+void TourBuilder::build(const ChoiceInfo& choice_info, Graph::Index start, std::mt19937& gen,
+                        Graph::Index* path) {
+    build_tour(choice_info, nullptr, nullptr, 0, start, gen, path);
+}
+
+bool TourBuilder::build_bounded(const ChoiceInfo& choice_info, const Graph& graph,
+                                const std::vector<int>& nearest_costs, std::int64_t limit,
+                                Graph::Index start, std::mt19937& gen, Graph::Index* path) {
+    return build_tour(choice_info, &graph, nearest_costs.data(), limit, start, gen, path);
+}
+
+bool TourBuilder::build_tour(const ChoiceInfo& choice_info, const Graph* graph,
+                             const int* nearest_costs, std::int64_t limit, Graph::Index start,
+                             std::mt19937& gen, Graph::Index* path) {
+    const auto cities = choice_info.get_size();
+    visited.assign(cities, 0);
+    scores.resize(cities);
+
+    path[0] = start;
+    visited[start] = 1;
+
+    // Cost of the partial tour, and the lower bound of the rest. Every city is left once, so the
+    // bound is the sum of the cheapest edges leaving the cities which are not left yet.
+    std::int64_t length = 0;
+    std::int64_t bound = 0;
+    if (graph != nullptr) {
+        for (std::size_t i = 0; i < cities; ++i) {
+            bound += nearest_costs[i];
+        }
+    }
+
+    // Choose one new destination in every iteration
+    bool exact = false;
+    for (std::size_t step = 1; step < cities; ++step) {
+        auto current_city = path[step - 1];
+        auto target = cities; // Not found yet
+
+        if (!exact) {
+            for (int i = 0; i < max_rejections; ++i) {
+                auto candidate = choice_info.sample(current_city, gen);
+                if (!visited[candidate]) {
+                    target = candidate;
+                    break;
+                }
+            }
+
+            // Most of the score is already taken by visited cities, sampling is not worth it
+            // anymore
+            exact = target == cities;
+        }
+
+        if (exact) {
+            target = choose_exact(choice_info, current_city, gen);
+        }
+
+        visited[target] = 1;
+        path[step] = target;
+
+        if (graph != nullptr) {
+            length += graph->get_cost(current_city, target);
+            bound -= nearest_costs[current_city];
+            if (length + bound > limit) {
+                return false;
+            }
+        }
+    }
+
+    // The way back, a complete tour is never longer than the limit
+    return graph == nullptr || length + graph->get_cost(path[cities - 1], start) <= limit;
+}
+
+Graph::Index TourBuilder::choose_exact(const ChoiceInfo& choice_info, Graph::Index current,
+                                       std::mt19937& gen) {
+    // Calculate the score (desire to go) for every city. Already visited ones get a score of zero.
+    choice_info.load_row(current, scores.data());
+    for (std::size_t j = 0; j < scores.size(); ++j) {
+        if (visited[j]) {
+            scores[j] = 0.f;
+        }
+    }
+
+    // Choose the target city using roullette random algorithm
+    return utils::roullette(scores, gen);
+}
+
+} // namespace aco
@@ -0,0 +1,63 @@
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "AcoChoiceInfo.hpp"
+#include "AcoGraph.hpp"
+
+#ifndef ACO_TOUR_BUILDER_HPP
+#define ACO_TOUR_BUILDER_HPP
+
+namespace aco {
+
+// Constructs ant tours using precomputed choice info.
+// Early in the tour almost all cities are unvisited, so the next city is drawn from the cumulative
+// row of the choice info and rejected if it was already visited. Once the rejections get too
+// frequent, the ant switches to the exact scan over unvisited cities for the rest of its tour.
+// Both methods choose the next city with the same probabilities.
+// Holds the workspace of a single ant, so it should be reused between ants and iterations.
+class TourBuilder {
+  public:
+    using Path = Graph::Path;
+
+    // The number of rejected draws in a single step, after which the ant switches to the exact scan
+    static constexpr int max_rejections = 4;
+
+  public:
+    explicit TourBuilder(std::size_t nodes = 0);
+
+  public:
+    // Build a full tour starting from the 'start' city. The result is written to 'path'.
+    void build(const ChoiceInfo& choice_info, Graph::Index start, std::mt19937& gen, Path& path);
+
+    // Same as above, but writes to a preallocated buffer of choice_info.get_size() elements, e.g. a
+    // slot in a flat buffer holding the tours of all ants.
+    void build(const ChoiceInfo& choice_info, Graph::Index start, std::mt19937& gen,
+               Graph::Index* path);
+
+    // Same as above, but the ant gives up once the cost of its partial tour plus a lower bound of
+    // the rest exceeds 'limit'. The bound is the cheapest edge leaving every city that still has
+    // to be left: the current one and the unvisited ones ('nearest_costs', see
+    // Graph::nearest_costs). Returns false if the ant gave up, 'path' is incomplete then, or if the
+    // complete tour is longer than 'limit'.
+    bool build_bounded(const ChoiceInfo& choice_info, const Graph& graph,
+                       const std::vector<int>& nearest_costs, std::int64_t limit,
+                       Graph::Index start, std::mt19937& gen, Graph::Index* path);
+
+  private:
+    // With 'graph' null, the tour is not bounded
+    bool build_tour(const ChoiceInfo& choice_info, const Graph* graph, const int* nearest_costs,
+                    std::int64_t limit, Graph::Index start, std::mt19937& gen, Graph::Index* path);
+
+    Graph::Index choose_exact(const ChoiceInfo& choice_info, Graph::Index current,
+                              std::mt19937& gen);
+
+  private:
+    std::vector<char>  visited;
+    std::vector<float> scores;
+};
+
+} // namespace aco
+
+#endif // ACO_TOUR_BUILDER_HPP
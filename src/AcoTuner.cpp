@@ -0,0 +1,195 @@
+#include "AcoTuner.hpp"
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+#include "../third_party/nlohmann/json.hpp"
+#include "AcoSolver.hpp"
+
+namespace aco {
+
+static std::string device_name(DeviceType device) {
+    std::ostringstream out;
+    out << device;
+    return out.str();
+}
+
+static DeviceType parse_device(const std::string& name) {
+    for (auto device :
+         {DeviceType::CPU, DeviceType::GPU, DeviceType::CPU_NUMA, DeviceType::CPU_ASYNC,
+          DeviceType::CPU_PIPELINED, DeviceType::CPU_SIMD, DeviceType::CPU_SMALL}) {
+        if (device_name(device) == name) {
+            return device;
+        }
+    }
+
+    std::cerr << "aco::Profile unknown device: " << name << "\n";
+    throw std::invalid_argument("aco::Profile unknown device!");
+}
+
+// Single line summary of the tuned parameters
+static std::string describe(const Profile& profile) {
+    std::ostringstream out;
+    out << "agents per node: " << profile.agents_per_node << ", threads: " << profile.threads
+        << ", evaporation: " << profile.pheromone_evaporation << ", alpha: " << profile.alpha
+        << ", beta: " << profile.beta;
+    return out.str();
+}
+
+Algorithm::Config Profile::make_config(std::size_t nodes_arg) const {
+    Algorithm::Config config{nodes_arg * agents_per_node, pheromone_evaporation};
+    config.threads = threads;
+    config.alpha = alpha;
+    config.beta = beta;
+    return config;
+}
+
+std::string Profile::to_string() const {
+    auto json = nlohmann::json{{"device", device_name(device)},
+                               {"nodes", nodes},
+                               {"agents_per_node", agents_per_node},
+                               {"threads", threads},
+                               {"pheromone_evaporation", pheromone_evaporation},
+                               {"alpha", alpha},
+                               {"beta", beta}};
+    return json.dump(/*indent=*/4);
+}
+
+Profile Profile::from_string(const std::string& string) {
+    try {
+        nlohmann::json json = nlohmann::json::parse(string);
+        Profile        profile;
+        profile.device = parse_device(json.at("device").get<std::string>());
+        profile.nodes = json.at("nodes").get<std::size_t>();
+        profile.agents_per_node = json.at("agents_per_node").get<std::size_t>();
+        profile.threads = json.at("threads").get<std::size_t>();
+        profile.pheromone_evaporation = json.at("pheromone_evaporation").get<float>();
+        profile.alpha = json.at("alpha").get<float>();
+        profile.beta = json.at("beta").get<float>();
+        return profile;
+    } catch (const nlohmann::detail::exception& e) {
+        // Hide implementation details (exceptions from json library), throw a generic one.
+        std::cerr << "Exception thrown in profile deserialization! What: " << e.what() << "\n";
+        throw std::invalid_argument("Exception thrown in profile deserialization!");
+    }
+}
+
+Tuner::Tuner(Config config_arg) : config(config_arg) {
+    const auto& space = config.space;
+    if (space.agents_per_node.empty() || space.threads.empty() ||
+        space.pheromone_evaporation.empty() || space.alpha.empty() || space.beta.empty()) {
+        std::cerr << "aco::Tuner invalid argument. Every dimension of the space needs a value!\n";
+        throw std::invalid_argument("aco::Tuner empty space dimension!");
+    }
+    if (config.budget.count() <= 0) {
+        std::cerr << "aco::Tuner invalid argument. Budget should be positive!\n";
+        throw std::invalid_argument("aco::Tuner invalid budget argument!");
+    }
+}
+
+Profile Tuner::tune(const std::vector<Graph>& instances, std::ostream& log) {
+    if (instances.empty()) {
+        std::cerr << "aco::Tuner invalid argument. At least one instance is required!\n";
+        throw std::invalid_argument("aco::Tuner no instances!");
+    }
+
+    // Step 1: the grid of candidates. The profile describes the size of the first instance.
+    auto candidates = make_candidates(instances.front().get_size());
+
+    // Step 2: slices, such that every round takes about the budget divided by the number of rounds
+    std::size_t rounds = 0;
+    while ((std::size_t(1) << rounds) < candidates.size()) {
+        ++rounds;
+    }
+    long trials = std::max<std::size_t>(1, rounds) * candidates.size() * instances.size();
+    auto slice = std::max(std::chrono::milliseconds(1), config.budget / trials);
+
+    // Step 3: the race
+    auto race_begin = std::chrono::steady_clock::now();
+    for (std::size_t round = 0; round < rounds; ++round) {
+        log << "Round " << round + 1 << ": " << candidates.size()
+            << " candidates, slice: " << slice.count() << " ms\n";
+        run_round(candidates, instances, slice);
+
+        std::stable_sort(begin(candidates), end(candidates),
+                         [](const Candidate& a, const Candidate& b) { return a.score < b.score; });
+        log << "Leader: " << describe(candidates.front().profile)
+            << ", score: " << candidates.front().score << "\n";
+
+        if (std::chrono::steady_clock::now() - race_begin >= config.budget) {
+            log << "Budget spent\n";
+            break;
+        }
+
+        // Survivors get twice as much time per trial
+        candidates.resize((candidates.size() + 1) / 2);
+        slice *= 2;
+    }
+
+    return candidates.front().profile;
+}
+
+std::vector<Tuner::Candidate> Tuner::make_candidates(std::size_t nodes) const {
+    const auto&            space = config.space;
+    std::vector<Candidate> candidates;
+    for (auto agents_per_node : space.agents_per_node) {
+        for (auto threads : space.threads) {
+            for (auto evaporation : space.pheromone_evaporation) {
+                for (auto alpha : space.alpha) {
+                    for (auto beta : space.beta) {
+                        Profile profile{config.device, nodes, agents_per_node, threads,
+                                        evaporation, alpha, beta};
+                        candidates.push_back({profile, 0.0});
+                    }
+                }
+            }
+        }
+    }
+
+    return candidates;
+}
+
+void Tuner::run_round(std::vector<Candidate>& candidates, const std::vector<Graph>& instances,
+                      std::chrono::milliseconds slice) const {
+    using clock = std::chrono::steady_clock;
+
+    // lengths[candidate][instance], and the overrun factor of every candidate
+    std::vector<std::vector<std::int64_t>> lengths(candidates.size(),
+                                                   std::vector<std::int64_t>(instances.size()));
+    std::vector<double>                    overruns(candidates.size(), 0.0);
+    for (std::size_t c = 0; c < candidates.size(); ++c) {
+        for (std::size_t i = 0; i < instances.size(); ++i) {
+            // Construction is part of the trial, it's not free on every device
+            auto         trial_begin = clock::now();
+            std::mt19937 gen(config.seed + i);
+            auto         algorithm = Algorithm::make(
+                config.device, gen, instances[i],
+                candidates[c].profile.make_config(instances[i].get_size()));
+
+            Solver::StopCriteria criteria;
+            criteria.time_limit = slice;
+            Solver solver(*algorithm, criteria);
+            lengths[c][i] = solver.run().length;
+
+            std::chrono::duration<double, std::milli> elapsed = clock::now() - trial_begin;
+            overruns[c] += std::max(1.0, elapsed.count() / slice.count());
+        }
+    }
+
+    // Lengths are made comparable between instances, relative to the best one of the round
+    for (std::size_t c = 0; c < candidates.size(); ++c) {
+        double relative = 0;
+        for (std::size_t i = 0; i < instances.size(); ++i) {
+            auto best = lengths[0][i];
+            for (const auto& candidate_lengths : lengths) {
+                best = std::min(best, candidate_lengths[i]);
+            }
+            relative += double(lengths[c][i]) / best;
+        }
+        candidates[c].score = relative / instances.size() * (overruns[c] / instances.size());
+    }
+}
+
+} // namespace aco
@@ -0,0 +1,92 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "AcoAlgorithm.hpp"
+#include "AcoGraph.hpp"
+
+#ifndef ACO_TUNER_HPP
+#define ACO_TUNER_HPP
+
+namespace aco {
+
+// Tuned algorithm parameters for a class of instances (e.g. graphs of about the same size), which
+// can be saved and loaded as JSON, e.g.:
+//     {"device":"CPU","nodes":64,"agents_per_node":4,"threads":0,"pheromone_evaporation":0.9,
+//      "alpha":1.0,"beta":2.0}
+struct Profile {
+    DeviceType  device;
+    std::size_t nodes; // Size of the instances it was tuned on
+    std::size_t agents_per_node;
+    std::size_t threads;
+    float       pheromone_evaporation;
+    float       alpha;
+    float       beta;
+
+    // Algorithm configuration for an instance of the given size
+    Algorithm::Config make_config(std::size_t nodes) const;
+
+    std::string to_string() const;
+
+    // Throws std::invalid_argument on invalid input
+    static Profile from_string(const std::string& string);
+};
+
+// Searches for the algorithm parameters giving the best tours per wall-clock second, on a set of
+// sample instances of a class. Candidates form a grid, which is raced (successive halving):
+// - every candidate solves every instance within the same time slice, with the same random seeds,
+// - a candidate scores the average of its lengths relative to the best length of the instance in
+//   this round, multiplied by how much it overran the slice (e.g. a single iteration of many
+//   agents may take longer than the slice),
+// - the better half goes to the next round, with twice as long slices.
+// The race ends once a single candidate is left, or the time budget is spent. Slices are chosen so
+// that every round takes about the same time, and all rounds fit in the budget.
+class Tuner {
+  public:
+    // Values to try, candidates are all their combinations
+    struct Space {
+        std::vector<std::size_t> agents_per_node = {1, 4, 16};
+        std::vector<std::size_t> threads = {0};
+        std::vector<float>       pheromone_evaporation = {0.5, 0.9};
+        std::vector<float>       alpha = {1};
+        std::vector<float>       beta = {1, 2, 4};
+    };
+
+    struct Config {
+        DeviceType                device;
+        Space                     space;
+        std::chrono::milliseconds budget; // Wall-clock time of the whole race
+        std::uint32_t             seed;   // Instance i is solved with a generator seeded seed + i
+    };
+
+  public:
+    // Throws std::invalid_argument on invalid configuration.
+    explicit Tuner(Config config);
+
+  public:
+    // Race the candidates on the given instances, report progress to 'log'. Throws
+    // std::invalid_argument if there are no instances.
+    Profile tune(const std::vector<Graph>& instances, std::ostream& log);
+
+  private:
+    struct Candidate {
+        Profile profile;
+        double  score;
+    };
+
+    std::vector<Candidate> make_candidates(std::size_t nodes) const;
+
+    // Solve every instance with every candidate within the slice, update their scores
+    void run_round(std::vector<Candidate>& candidates, const std::vector<Graph>& instances,
+                   std::chrono::milliseconds slice) const;
+
+  private:
+    Config config;
+};
+
+} // namespace aco
+
+#endif // ACO_TUNER_HPP
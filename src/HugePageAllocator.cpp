@@ -0,0 +1,134 @@
+#include "HugePageAllocator.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+
+// Explicit huge pages of huge_page_size, not of the system default size (which may be 1 GiB, or
+// 512 MiB on arm64 with 64 KiB base pages). The C library may only define the shift.
+#if !defined(MAP_HUGE_2MB) && defined(MAP_HUGE_SHIFT)
+#define MAP_HUGE_2MB (21 << MAP_HUGE_SHIFT)
+#endif
+static_assert(utils::huge_page_size == std::size_t(1) << 21, "MAP_HUGE_2MB is used");
+#endif
+
+namespace utils {
+
+static std::atomic<HugePages> policy{HugePages::Explicit};
+
+static std::atomic<std::size_t> explicit_bytes{0};
+static std::atomic<std::size_t> transparent_bytes{0};
+static std::atomic<std::size_t> normal_bytes{0};
+
+static std::size_t round_up(std::size_t value, std::size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+std::ostream& operator<<(std::ostream& out, HugePages huge_pages) {
+    switch (huge_pages) {
+    case HugePages::Off:
+        out << "off";
+        return out;
+    case HugePages::Transparent:
+        out << "transparent";
+        return out;
+    case HugePages::Explicit:
+        out << "explicit";
+        return out;
+    }
+
+    out << "unknown";
+    return out;
+}
+
+void set_huge_pages(HugePages policy_arg) {
+    policy = policy_arg;
+}
+
+HugePages get_huge_pages() {
+    return policy;
+}
+
+HugePageStatistics get_huge_page_statistics() {
+    return {explicit_bytes, transparent_bytes, normal_bytes};
+}
+
+#ifdef __linux__
+void* allocate_large(std::size_t bytes) {
+    if (bytes < huge_page_size) {
+        return ::operator new(round_up(bytes, cache_line_size), std::align_val_t(cache_line_size));
+    }
+
+    // Step 1: explicit huge pages, the mapping is aligned to them. Without a way to ask for their
+    // size, the transparent ones below are used instead.
+    auto size = round_up(bytes, huge_page_size);
+    auto current_policy = get_huge_pages();
+#ifdef MAP_HUGE_2MB
+    if (current_policy == HugePages::Explicit) {
+        auto* pointer = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_HUGE_2MB, -1, 0);
+        if (pointer != MAP_FAILED) {
+            explicit_bytes += size;
+            return pointer;
+        }
+    }
+#endif
+
+    // Step 2: normal pages. A huge page can only back an aligned range, so one more page is mapped
+    // and the ends are cut off.
+    auto* mapping = mmap(nullptr, size + huge_page_size, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    auto begin = reinterpret_cast<std::uintptr_t>(mapping);
+    auto aligned = round_up(begin, huge_page_size);
+    if (aligned > begin) {
+        munmap(mapping, aligned - begin);
+    }
+    munmap(reinterpret_cast<void*>(aligned + size), begin + huge_page_size - aligned);
+    auto* pointer = reinterpret_cast<void*>(aligned);
+
+    // Step 3: the advice, failing is not an error
+    if (current_policy == HugePages::Off) {
+        madvise(pointer, size, MADV_NOHUGEPAGE);
+        normal_bytes += size;
+    } else if (madvise(pointer, size, MADV_HUGEPAGE) == 0) {
+        transparent_bytes += size;
+    } else {
+        normal_bytes += size;
+    }
+    return pointer;
+}
+
+void deallocate_large(void* pointer, std::size_t bytes) noexcept {
+    if (bytes < huge_page_size) {
+        ::operator delete(pointer, std::align_val_t(cache_line_size));
+        return;
+    }
+    munmap(pointer, round_up(bytes, huge_page_size));
+}
+
+std::size_t allocation_size(std::size_t bytes) {
+    return round_up(bytes, bytes < huge_page_size ? cache_line_size : huge_page_size);
+}
+#else
+// No control over pages, only the alignment
+void* allocate_large(std::size_t bytes) {
+    normal_bytes += bytes < huge_page_size ? 0 : bytes;
+    return ::operator new(round_up(bytes, cache_line_size), std::align_val_t(cache_line_size));
+}
+
+void deallocate_large(void* pointer, std::size_t) noexcept {
+    ::operator delete(pointer, std::align_val_t(cache_line_size));
+}
+
+std::size_t allocation_size(std::size_t bytes) {
+    return round_up(bytes, cache_line_size);
+}
+#endif
+
+} // namespace utils
@@ -0,0 +1,77 @@
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+#ifndef HUGE_PAGE_ALLOCATOR_HPP
+#define HUGE_PAGE_ALLOCATOR_HPP
+
+namespace utils {
+
+constexpr std::size_t cache_line_size = 64;
+constexpr std::size_t huge_page_size = std::size_t(2) << 20;
+
+// Page size policy of large allocations (at least huge_page_size), process-wide:
+// - Explicit: 2 MiB pages reserved in hugetlbfs (vm.nr_hugepages if that is the default size,
+//   otherwise /sys/kernel/mm/hugepages/hugepages-2048kB), if there are enough of them free,
+//   otherwise like Transparent,
+// - Transparent: normal pages, but the kernel is asked to back them with huge pages
+//   (madvise(MADV_HUGEPAGE)), which works unless transparent huge pages are disabled,
+// - Off: normal pages, even if transparent huge pages are enabled for all memory.
+enum class HugePages { Off, Transparent, Explicit };
+
+std::ostream& operator<<(std::ostream&, HugePages);
+
+// Thread-safe. Applies to allocations made from now on, the default is Explicit.
+void      set_huge_pages(HugePages policy);
+HugePages get_huge_pages();
+
+// Bytes of large allocations so far, by the pages they got. Transparent means that the kernel
+// accepted the advice, not that it actually found free huge pages.
+struct HugePageStatistics {
+    std::size_t explicit_bytes;
+    std::size_t transparent_bytes;
+    std::size_t normal_bytes;
+};
+
+HugePageStatistics get_huge_page_statistics();
+
+// At least 'bytes', aligned to the cache line and padded to a multiple of it, so that a full SIMD
+// load at the end of the buffer stays within the allocation. Large allocations are aligned to and
+// padded to huge pages, according to the policy. Throws std::bad_alloc.
+void* allocate_large(std::size_t bytes);
+void  deallocate_large(void* pointer, std::size_t bytes) noexcept;
+
+// Memory taken by allocate_large(bytes), the padding included
+std::size_t allocation_size(std::size_t bytes);
+
+// Allocator for the big buffers of the solvers, like the pheromone and cost matrices. Their rows
+// are accessed in random order (a jump to another row on every step of an ant), so with normal
+// pages almost every access misses the TLB once the matrices reach a few megabytes.
+template <typename T> class HugePageAllocator {
+  public:
+    using value_type = T;
+
+    HugePageAllocator() noexcept = default;
+    template <typename U> HugePageAllocator(const HugePageAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t count) { return static_cast<T*>(allocate_large(count * sizeof(T))); }
+    void deallocate(T* pointer, std::size_t count) noexcept {
+        deallocate_large(pointer, count * sizeof(T));
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const HugePageAllocator<T>&, const HugePageAllocator<U>&) {
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const HugePageAllocator<T>&, const HugePageAllocator<U>&) {
+    return false;
+}
+
+template <typename T> using LargeVector = std::vector<T, HugePageAllocator<T>>;
+
+} // namespace utils
+
+#endif // HUGE_PAGE_ALLOCATOR_HPP
@@ -0,0 +1,77 @@
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include "HugePageAllocator.hpp"
+
+#ifndef RING_BUFFER_HPP
+#define RING_BUFFER_HPP
+
+namespace utils {
+
+// Lock-free bounded queue from a single producer thread to a single consumer thread. Neither side
+// ever waits: push fails when the queue is full and pop fails when it's empty. Capacity is rounded
+// up to a power of two. Positions of both sides are on separate cache lines, so that the producer
+// and the consumer don't invalidate each other's line on every operation.
+template <typename T> class RingBuffer final {
+  public:
+    explicit RingBuffer(std::size_t min_capacity) : buffer(round_up(min_capacity)) {}
+
+  public:
+    std::size_t capacity() const { return buffer.size(); }
+
+    // Producer side. Number of values that can be pushed for sure, the consumer may free more.
+    std::size_t free() const {
+        return capacity() - (producer_tail - published_head.load(std::memory_order_acquire));
+    }
+
+    // Producer side. Push all of the values, or none if they don't fit.
+    bool push(const T* values, std::size_t count) {
+        if (free() < count) {
+            return false;
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            buffer[(producer_tail + i) & (capacity() - 1)] = values[i];
+        }
+        producer_tail += count;
+        published_tail.store(producer_tail, std::memory_order_release);
+        return true;
+    }
+    bool push(const T& value) { return push(&value, 1); }
+
+    // Consumer side. Pop exactly 'count' values, or none if there are fewer.
+    bool pop(T* values, std::size_t count) {
+        if (published_tail.load(std::memory_order_acquire) - consumer_head < count) {
+            return false;
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            values[i] = buffer[(consumer_head + i) & (capacity() - 1)];
+        }
+        consumer_head += count;
+        published_head.store(consumer_head, std::memory_order_release);
+        return true;
+    }
+    bool pop(T& value) { return pop(&value, 1); }
+
+  private:
+    static std::size_t round_up(std::size_t value) {
+        std::size_t result = 1;
+        while (result < value) {
+            result *= 2;
+        }
+        return result;
+    }
+
+  private:
+    std::vector<T> buffer;
+
+    // Positions grow without wrapping around, indices are taken modulo capacity
+    alignas(cache_line_size) std::atomic<std::size_t> published_tail{0};
+    std::size_t producer_tail = 0; // Owned by the producer, the same as published_tail
+    alignas(cache_line_size) std::atomic<std::size_t> published_head{0};
+    std::size_t consumer_head = 0; // Owned by the consumer, the same as published_head
+};
+
+} // namespace utils
+
+#endif // RING_BUFFER_HPP
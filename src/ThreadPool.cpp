@@ -0,0 +1,132 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+namespace utils {
+
+// Identifies the pool and the worker index of the current thread
+static thread_local const ThreadPool* current_pool = nullptr;
+static thread_local std::size_t       current_worker = 0;
+
+ThreadPool::ThreadPool(std::size_t threads)
+    : queues(), workers(), queued(0), unfinished(0), error(), stopping(false), next_queue(0) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    for (std::size_t i = 0; i < threads; ++i) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    for (std::size_t i = 0; i < threads; ++i) {
+        workers.emplace_back([this, i] { worker_loop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&] { return unfinished == 0; });
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    if (error) {
+        std::cerr << "utils::ThreadPool destroyed with an unhandled task exception!\n";
+    }
+}
+
+void ThreadPool::submit(Task task) {
+    auto queue_index = current_pool == this ? current_worker : next_queue++ % queues.size();
+
+    // The counters are updated under the lock, so that a worker can't miss the notification, and
+    // before the task is queued, so that its worker can't decrement them first
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++queued;
+        ++unfinished;
+    }
+    {
+        auto&                       queue = *queues[queue_index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    wake.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&] { return unfinished == 0; });
+
+    if (error) {
+        auto result = error;
+        error = nullptr;
+        std::rethrow_exception(result);
+    }
+}
+
+void ThreadPool::worker_loop(std::size_t worker) {
+    current_pool = this;
+    current_worker = worker;
+
+    while (true) {
+        Task task;
+        if (pop(worker, task)) {
+            std::exception_ptr task_error;
+            try {
+                task(worker);
+            } catch (...) {
+                task_error = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (task_error && !error) {
+                error = task_error;
+            }
+            if (--unfinished == 0) {
+                done.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        wake.wait(lock, [&] { return stopping || queued > 0; });
+        if (stopping && queued == 0) {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::pop(std::size_t worker, Task& task) {
+    // Own queue first, newest task (it's likely to have its data still in cache)
+    {
+        auto&                       queue = *queues[worker];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            --queued;
+            return true;
+        }
+    }
+
+    // Steal the oldest task from other workers
+    for (std::size_t i = 1; i < queues.size(); ++i) {
+        auto&                       queue = *queues[(worker + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            --queued;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace utils
@@ -0,0 +1,71 @@
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+namespace utils {
+
+// Work-stealing thread pool. Every worker has its own queue of tasks: it takes the most recently
+// added tasks from its own queue, and when it runs out of them, steals the oldest ones from the
+// other workers. Tasks receive the index of the worker that runs them, which can be used to access
+// per-worker workspaces without synchronization.
+class ThreadPool final {
+  public:
+    using Task = std::function<void(std::size_t worker)>;
+
+  public:
+    // Zero threads means one per hardware thread.
+    explicit ThreadPool(std::size_t threads = 0);
+
+    // Waits for all submitted tasks to finish.
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+  public:
+    std::size_t size() const { return workers.size(); }
+
+    // Thread-safe. When called from a worker, the task goes to that worker's queue.
+    void submit(Task task);
+
+    // Block until all submitted tasks are finished. Rethrows the first exception thrown by a task
+    // since the last call.
+    void wait();
+
+  private:
+    struct Queue {
+        std::mutex       mutex;
+        std::deque<Task> tasks;
+    };
+
+    void worker_loop(std::size_t worker);
+    bool pop(std::size_t worker, Task& task);
+
+  private:
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread>            workers;
+
+    std::mutex               mutex;
+    std::condition_variable  wake;
+    std::condition_variable  done;
+    std::atomic<std::size_t> queued;
+    std::size_t              unfinished;
+    std::exception_ptr       error;
+    bool                     stopping;
+
+    std::atomic<std::size_t> next_queue;
+};
+
+} // namespace utils
+
+#endif // THREAD_POOL_HPP
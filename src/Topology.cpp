@@ -0,0 +1,120 @@
+#include "Topology.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace utils {
+
+// CPUs the process is allowed to run on
+static std::vector<int> allowed_cpus() {
+    std::vector<int> cpus;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+#endif
+    if (cpus.empty()) {
+        auto count = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned cpu = 0; cpu < count; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+Topology Topology::detect() {
+    auto allowed = allowed_cpus();
+
+    std::vector<Node>     nodes;
+    std::filesystem::path sysfs("/sys/devices/system/node");
+    std::error_code       error;
+    for (const auto& entry : std::filesystem::directory_iterator(sysfs, error)) {
+        auto name = entry.path().filename().string();
+        if (name.rfind("node", 0) != 0 || name.size() == 4 ||
+            !std::all_of(begin(name) + 4, end(name), ::isdigit)) {
+            continue;
+        }
+
+        std::ifstream file(entry.path() / "cpulist");
+        std::string   list;
+        if (!std::getline(file, list)) {
+            continue;
+        }
+
+        // Only CPUs that can actually be used
+        Node node{std::stoi(name.substr(4)), {}};
+        for (auto cpu : parse_cpu_list(list)) {
+            if (std::find(begin(allowed), end(allowed), cpu) != end(allowed)) {
+                node.cpus.push_back(cpu);
+            }
+        }
+        if (!node.cpus.empty()) {
+            nodes.push_back(std::move(node));
+        }
+    }
+
+    if (nodes.empty()) {
+        nodes.push_back({0, std::move(allowed)});
+    }
+
+    std::sort(begin(nodes), end(nodes), [](const Node& a, const Node& b) { return a.id < b.id; });
+    return Topology(std::move(nodes));
+}
+
+Topology::Topology(std::vector<Node> nodes_arg) : nodes(std::move(nodes_arg)) {}
+
+std::size_t Topology::cpu_count() const {
+    std::size_t count = 0;
+    for (const auto& node : nodes) {
+        count += node.cpus.size();
+    }
+    return count;
+}
+
+std::vector<int> parse_cpu_list(const std::string& list) {
+    std::vector<int>  cpus;
+    std::stringstream stream(list);
+    std::string       range;
+    while (std::getline(stream, range, ',')) {
+        if (range.empty() || !std::isdigit(range.front())) {
+            continue;
+        }
+
+        auto dash = range.find('-');
+        int  first = std::stoi(range.substr(0, dash));
+        int  last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+bool pin_current_thread(int cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+} // namespace utils
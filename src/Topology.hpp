@@ -0,0 +1,42 @@
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#ifndef TOPOLOGY_HPP
+#define TOPOLOGY_HPP
+
+namespace utils {
+
+// NUMA topology of the machine, limited to the CPUs the process is allowed to run on.
+// Read from sysfs on Linux. When the information is not available, the whole machine is reported
+// as a single node.
+class Topology final {
+  public:
+    struct Node {
+        int              id;
+        std::vector<int> cpus;
+    };
+
+  public:
+    static Topology detect();
+
+    // Topology with the given nodes, useful for testing.
+    explicit Topology(std::vector<Node> nodes);
+
+  public:
+    const std::vector<Node>& get_nodes() const { return nodes; }
+    std::size_t              cpu_count() const;
+
+  private:
+    std::vector<Node> nodes;
+};
+
+// Parse CPU list in the sysfs format, e.g. "0-3,8,10-11".
+std::vector<int> parse_cpu_list(const std::string& list);
+
+// Pin the calling thread to a single CPU. Returns false if it's not supported or failed.
+bool pin_current_thread(int cpu);
+
+} // namespace utils
+
+#endif // TOPOLOGY_HPP
@@ -0,0 +1,49 @@
+#include <array>
+#include <atomic>
+
+#ifndef TRIPLE_BUFFER_HPP
+#define TRIPLE_BUFFER_HPP
+
+namespace utils {
+
+// Lock-free triple buffer for passing snapshots of a value from a single producer thread to a
+// single consumer thread. Neither side ever waits for the other one: the producer writes to its
+// own back buffer and publishes it by swapping with the middle one, the consumer takes the middle
+// one by swapping it with its front buffer. Buffers are reused, so if T keeps its memory on
+// assignment (like std::vector of the same size), no memory is allocated in steady state.
+template <typename T> class TripleBuffer final {
+  public:
+    TripleBuffer() = default;
+    explicit TripleBuffer(const T& initial) : buffers{initial, initial, initial} {}
+
+  public:
+    // Producer side. Fill the back buffer, then publish it.
+    T&   back() { return buffers[back_index]; }
+    void publish() {
+        back_index = middle.exchange(back_index | dirty, std::memory_order_acq_rel) & index_mask;
+    }
+
+    // Consumer side. Take the most recently published value, if there is a new one. Returns false
+    // if nothing was published since the last call, front() is unchanged then.
+    bool update() {
+        if (!(middle.load(std::memory_order_relaxed) & dirty)) {
+            return false;
+        }
+        front_index = middle.exchange(front_index, std::memory_order_acq_rel) & index_mask;
+        return true;
+    }
+    const T& front() const { return buffers[front_index]; }
+
+  private:
+    static constexpr unsigned dirty = 4;
+    static constexpr unsigned index_mask = 3;
+
+    std::array<T, 3>      buffers;
+    std::atomic<unsigned> middle{1};
+    unsigned              back_index = 0;  // Owned by the producer
+    unsigned              front_index = 2; // Owned by the consumer
+};
+
+} // namespace utils
+
+#endif // TRIPLE_BUFFER_HPP
@@ -1,28 +1,18 @@
 #include <algorithm>
 #include <chrono>
+#include <cstdint>
+#include <fstream>
 #include <iostream>
 #include <random>
 #include <vector>
 
 #include "AcoAlgorithmCpu.hpp"
 #include "AcoGraph.hpp"
+#include "AcoRunLog.hpp"
+#include "AcoTuner.hpp"
 #include "Utils.hpp"
 
-using Path = std::vector<std::size_t>; // Indices of cities in order
-
-auto path_length(const aco::Graph& graph, const Path& path) {
-    int length = 0;
-    for (int i = 0; i < path.size(); ++i) {
-        // Path stores visited cities in order. It is a round trip, so the last distance is from the
-        // last city directly to the first one
-        auto src = path[i];
-        auto dst = path[(i + 1) % path.size()];
-
-        length += graph.get_cost(src, dst);
-    }
-
-    return length;
-}
+using Path = aco::Graph::Path;
 
 const Path& get_shortest_path(const aco::Graph& graph, const std::vector<Path>& paths) {
     if (paths.empty()) {
@@ -30,21 +20,41 @@ const Path& get_shortest_path(const aco::Graph& graph, const std::vector<Path>&
     }
 
     return *std::min_element(begin(paths), end(paths), [&](const Path& a, const Path& b) {
-        return path_length(graph, a) < path_length(graph, b);
+        return graph.path_length(a) < graph.path_length(b);
     });
 }
 
-std::ostream& operator<<(std::ostream& out, const std::vector<aco::Graph::Index>& path) {
-    out << "[";
-    for (auto elem : path) {
-        out << elem << " ";
+// Log an iteration that has just finished, with the tour only if it improved
+static void log_iteration(aco::RunLog& log, std::size_t index, int iteration,
+                          aco::Algorithm& algorithm, const Path& iteration_best,
+                          std::int64_t previous_best,
+                          std::chrono::steady_clock::time_point begin,
+                          std::chrono::steady_clock::time_point iter_begin,
+                          std::chrono::steady_clock::time_point iter_end) {
+    auto nanoseconds = [](auto duration) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    };
+    auto        diagnostics = algorithm.get_diagnostics();
+    const auto& shortest_path = algorithm.get_shortest_path();
+
+    aco::RunLog::Record record;
+    record.algorithm = index;
+    record.iteration = iteration;
+    record.best_length = algorithm.path_length(shortest_path);
+    record.iteration_length = algorithm.path_length(iteration_best);
+    record.elapsed_ns = nanoseconds(iter_end - begin);
+    record.advance_ns = nanoseconds(iter_end - iter_begin);
+    record.branching_factor = diagnostics.branching_factor;
+    record.entropy = diagnostics.entropy;
+    record.diversity = diagnostics.diversity;
+    if (record.best_length < previous_best) {
+        record.tour_size = shortest_path.size();
     }
-    out << "]";
-    return out;
+    log.log(record, shortest_path.data());
 }
 
 void standard_simulation(int max_iterations, std::mt19937& gen, aco::Graph graph,
-                         aco::Algorithm::Config config) {
+                         aco::Algorithm::Config config, aco::RunLog& log) {
     std::vector<std::unique_ptr<aco::Algorithm>> algorithms;
     algorithms.push_back(aco::Algorithm::make(aco::DeviceType::CPU, gen, graph, config));
     algorithms.push_back(aco::Algorithm::make(aco::DeviceType::CPU, gen, graph, config));
@@ -52,54 +62,60 @@ void standard_simulation(int max_iterations, std::mt19937& gen, aco::Graph graph
     algorithms.push_back(aco::Algorithm::make(aco::DeviceType::GPU, gen, graph, config));
     algorithms.push_back(aco::Algorithm::make(aco::DeviceType::GPU, gen, graph, config));
     algorithms.push_back(aco::Algorithm::make(aco::DeviceType::GPU, gen, graph, config));
+    for (std::size_t a = 0; a < algorithms.size(); ++a) {
+        std::cout << "Algorithm " << a << ": " << algorithms[a]->info() << "\n";
+    }
 
     // Main loop
+    auto begin = std::chrono::steady_clock::now();
     for (int i = 0; i < max_iterations; ++i) {
-        std::cout << "\n\nIteration " << i << "\n\n";
-        for (auto& algorithm : algorithms) {
+        for (std::size_t a = 0; a < algorithms.size(); ++a) {
             // Remember previous best, advance simulation
-            auto previous_best = algorithm->get_shortest_path();
-            auto iteration_best = algorithm->advance();
-
-            // Print results
-            std::cout << "Algorithm: " << algorithm->info() << "\n";
-            std::cout << "Shortest path: " << iteration_best
-                      << ", length: " << algorithm->path_length(iteration_best) << "\n";
-            std::cout << "Previous best: " << previous_best
-                      << ", length: " << algorithm->path_length(previous_best) << "\n";
+            auto& algorithm = *algorithms[a];
+            auto  previous_best = algorithm.path_length(algorithm.get_shortest_path());
+            auto  iter_begin = std::chrono::steady_clock::now();
+            auto  iteration_best = algorithm.advance();
+            auto  iter_end = std::chrono::steady_clock::now();
+
+            log_iteration(log, a, i + 1, algorithm, iteration_best, previous_best, begin,
+                          iter_begin, iter_end);
         }
     }
 }
 
 void benchmark_simulation(int max_iterations, std::mt19937& gen, aco::Graph graph,
-                          aco::Algorithm::Config config) {
+                          aco::Algorithm::Config config, aco::RunLog& log) {
     std::vector<std::unique_ptr<aco::Algorithm>> algorithms;
     algorithms.push_back(aco::Algorithm::make(aco::DeviceType::GPU, gen, graph, config));
     algorithms.push_back(aco::Algorithm::make(aco::DeviceType::CPU, gen, graph, config));
 
     struct Result {
         std::string      info;
-        int              best_path_length;
+        std::int64_t     best_path_length;
         std::vector<int> iteration_times;
         int              total_time;
     };
     std::vector<Result> results;
 
     // Main loop
-    for (auto& algorithm : algorithms) {
+    for (std::size_t a = 0; a < algorithms.size(); ++a) {
+        auto&  algorithm = algorithms[a];
         Result algorithm_result;
-        std::cout << "Starting simulation using algorithm: " << algorithm->info() << "...\n";
+        std::cout << "Starting simulation using algorithm " << a << ": " << algorithm->info()
+                  << "...\n";
         algorithm_result.iteration_times.resize(max_iterations);
         auto begin = std::chrono::steady_clock::now();
         for (int i = 0; i < max_iterations; ++i) {
+            auto previous_best = algorithm->path_length(algorithm->get_shortest_path());
             auto iter_begin = std::chrono::steady_clock::now();
             auto iteration_best = algorithm->advance();
             auto iter_end = std::chrono::steady_clock::now();
             algorithm_result.iteration_times[i] =
                 std::chrono::duration_cast<std::chrono::milliseconds>(iter_end - iter_begin)
                     .count();
-            std::cout << "Iteration time: " << algorithm_result.iteration_times[i]
-                      << " ms, path length: " << algorithm->path_length(iteration_best) << "\n";
+
+            log_iteration(log, a, i + 1, *algorithm, iteration_best, previous_best, begin,
+                          iter_begin, iter_end);
         }
         // TODO: Synchronize
         auto end = std::chrono::steady_clock::now();
@@ -129,10 +145,11 @@ void benchmark_simulation(int max_iterations, std::mt19937& gen, aco::Graph grap
 
 int main(int argc, char* argv[]) {
     // Parse command line arguments
-    if (argc != 2) {
+    if (argc != 2 && argc != 3) {
         std::cout << "Ant Colony Optimization algorithm applied to the Travelling Salesman "
                      "Problem.\n";
-        std::cout << "Usage: " << argv[0] << " iterations\n";
+        std::cout << "Usage: " << argv[0] << " iterations [profile]\n";
+        std::cout << "Profile with tuned parameters can be created with the 'tune' tool.\n";
         return 1;
     }
     int max_iterations = std::stoi(argv[1]);
@@ -154,11 +171,27 @@ int main(int argc, char* argv[]) {
 
     aco::Algorithm::Config config = {.agents_count = agents,
                                      .pheromone_evaporation = pheromone_evaporation};
+    if (argc == 3) {
+        // Tuned parameters replace the hard-coded ones
+        std::ifstream file(argv[2]);
+        std::string   contents((std::istreambuf_iterator<char>(file)),
+                               std::istreambuf_iterator<char>());
+        config = aco::Profile::from_string(contents).make_config(cities);
+    }
+
+    // Iterations are logged in the background, printing them would take longer than the
+    // iterations themselves
+    const std::string log_filename = "tsp_aco_run.ndjson";
+    aco::RunLog       log(log_filename, aco::RunLog::Format::Ndjson);
+    std::cout << "Iterations are logged to: " << log_filename << "\n";
 
     bool benchmark = true;
     if (!benchmark) {
-        standard_simulation(max_iterations, gen, graph, config);
+        standard_simulation(max_iterations, gen, graph, config, log);
     } else {
-        benchmark_simulation(max_iterations, gen, graph, config);
+        benchmark_simulation(max_iterations, gen, graph, config, log);
+    }
+    if (log.dropped() > 0) {
+        std::cout << "Run log couldn't keep up, records dropped: " << log.dropped() << "\n";
     }
 }
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <utility>
+#include <vector>
+
+#include "../AcoAlgorithm.hpp"
+#include "../AcoAlgorithmCpuAsync.hpp"
+#include "../AcoGraph.hpp"
+
+using aco::Algorithm;
+using aco::AlgorithmCpuAsync;
+using aco::DeviceType;
+using aco::Graph;
+
+// More threads than CPUs is fine, threads share them then
+TEST(AcoAlgorithmCpuAsyncTest, MultipleThreadsBuildAllTours) {
+    std::mt19937 gen(/*seed=*/42);
+    std::size_t  nodes = 30;
+    Graph        graph(gen, nodes, /*initial_pheromone=*/0.01);
+
+    Algorithm::Config config{/*agents_count=*/nodes * 2, /*pheromone_evaporation=*/0.9};
+    config.threads = 4;
+    auto  algorithm = Algorithm::make(DeviceType::CPU_ASYNC, gen, graph, config);
+    auto& async = static_cast<AlgorithmCpuAsync&>(*algorithm);
+
+    std::int64_t first_length = 0;
+    for (int i = 0; i < 20; ++i) {
+        auto iteration_best = algorithm->advance();
+        if (i == 0) {
+            first_length = algorithm->path_length(iteration_best);
+        }
+
+        // Tours of every finished iteration are counted, not the ones built ahead
+        auto statistics = async.get_statistics();
+        EXPECT_EQ((i + 1) * config.agents_count, statistics.tours);
+        EXPECT_GT(statistics.seconds, 0);
+        EXPECT_GT(statistics.tours_per_second, 0);
+    }
+
+    // Simulation makes progress
+    EXPECT_LT(algorithm->path_length(algorithm->get_shortest_path()), first_length);
+}
+
+// Deposits and evaporation are concurrent, but pheromones never go below the initial level
+TEST(AcoAlgorithmCpuAsyncTest, PheromonesStayAboveInitialLevel) {
+    std::mt19937 gen(/*seed=*/42);
+    std::size_t  nodes = 20;
+    float        initial_pheromone = 0.01;
+    Graph        graph(gen, nodes, initial_pheromone);
+
+    Algorithm::Config config{/*agents_count=*/nodes, /*pheromone_evaporation=*/0.5};
+    config.threads = 3;
+    auto algorithm = Algorithm::make(DeviceType::CPU_ASYNC, gen, graph, config);
+    for (int i = 0; i < 30; ++i) {
+        algorithm->advance();
+    }
+
+    const auto& result = algorithm->get_graph();
+    for (std::size_t i = 0; i < nodes; ++i) {
+        for (std::size_t j = 0; j < nodes; ++j) {
+            if (i != j) {
+                EXPECT_GE(result.get_pheromone(i, j), initial_pheromone);
+            }
+        }
+    }
+}
+
+TEST(AcoAlgorithmCpuAsyncTest, ResetStartsOver) {
+    std::mt19937 gen(/*seed=*/42);
+    Graph        graph(gen, /*nodes=*/20, /*initial_pheromone=*/0.01);
+    Graph        other(gen, /*nodes=*/25, /*initial_pheromone=*/0.01);
+
+    Algorithm::Config config{/*agents_count=*/20, /*pheromone_evaporation=*/0.9};
+    config.threads = 2;
+    auto algorithm = Algorithm::make(DeviceType::CPU_ASYNC, gen, graph, config);
+    for (int i = 0; i < 5; ++i) {
+        algorithm->advance();
+    }
+
+    // Workers have run ahead in the meantime, reset must wait for them
+    config.agents_count = 25;
+    algorithm->reset(other, config);
+    EXPECT_EQ(other, algorithm->get_graph());
+    EXPECT_EQ(0, static_cast<AlgorithmCpuAsync&>(*algorithm).get_statistics().tours);
+
+    auto path = algorithm->advance();
+    EXPECT_EQ(25, path.size());
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <utility>
+#include <vector>
+
+#include "../AcoAlgorithm.hpp"
+#include "../AcoAlgorithmCpuNuma.hpp"
+#include "../AcoGraph.hpp"
+#include "../Topology.hpp"
+
+using aco::Algorithm;
+using aco::AlgorithmCpuNuma;
+using aco::DeviceType;
+using aco::Graph;
+
+TEST(TopologyTest, ParseCpuList) {
+    EXPECT_EQ(std::vector<int>({0}), utils::parse_cpu_list("0"));
+    EXPECT_EQ(std::vector<int>({0, 1, 2, 3}), utils::parse_cpu_list("0-3"));
+    EXPECT_EQ(std::vector<int>({0, 1, 8, 10, 11}), utils::parse_cpu_list("0-1,8,10-11\n"));
+    EXPECT_EQ(std::vector<int>(), utils::parse_cpu_list(""));
+}
+
+TEST(TopologyTest, DetectFindsAtLeastOneCpu) {
+    auto topology = utils::Topology::detect();
+    ASSERT_FALSE(topology.get_nodes().empty());
+    EXPECT_GE(topology.cpu_count(), 1);
+    for (const auto& node : topology.get_nodes()) {
+        EXPECT_FALSE(node.cpus.empty());
+    }
+}
+
+// More threads than CPUs is fine, threads share them then
+TEST(AcoAlgorithmCpuNumaTest, MultipleThreadsBuildAllTours) {
+    std::mt19937 gen(/*seed=*/42);
+    std::size_t  nodes = 30;
+    Graph        graph(gen, nodes, /*initial_pheromone=*/0.01);
+
+    Algorithm::Config config{/*agents_count=*/nodes * 2, /*pheromone_evaporation=*/0.9};
+    config.threads = 4;
+    auto algorithm = Algorithm::make(DeviceType::CPU_NUMA, gen, graph, config);
+
+    std::int64_t first_length = 0;
+    for (int i = 0; i < 20; ++i) {
+        auto iteration_best = algorithm->advance();
+        if (i == 0) {
+            first_length = algorithm->path_length(iteration_best);
+        }
+
+        // All agents built their tours
+        auto        statistics = static_cast<AlgorithmCpuNuma&>(*algorithm).get_statistics();
+        std::size_t tours = 0, threads = 0, replica_bytes = 0;
+        for (const auto& node : statistics) {
+            tours += node.tours;
+            threads += node.threads;
+            replica_bytes += node.replica_bytes;
+        }
+        EXPECT_EQ(config.agents_count, tours);
+        EXPECT_EQ(config.threads, threads);
+
+        // The replicas as reported by the footprint
+        auto footprint = algorithm->get_footprint();
+        EXPECT_EQ(footprint.get("replica costs") + footprint.get("replica choice info") +
+                      footprint.get("replica deposits"),
+                  replica_bytes);
+        EXPECT_GE(replica_bytes, nodes * nodes * sizeof(int));
+    }
+
+    // Simulation makes progress
+    EXPECT_LT(algorithm->path_length(algorithm->get_shortest_path()), first_length);
+}
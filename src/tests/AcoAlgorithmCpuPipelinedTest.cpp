@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include <utility>
+#include <vector>
+
+#include "../AcoAlgorithm.hpp"
+#include "../AcoGraph.hpp"
+
+using aco::Algorithm;
+using aco::DeviceType;
+using aco::Graph;
+
+// With a single agent, the iteration best path is the only one that leaves pheromones, so the
+// update can be verified exactly. The pipeline must give the same pheromones as the serial version.
+TEST(AcoAlgorithmCpuPipelinedTest, PheromonesMatchSerialUpdate) {
+    for (auto device : {DeviceType::CPU, DeviceType::CPU_PIPELINED}) {
+        std::mt19937 gen(/*seed=*/42);
+        std::size_t  nodes = 100;
+        Graph        graph(gen, nodes, /*initial_pheromone=*/0.01);
+
+        Algorithm::Config config{/*agents_count=*/1, /*pheromone_evaporation=*/0.8};
+        config.threads = 3;
+        auto algorithm = Algorithm::make(device, gen, graph, config);
+
+        for (int iteration = 0; iteration < 5; ++iteration) {
+            auto expected = algorithm->get_graph();
+            auto path = algorithm->advance();
+
+            // Evaporation, then the deposit
+            expected.update_all(config.pheromone_evaporation);
+            float total_pheromone = 1.f / expected.path_length(path);
+            for (std::size_t i = 0; i < nodes; ++i) {
+                auto src = path[i];
+                auto dst = path[(i + 1) % nodes];
+                expected.add_pheromone_two_way(src, dst,
+                                               total_pheromone / expected.get_cost(src, dst));
+            }
+
+            const auto& actual = algorithm->get_graph();
+            for (std::size_t i = 0; i < nodes; ++i) {
+                for (std::size_t j = 0; j < nodes; ++j) {
+                    if (i != j) {
+                        ASSERT_FLOAT_EQ(expected.get_pheromone(i, j), actual.get_pheromone(i, j))
+                            << device << ", iteration: " << iteration << ", edge: " << i << " -> "
+                            << j;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(AcoAlgorithmCpuPipelinedTest, ResetToDifferentSize) {
+    std::mt19937 gen(/*seed=*/42);
+    Graph        graph(gen, /*nodes=*/40, /*initial_pheromone=*/0.01);
+    Graph        other(gen, /*nodes=*/25, /*initial_pheromone=*/0.01);
+
+    Algorithm::Config config{/*agents_count=*/10, /*pheromone_evaporation=*/0.9};
+    auto algorithm = Algorithm::make(DeviceType::CPU_PIPELINED, gen, graph, config);
+    for (int i = 0; i < 3; ++i) {
+        algorithm->advance();
+    }
+
+    algorithm->reset(other, config);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(25, algorithm->advance().size());
+    }
+}
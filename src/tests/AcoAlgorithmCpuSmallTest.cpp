@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <utility>
+#include <vector>
+
+#include "../AcoAlgorithm.hpp"
+#include "../AcoGraph.hpp"
+
+using aco::Algorithm;
+using aco::DeviceType;
+using aco::Graph;
+
+TEST(AcoAlgorithmCpuSmallTest, PicksTheSmallestSpecialization) {
+    std::mt19937            gen(/*seed=*/42);
+    const Algorithm::Config config{/*agents_count=*/8, /*pheromone_evaporation=*/0.9};
+
+    for (auto [nodes, expected] : {std::pair<std::size_t, std::size_t>{5, 32}, {32, 32}, {33, 64},
+                                   {100, 128}, {256, 256}}) {
+        Graph graph(gen, nodes, /*initial_pheromone=*/0.01);
+        auto  algorithm = Algorithm::make(DeviceType::CPU_SMALL, gen, graph, config);
+        EXPECT_EQ("CPU_SMALL (up to " + std::to_string(expected) + " cities)", algorithm->info());
+        EXPECT_EQ(nodes, algorithm->advance().size());
+    }
+
+    Graph too_big(gen, /*nodes=*/257, /*initial_pheromone=*/0.01);
+    EXPECT_THROW(Algorithm::make(DeviceType::CPU_SMALL, gen, too_big, config),
+                 std::invalid_argument);
+}
+
+// With a single agent, the iteration best path is the only one that leaves pheromones, so the
+// update can be verified exactly
+TEST(AcoAlgorithmCpuSmallTest, PheromonesMatchSerialUpdate) {
+    std::mt19937 gen(/*seed=*/42);
+    std::size_t  nodes = 50;
+    Graph        graph(gen, nodes, /*initial_pheromone=*/0.01);
+
+    Algorithm::Config config{/*agents_count=*/1, /*pheromone_evaporation=*/0.8};
+    auto              algorithm = Algorithm::make(DeviceType::CPU_SMALL, gen, graph, config);
+
+    for (int iteration = 0; iteration < 5; ++iteration) {
+        auto expected = algorithm->get_graph();
+        auto path = algorithm->advance();
+
+        // Evaporation, then the deposit
+        expected.update_all(config.pheromone_evaporation);
+        float total_pheromone = 1.f / expected.path_length(path);
+        for (std::size_t i = 0; i < nodes; ++i) {
+            auto src = path[i];
+            auto dst = path[(i + 1) % nodes];
+            expected.add_pheromone_two_way(src, dst, total_pheromone / expected.get_cost(src, dst));
+        }
+
+        const auto& actual = algorithm->get_graph();
+        for (std::size_t i = 0; i < nodes; ++i) {
+            for (std::size_t j = 0; j < nodes; ++j) {
+                if (i != j) {
+                    ASSERT_FLOAT_EQ(expected.get_pheromone(i, j), actual.get_pheromone(i, j))
+                        << "iteration: " << iteration << ", edge: " << i << " -> " << j;
+                }
+            }
+        }
+    }
+}
+
+TEST(AcoAlgorithmCpuSmallTest, GraphCantGrowOverTheSpecialization) {
+    std::mt19937 gen(/*seed=*/42);
+    Graph        graph(gen, /*nodes=*/32, /*initial_pheromone=*/0.01);
+
+    Algorithm::Config config{/*agents_count=*/32, /*pheromone_evaporation=*/0.9};
+    auto              algorithm = Algorithm::make(DeviceType::CPU_SMALL, gen, graph, config);
+    algorithm->advance();
+    auto learned = algorithm->get_graph();
+
+    // Nothing changes on failure
+    std::vector<int> costs(32, 5);
+    EXPECT_THROW(algorithm->add_node(costs), std::invalid_argument);
+    EXPECT_EQ(learned, algorithm->get_graph());
+
+    // Room for one again
+    algorithm->remove_node(0);
+    costs.resize(31);
+    EXPECT_EQ(31, algorithm->add_node(costs));
+    EXPECT_EQ(32, algorithm->advance().size());
+}
+
+TEST(AcoAlgorithmCpuSmallTest, FailedResetKeepsTheAlgorithm) {
+    std::mt19937 gen(/*seed=*/42);
+    Graph        graph(gen, /*nodes=*/32, /*initial_pheromone=*/0.01);
+    Graph        big(gen, /*nodes=*/33, /*initial_pheromone=*/0.01);
+
+    Algorithm::Config config{/*agents_count=*/32, /*pheromone_evaporation=*/0.9};
+    auto              algorithm = Algorithm::make(DeviceType::CPU_SMALL, gen, graph, config);
+    algorithm->advance();
+    auto learned = algorithm->get_graph();
+
+    // The graph is checked before anything is replaced
+    EXPECT_THROW(algorithm->reset(big, config), std::invalid_argument);
+    EXPECT_EQ(learned, algorithm->get_graph());
+    EXPECT_EQ(32, algorithm->advance().size());
+}
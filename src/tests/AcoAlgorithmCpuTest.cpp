@@ -0,0 +1,55 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <vector>
+
+#include "../AcoAlgorithm.hpp"
+#include "../AcoAlgorithmCpu.hpp"
+#include "../AcoGraph.hpp"
+
+using aco::Algorithm;
+using aco::AlgorithmCpu;
+using aco::DeviceType;
+using aco::Graph;
+
+static bool is_permutation(Algorithm::Path path, std::size_t nodes) {
+    std::sort(begin(path), end(path));
+    std::vector<Graph::Index> expected(nodes);
+    std::iota(begin(expected), end(expected), 0);
+    return path == expected;
+}
+
+// Only the CPU backend applies Config::pruning_factor
+TEST(AcoAlgorithmCpuTest, PruningAbandonsAntsAndKeepsPathsValid) {
+    std::mt19937 gen(/*seed=*/42);
+    std::size_t  nodes = 30;
+    Graph        graph(gen, nodes, /*initial_pheromone=*/0.01);
+
+    // Aggressive, most of the ants start over
+    Algorithm::Config config{/*agents_count=*/nodes, /*pheromone_evaporation=*/0.9};
+    config.pruning_factor = 1;
+    auto  algorithm = Algorithm::make(DeviceType::CPU, gen, graph, config);
+    auto& cpu = static_cast<AlgorithmCpu&>(*algorithm);
+
+    auto previous = algorithm->path_length(algorithm->get_shortest_path());
+    for (int i = 0; i < 20; ++i) {
+        ASSERT_TRUE(is_permutation(algorithm->advance(), nodes));
+        ASSERT_TRUE(is_permutation(algorithm->get_shortest_path(), nodes));
+        auto length = algorithm->path_length(algorithm->get_shortest_path());
+        EXPECT_LE(length, previous);
+        previous = length;
+    }
+
+    // An abandoned ant leaves no tour, and at most twice as many ants are started
+    auto statistics = cpu.get_statistics();
+    EXPECT_GT(statistics.abandoned, 0);
+    EXPECT_LT(statistics.tours, 20 * config.agents_count);
+    EXPECT_LE(statistics.tours + statistics.abandoned, 20 * 2 * config.agents_count + 20);
+
+    // Without pruning, every ant finishes its tour
+    config.pruning_factor = 0;
+    algorithm->reset(graph, config);
+    algorithm->advance();
+    EXPECT_EQ(0, cpu.get_statistics().abandoned);
+    EXPECT_EQ(config.agents_count, cpu.get_statistics().tours);
+}
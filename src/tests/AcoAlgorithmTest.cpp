@@ -1,3 +1,4 @@
+#include <cmath>
 #include <gtest/gtest.h>
 #include <utility>
 #include <vector>
@@ -70,6 +71,22 @@ TEST_P(AcoAlgorithmTest, ThrowsOnInvalidArguments) {
         EXPECT_THROW(make_algorithm(graph, config), std::invalid_argument)
             << "Should throw on pheromone evaporation coefficient greater than one.";
     }
+
+    {
+        // Negative alpha or beta
+        auto config = correct_config;
+        config.beta = -1;
+        EXPECT_THROW(make_algorithm(graph, config), std::invalid_argument)
+            << "Should throw on negative beta.";
+    }
+
+    {
+        // Pruning factor below 1, which would prune every ant
+        auto config = correct_config;
+        config.pruning_factor = 0.5;
+        EXPECT_THROW(make_algorithm(graph, config), std::invalid_argument)
+            << "Should throw on pruning factor below 1.";
+    }
 }
 
 TEST_P(AcoAlgorithmTest, GetGraph) {
@@ -188,5 +205,99 @@ TEST_P(AcoAlgorithmTest, CompareIterationBestPathAndBestSoFar) {
     EXPECT_LT(equal_count, max_iterations);
 }
 
+TEST_P(AcoAlgorithmTest, DynamicChangesKeepPheromonesAndRepairShortestPath) {
+    // Initialize and learn something first
+    std::size_t nodes = 30;
+    Graph       graph(gen, nodes, /*initial_pheromone=*/0.01);
+
+    const Algorithm::Config config{/*agents_count=*/nodes, /*pheromone_evaporation=*/0.9};
+    auto                    algorithm = make_algorithm(graph, config);
+    for (int i = 0; i < 5; ++i) {
+        algorithm->advance();
+    }
+    auto learned = algorithm->get_graph();
+    auto length = algorithm->path_length(algorithm->get_shortest_path());
+
+    // Add a node, the shortest path gets longer at most by the cost of a detour to the new node
+    std::vector<int> costs(nodes, 5);
+    auto             node = algorithm->add_node(costs);
+    EXPECT_EQ(nodes, node);
+    ASSERT_EQ(nodes + 1, algorithm->get_graph().get_size());
+    validate_path(algorithm->get_graph(), algorithm->get_shortest_path());
+    EXPECT_LE(algorithm->path_length(algorithm->get_shortest_path()), length + 10);
+    EXPECT_FLOAT_EQ(learned.get_pheromone(3, 7), algorithm->get_graph().get_pheromone(3, 7));
+
+    // Remove another one, the following nodes move by one
+    algorithm->remove_node(2);
+    ASSERT_EQ(nodes, algorithm->get_graph().get_size());
+    validate_path(algorithm->get_graph(), algorithm->get_shortest_path());
+    EXPECT_FLOAT_EQ(learned.get_pheromone(3, 7), algorithm->get_graph().get_pheromone(2, 6));
+
+    // Change a cost
+    algorithm->set_cost(0, 1, 1000);
+    EXPECT_EQ(1000, algorithm->get_graph().get_cost(0, 1));
+
+    // The algorithm keeps working on the changed graph
+    for (int i = 0; i < 5; ++i) {
+        validate_path(algorithm->get_graph(), algorithm->advance());
+        validate_path(algorithm->get_graph(), algorithm->get_shortest_path());
+    }
+}
+
+TEST_P(AcoAlgorithmTest, DiagnosticsShowConvergence) {
+    std::size_t nodes = 30;
+    Graph       graph(gen, nodes, /*initial_pheromone=*/0.01);
+
+    Algorithm::Config config{/*agents_count=*/nodes, /*pheromone_evaporation=*/0.5};
+    config.diagnostics_samples = nodes;
+    auto algorithm = make_algorithm(graph, config);
+    EXPECT_TRUE(std::isnan(algorithm->get_diagnostics().branching_factor));
+
+    algorithm->advance();
+    auto first = algorithm->get_diagnostics();
+    for (int i = 0; i < 30; ++i) {
+        algorithm->advance();
+    }
+    auto last = algorithm->get_diagnostics();
+
+    EXPECT_LT(last.branching_factor, first.branching_factor);
+    EXPECT_GE(last.branching_factor, 1);
+    EXPECT_LT(last.entropy, first.entropy);
+    EXPECT_GE(last.entropy, 0);
+    if (!std::isnan(first.diversity)) {
+        EXPECT_LT(last.diversity, first.diversity);
+    }
+}
+
+TEST_P(AcoAlgorithmTest, LongToursDontOverflow) {
+    // Every tour is 10 times the cost, well above what fits in an int
+    std::size_t nodes = 10;
+    int         cost = 1'000'000'000;
+    Graph       graph(gen, nodes, /*initial_pheromone=*/0.01);
+    for (std::size_t i = 0; i < nodes; ++i) {
+        for (std::size_t j = 0; j < nodes; ++j) {
+            if (i != j) {
+                graph.set_cost(i, j, cost);
+            }
+        }
+    }
+
+    Algorithm::Config config{/*agents_count=*/nodes, /*pheromone_evaporation=*/0.9};
+    auto              algorithm = make_algorithm(graph, config);
+    auto              iteration_best = algorithm->advance();
+    EXPECT_EQ(std::int64_t{cost} * nodes, algorithm->path_length(iteration_best));
+    EXPECT_EQ(std::int64_t{cost} * nodes,
+              algorithm->path_length(algorithm->get_shortest_path()));
+
+    // Inserted next to the only cheap neighbour, other places would cost 2 * 2e9 - 1e9
+    std::vector<int> costs(nodes, 2'000'000'000);
+    costs[3] = 1;
+    algorithm->add_node(costs);
+    EXPECT_EQ(std::int64_t{cost} * nodes + cost + 1,
+              algorithm->path_length(algorithm->get_shortest_path()));
+}
+
 INSTANTIATE_TEST_SUITE_P(AcoAlgorithmTest, AcoAlgorithmTest,
-                         testing::Values(DeviceType::CPU, DeviceType::GPU));
\ No newline at end of file
+                         testing::Values(DeviceType::CPU, DeviceType::GPU, DeviceType::CPU_NUMA,
+                                         DeviceType::CPU_ASYNC, DeviceType::CPU_PIPELINED,
+                                         DeviceType::CPU_SIMD, DeviceType::CPU_SMALL));
\ No newline at end of file
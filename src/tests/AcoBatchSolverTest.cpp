@@ -0,0 +1,200 @@
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <limits>
+#include <map>
+#include <set>
+#include <sstream>
+#include <vector>
+
+#include "../../third_party/nlohmann/json.hpp"
+#include "../AcoBatchSolver.hpp"
+#include "../AcoGraph.hpp"
+
+using aco::BatchSolver;
+using aco::DeviceType;
+using aco::Graph;
+
+class AcoBatchSolverTest : public ::testing::Test {
+  public:
+    AcoBatchSolverTest()
+        : gen(/*seed=*/42), directory(std::filesystem::temp_directory_path() / "aco_batch_test") {
+        std::filesystem::create_directories(directory);
+    }
+
+    ~AcoBatchSolverTest() { std::filesystem::remove_all(directory); }
+
+  public:
+    // Write a random graph to a file, return its filename
+    std::string write_graph(const std::string& name, std::size_t nodes) {
+        auto          filename = (directory / name).string();
+        std::ofstream file(filename);
+        file << Graph(gen, nodes, /*initial_pheromone=*/0.1).to_string();
+        return filename;
+    }
+
+    // Parse output of the solver, one JSON per line
+    static std::vector<nlohmann::json> parse_results(const std::string& output) {
+        std::vector<nlohmann::json> results;
+        std::istringstream          stream(output);
+        std::string                 line;
+        while (std::getline(stream, line)) {
+            results.push_back(nlohmann::json::parse(line));
+        }
+        return results;
+    }
+
+    static BatchSolver::Config make_config() {
+        return {DeviceType::CPU, /*threads=*/4, /*agents_per_node=*/2,
+                /*pheromone_evaporation=*/0.9, /*budget=*/{10, std::chrono::milliseconds(0)},
+                /*seed=*/42};
+    }
+
+  public:
+    std::mt19937          gen;
+    std::filesystem::path directory;
+};
+
+TEST_F(AcoBatchSolverTest, ThrowsOnInvalidArguments) {
+    {
+        auto config = make_config();
+        config.agents_per_node = 0;
+        EXPECT_THROW(BatchSolver solver(config), std::invalid_argument);
+    }
+
+    {
+        // No limits at all
+        auto config = make_config();
+        config.budget = {};
+        EXPECT_THROW(BatchSolver solver(config), std::invalid_argument);
+    }
+
+    {
+        // Negative limits, rejected like by Solver
+        auto config = make_config();
+        config.budget.max_stagnation = -1;
+        EXPECT_THROW(BatchSolver solver(config), std::invalid_argument);
+    }
+}
+
+TEST_F(AcoBatchSolverTest, TargetLengthAloneIsBudget) {
+    // Accepted by Solver, so by batches too. Any tour reaches this target.
+    auto config = make_config();
+    config.budget = {};
+    config.budget.target_length = std::numeric_limits<int>::max();
+
+    std::stringstream queue;
+    queue << write_graph("target.json", 10) << "\n";
+    BatchSolver       solver(config);
+    std::stringstream output;
+    solver.run(queue, output);
+
+    auto results = parse_results(output.str());
+    ASSERT_EQ(1, results.size());
+    EXPECT_EQ(1, results[0].at("iterations").get<int>());
+    EXPECT_EQ("target", results[0].at("stop").get<std::string>());
+}
+
+TEST_F(AcoBatchSolverTest, SolvesAllInstancesFromQueue) {
+    // Instances of different sizes, so that workspaces are reused between them
+    std::map<std::string, std::size_t> sizes;
+    std::stringstream                  queue;
+    queue << "# Comment line\n\n";
+    for (int i = 0; i < 12; ++i) {
+        std::size_t nodes = 5 + (i * 7) % 20;
+        auto        filename = write_graph("graph_" + std::to_string(i) + ".json", nodes);
+        sizes[filename] = nodes;
+        queue << filename << "\n";
+    }
+
+    BatchSolver       solver(make_config());
+    std::stringstream output;
+    EXPECT_EQ(sizes.size(), solver.run(queue, output));
+
+    auto results = parse_results(output.str());
+    ASSERT_EQ(sizes.size(), results.size());
+
+    std::set<std::string> solved;
+    for (const auto& result : results) {
+        auto instance = result.at("instance").get<std::string>();
+        ASSERT_FALSE(result.contains("error")) << result.dump();
+        EXPECT_EQ(sizes.at(instance), result.at("nodes").get<std::size_t>());
+        EXPECT_EQ(10, result.at("iterations").get<int>());
+        EXPECT_GT(result.at("length").get<int>(), 0);
+
+        // Path should be a permutation of all nodes
+        auto path = result.at("path").get<std::vector<std::size_t>>();
+        std::sort(begin(path), end(path));
+        for (std::size_t i = 0; i < path.size(); ++i) {
+            EXPECT_EQ(i, path[i]);
+        }
+        EXPECT_EQ(sizes.at(instance), path.size());
+
+        solved.insert(instance);
+    }
+    EXPECT_EQ(sizes.size(), solved.size());
+}
+
+TEST_F(AcoBatchSolverTest, PerInstanceBudget) {
+    std::stringstream queue;
+    queue << write_graph("small.json", 10) << " 3\n";
+    queue << write_graph("timed.json", 10) << " 0 20\n";
+
+    BatchSolver       solver(make_config());
+    std::stringstream output;
+    solver.run(queue, output);
+
+    for (const auto& result : parse_results(output.str())) {
+        if (result.at("instance").get<std::string>().find("small") != std::string::npos) {
+            EXPECT_EQ(3, result.at("iterations").get<int>());
+            EXPECT_EQ("iterations", result.at("stop").get<std::string>());
+        } else {
+            // Only the time limit applies
+            EXPECT_GE(result.at("iterations").get<int>(), 1);
+            EXPECT_EQ("time", result.at("stop").get<std::string>());
+        }
+    }
+}
+
+TEST_F(AcoBatchSolverTest, ReportsErrorsPerInstance) {
+    std::stringstream queue;
+    queue << (directory / "missing.json").string() << "\n";
+    queue << write_graph("valid.json", 10) << "\n";
+
+    BatchSolver       solver(make_config());
+    std::stringstream output;
+    EXPECT_EQ(2, solver.run(queue, output));
+
+    auto results = parse_results(output.str());
+    ASSERT_EQ(2, results.size());
+    for (const auto& result : results) {
+        auto instance = result.at("instance").get<std::string>();
+        bool missing = instance.find("missing") != std::string::npos;
+        EXPECT_EQ(missing, result.contains("error"));
+    }
+}
+
+TEST_F(AcoBatchSolverTest, ResultsDoNotDependOnScheduling) {
+    std::stringstream queue;
+    for (int i = 0; i < 6; ++i) {
+        queue << write_graph("graph_" + std::to_string(i) + ".json", 15) << "\n";
+    }
+    auto input = queue.str();
+
+    auto solve = [&](std::size_t threads) {
+        auto config = make_config();
+        config.threads = threads;
+        BatchSolver        solver(config);
+        std::istringstream queue(input);
+        std::stringstream  output;
+        solver.run(queue, output);
+
+        std::map<std::string, int> lengths;
+        for (const auto& result : parse_results(output.str())) {
+            lengths[result.at("instance").get<std::string>()] = result.at("length").get<int>();
+        }
+        return lengths;
+    };
+
+    EXPECT_EQ(solve(1), solve(4));
+}
@@ -0,0 +1,110 @@
+#include <chrono>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <vector>
+
+#include "../../third_party/nlohmann/json.hpp"
+#include "../AcoBenchmark.hpp"
+#include "../AcoGraph.hpp"
+
+using aco::Benchmark;
+using aco::DeviceType;
+using aco::Graph;
+using aco::Profile;
+
+class AcoBenchmarkTest : public ::testing::Test {
+  public:
+    AcoBenchmarkTest() : gen(/*seed=*/42) {}
+
+    static Benchmark::Config make_config() {
+        Profile profile{DeviceType::CPU, 0, /*agents_per_node=*/1, 0, 0.9, 1, 1};
+        return {{profile}, /*seeds=*/3, /*seed=*/1, std::chrono::milliseconds(20),
+                /*target_gap=*/0.0};
+    }
+
+  public:
+    std::mt19937 gen;
+};
+
+TEST_F(AcoBenchmarkTest, ThrowsOnInvalidConfig) {
+    auto config = make_config();
+    config.seeds = 0;
+    EXPECT_THROW(Benchmark{config}, std::invalid_argument);
+
+    config = make_config();
+    config.profiles.clear();
+    EXPECT_THROW(Benchmark{config}, std::invalid_argument);
+
+    config = make_config();
+    config.time_limit = std::chrono::milliseconds(0);
+    EXPECT_THROW(Benchmark{config}, std::invalid_argument);
+}
+
+TEST_F(AcoBenchmarkTest, CurvesAndSummaries) {
+    std::vector<Benchmark::Instance> instances;
+    instances.push_back({"random", Graph(gen, /*nodes=*/15, /*initial_pheromone=*/0.1), 0});
+    instances.push_back(Benchmark::load_instance("burma14.tsp", /*optimum=*/3323,
+                                                 /*initial_pheromone=*/0.1));
+
+    auto               config = make_config();
+    Benchmark          benchmark(config);
+    std::ostringstream log;
+    auto               report = benchmark.run(instances, log);
+
+    ASSERT_EQ(2 * config.seeds, report.runs.size());
+    for (const auto& run : report.runs) {
+        // Curves start at zero and improve over time
+        ASSERT_FALSE(run.curve.empty());
+        EXPECT_EQ(0.0, run.curve.front().seconds);
+        for (std::size_t i = 1; i < run.curve.size(); ++i) {
+            EXPECT_LT(run.curve[i].length, run.curve[i - 1].length);
+            EXPECT_GE(run.curve[i].seconds, run.curve[i - 1].seconds);
+        }
+        EXPECT_GT(run.iterations, 0);
+    }
+
+    ASSERT_EQ(2, report.summaries.size());
+
+    // Without a known optimum, the reference is the best run, which reaches the target for sure
+    const auto& random = report.summaries[0];
+    EXPECT_GE(random.reached, 1);
+    EXPECT_EQ(random.best_length, random.target);
+    EXPECT_TRUE(std::isnan(random.median_gap));
+
+    // With the optimum, gaps are relative to it
+    const auto& burma = report.summaries[1];
+    EXPECT_EQ(3323, burma.target);
+    EXPECT_GE(burma.median_gap, 0.0);
+    EXPECT_NEAR(burma.median_length, 3323 * (1 + burma.median_gap), 1e-6);
+    if (burma.reached < config.seeds) {
+        EXPECT_TRUE(std::isinf(burma.time_to_target_q3));
+    }
+}
+
+TEST_F(AcoBenchmarkTest, WritesCsvAndJson) {
+    std::vector<Benchmark::Instance> instances;
+    instances.push_back({"random", Graph(gen, /*nodes=*/10, /*initial_pheromone=*/0.1), 0});
+
+    Benchmark          benchmark(make_config());
+    std::ostringstream log;
+    auto               report = benchmark.run(instances, log);
+
+    std::ostringstream csv;
+    Benchmark::write_csv(report, csv);
+    std::istringstream csv_lines(csv.str());
+    std::string        header;
+    std::string        line;
+    std::getline(csv_lines, header);
+    std::getline(csv_lines, line);
+    EXPECT_EQ(0, header.find("instance,device"));
+    EXPECT_EQ(0, line.find("random,CPU,1,0,0.9,1,1,3,"));
+
+    std::ostringstream json_output;
+    Benchmark::write_json(report, json_output);
+    auto json = nlohmann::json::parse(json_output.str());
+    EXPECT_EQ("random", json.at("instances").at(0));
+    EXPECT_EQ(3, json.at("runs").size());
+    EXPECT_TRUE(json.at("summaries").at(0).at("median_gap").is_null());
+    EXPECT_FALSE(json.at("runs").at(0).at("curve").empty());
+}
@@ -0,0 +1,207 @@
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "../AcoChoiceInfo.hpp"
+#include "../AcoGraph.hpp"
+#include "../AcoTourBuilder.hpp"
+
+using aco::ChoiceInfo;
+using aco::Graph;
+using aco::TourBuilder;
+
+class AcoChoiceInfoTest : public ::testing::Test {
+  public:
+    AcoChoiceInfoTest() : gen(/*seed=*/42) {}
+
+  public:
+    std::mt19937 gen;
+};
+
+TEST_F(AcoChoiceInfoTest, ValuesMatchTheGraph) {
+    std::size_t nodes = 10;
+    Graph       graph(gen, nodes, /*initial_pheromone=*/0.7);
+    graph.set_pheromone(/*src=*/3, /*dst=*/4, /*value=*/1.9);
+
+    ChoiceInfo choice_info;
+    choice_info.update(graph);
+
+    ASSERT_EQ(nodes, choice_info.get_size());
+    for (Graph::Index i = 0; i < nodes; ++i) {
+        for (Graph::Index j = 0; j < nodes; ++j) {
+            auto expected = i == j ? 0.f : graph.get_pheromone(i, j) / graph.get_cost(i, j);
+            EXPECT_EQ(expected, choice_info.get(i, j));
+        }
+    }
+}
+
+TEST_F(AcoChoiceInfoTest, ExponentsWeightPheromoneAndHeuristic) {
+    std::size_t nodes = 10;
+    Graph       graph(gen, nodes, /*initial_pheromone=*/0.7);
+    graph.set_pheromone(/*src=*/3, /*dst=*/4, /*value=*/1.9);
+
+    ChoiceInfo choice_info;
+    choice_info.set_exponents(/*alpha=*/2, /*beta=*/3);
+    choice_info.update(graph);
+
+    for (Graph::Index i = 0; i < nodes; ++i) {
+        for (Graph::Index j = 0; j < nodes; ++j) {
+            auto expected = i == j ? 0.f
+                                   : std::pow(graph.get_pheromone(i, j), 2.f) *
+                                         std::pow(1.f / graph.get_cost(i, j), 3.f);
+            EXPECT_FLOAT_EQ(expected, choice_info.get(i, j));
+        }
+    }
+}
+
+TEST_F(AcoChoiceInfoTest, UpdateRowsFromOtherPheromones) {
+    std::size_t nodes = 10;
+    Graph       graph(gen, nodes, /*initial_pheromone=*/0.7);
+    Graph       other = graph;
+    other.set_pheromone(/*src=*/3, /*dst=*/4, /*value=*/1.9);
+    other.set_pheromone(/*src=*/8, /*dst=*/1, /*value=*/2.9);
+
+    ChoiceInfo expected;
+    expected.update(other);
+
+    // Row by row, in two halves, with pheromones not taken from the graph
+    std::vector<float> pheromones(nodes * nodes);
+    for (Graph::Index i = 0; i < nodes; ++i) {
+        for (Graph::Index j = 0; j < nodes; ++j) {
+            pheromones[i * nodes + j] = i == j ? 0.f : other.get_pheromone(i, j);
+        }
+    }
+    ChoiceInfo choice_info;
+    choice_info.resize(nodes);
+    choice_info.update_rows(graph, pheromones.data(), 5, nodes);
+    choice_info.update_rows(graph, pheromones.data(), 0, 5);
+
+    for (Graph::Index i = 0; i < nodes; ++i) {
+        for (Graph::Index j = 0; j < nodes; ++j) {
+            EXPECT_EQ(expected.get(i, j), choice_info.get(i, j));
+        }
+    }
+}
+
+TEST_F(AcoChoiceInfoTest, BFloat16WithinTolerance) {
+    std::size_t nodes = 30;
+    Graph       graph(gen, nodes, /*initial_pheromone=*/0.7);
+    graph.set_pheromone(/*src=*/3, /*dst=*/4, /*value=*/1.9);
+
+    ChoiceInfo expected;
+    expected.update(graph);
+    ChoiceInfo choice_info(/*nodes=*/0, aco::Precision::BFloat16);
+    choice_info.update(graph);
+
+    std::vector<float> row(nodes);
+    for (Graph::Index i = 0; i < nodes; ++i) {
+        choice_info.load_row(i, row.data());
+        for (Graph::Index j = 0; j < nodes; ++j) {
+            EXPECT_EQ(choice_info.get(i, j), row[j]);
+            EXPECT_NEAR(expected.get(i, j), row[j], expected.get(i, j) / 256);
+        }
+    }
+
+    // Switching back gives exact values again
+    choice_info.set_precision(aco::Precision::Float);
+    choice_info.update(graph);
+    EXPECT_EQ(expected.get(3, 4), choice_info.get(3, 4));
+}
+
+TEST_F(AcoChoiceInfoTest, AssignThrowsOnIncorrectSize) {
+    ChoiceInfo choice_info;
+    EXPECT_THROW(choice_info.assign(std::vector<float>(10), /*nodes=*/3), std::invalid_argument);
+}
+
+TEST_F(AcoChoiceInfoTest, AssignIgnoresDiagonal) {
+    std::size_t nodes = 3;
+    ChoiceInfo  choice_info;
+    choice_info.assign(std::vector<float>(nodes * nodes, 1.f), nodes);
+
+    for (Graph::Index i = 0; i < nodes; ++i) {
+        for (Graph::Index j = 0; j < nodes; ++j) {
+            EXPECT_EQ(i == j ? 0.f : 1.f, choice_info.get(i, j));
+        }
+    }
+}
+
+TEST_F(AcoChoiceInfoTest, SampleFollowsTheScores) {
+    // Scores from city 0: city 1 is three times more desired than city 2, city 3 is never chosen
+    std::size_t        nodes = 4;
+    std::vector<float> values = {0, 3, 1, 0, //
+                                 1, 0, 1, 1, //
+                                 1, 1, 0, 1, //
+                                 1, 1, 1, 0};
+    ChoiceInfo         choice_info;
+    choice_info.assign(values, nodes);
+
+    std::vector<int> counts(nodes);
+    const int        samples = 10000;
+    for (int i = 0; i < samples; ++i) {
+        ++counts.at(choice_info.sample(/*src=*/0, gen));
+    }
+
+    EXPECT_EQ(0, counts[0]);
+    EXPECT_EQ(0, counts[3]);
+    EXPECT_NEAR(0.75, counts[1] / float(samples), 0.02);
+    EXPECT_NEAR(0.25, counts[2] / float(samples), 0.02);
+}
+
+TEST_F(AcoChoiceInfoTest, TourBuilderBuildsValidTours) {
+    std::size_t nodes = 50;
+    Graph       graph(gen, nodes, /*initial_pheromone=*/0.1);
+
+    ChoiceInfo choice_info;
+    choice_info.update(graph);
+
+    TourBuilder       builder(nodes);
+    TourBuilder::Path path;
+    for (Graph::Index start = 0; start < nodes; ++start) {
+        builder.build(choice_info, start, gen, path);
+
+        ASSERT_EQ(nodes, path.size());
+        EXPECT_EQ(start, path.front());
+
+        // Every city visited exactly once
+        std::sort(begin(path), end(path));
+        for (Graph::Index i = 0; i < nodes; ++i) {
+            EXPECT_EQ(i, path[i]);
+        }
+    }
+}
+
+TEST_F(AcoChoiceInfoTest, TourBuilderGivesUpOverTheLimit) {
+    std::size_t nodes = 30;
+    Graph       graph(gen, nodes, /*initial_pheromone=*/0.1);
+
+    ChoiceInfo choice_info;
+    choice_info.update(graph);
+    std::vector<int> nearest_costs;
+    graph.nearest_costs(nearest_costs);
+    auto lower_bound = std::accumulate(begin(nearest_costs), end(nearest_costs), std::int64_t(0));
+
+    TourBuilder       builder(nodes);
+    TourBuilder::Path path(nodes);
+    for (Graph::Index start = 0; start < nodes; ++start) {
+        // No tour is shorter than the bound
+        EXPECT_FALSE(builder.build_bounded(choice_info, graph, nearest_costs, lower_bound - 1,
+                                           start, gen, path.data()));
+
+        // Any tour fits, and it's complete
+        EXPECT_TRUE(builder.build_bounded(choice_info, graph, nearest_costs,
+                                          std::numeric_limits<std::int64_t>::max() / 2, start, gen,
+                                          path.data()));
+        EXPECT_EQ(start, path.front());
+        auto length = graph.path_length(path);
+        EXPECT_GE(length, lower_bound);
+
+        // Tours which are built are never longer than the limit
+        if (builder.build_bounded(choice_info, graph, nearest_costs, length, start, gen,
+                                  path.data())) {
+            EXPECT_LE(graph.path_length(path), length);
+        }
+    }
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+#include "../AcoCostMatrix.hpp"
+#include "../AcoGraph.hpp"
+#include "../AcoSparseGraph.hpp"
+
+using aco::CostMatrixBuilder;
+using aco::SparseGraph;
+
+// Random two-way grid of 'side' x 'side' nodes, with some of the roads one-way
+static SparseGraph make_grid(std::mt19937& gen, std::size_t side) {
+    std::uniform_int_distribution<> cost(1, 20);
+    std::bernoulli_distribution     one_way(0.2);
+    std::vector<SparseGraph::Edge>  edges;
+    for (std::size_t row = 0; row < side; ++row) {
+        for (std::size_t column = 0; column < side; ++column) {
+            auto node = row * side + column;
+            for (auto neighbour : {column + 1 < side ? node + 1 : node,
+                                   row + 1 < side ? node + side : node}) {
+                if (neighbour == node) {
+                    continue;
+                }
+                auto forward = cost(gen);
+                edges.push_back({node, neighbour, forward});
+                if (!one_way(gen)) {
+                    edges.push_back({neighbour, node, forward});
+                }
+            }
+        }
+    }
+    return SparseGraph(side * side, std::move(edges), /*initial_pheromone=*/0.01);
+}
+
+// Bellman-Ford, slow but simple
+static std::vector<std::int64_t> reference_distances(const SparseGraph& network,
+                                                     SparseGraph::Index source) {
+    std::vector<std::int64_t> result(network.get_size(), -1);
+    result[source] = 0;
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (std::size_t node = 0; node < network.get_size(); ++node) {
+            if (result[node] < 0) {
+                continue;
+            }
+            for (auto edge = network.edges_begin(node); edge < network.edges_end(node); ++edge) {
+                auto target = network.get_target(edge);
+                auto candidate = result[node] + network.get_cost(edge);
+                if (result[target] < 0 || candidate < result[target]) {
+                    result[target] = candidate;
+                    changed = true;
+                }
+            }
+        }
+    }
+    return result;
+}
+
+TEST(AcoCostMatrixTest, CostsAreShortestPaths) {
+    std::mt19937 gen(/*seed=*/42);
+    auto         network = make_grid(gen, /*side=*/20);
+
+    // Every node of the grid is still reachable through the two-way roads, unless it is a corner
+    // cut off by one-way roads, so the stops are checked against the reference first
+    std::vector<SparseGraph::Index> candidates{0, 17, 45, 123, 200, 201, 311, 399};
+    std::vector<SparseGraph::Index> stops;
+    for (auto candidate : candidates) {
+        bool connected = true;
+        for (auto other : candidates) {
+            connected = connected && reference_distances(network, candidate)[other] >= 0 &&
+                        reference_distances(network, other)[candidate] >= 0;
+        }
+        if (connected) {
+            stops.push_back(candidate);
+        }
+    }
+    ASSERT_GE(stops.size(), 4);
+
+    for (std::size_t threads : {1, 3}) {
+        auto graph = CostMatrixBuilder(network, threads).build(stops, /*initial_pheromone=*/0.02);
+        ASSERT_EQ(stops.size(), graph.get_size());
+        for (std::size_t i = 0; i < stops.size(); ++i) {
+            auto expected = reference_distances(network, stops[i]);
+            for (std::size_t j = 0; j < stops.size(); ++j) {
+                if (i != j) {
+                    EXPECT_EQ(expected[stops[j]], graph.get_cost(i, j))
+                        << "threads: " << threads << ", stops: " << i << " -> " << j;
+                    EXPECT_FLOAT_EQ(0.02f, graph.get_pheromone(i, j));
+                }
+            }
+        }
+    }
+}
+
+TEST(AcoCostMatrixTest, OneWayRoadsAndSharedNodes) {
+    // 0 -> 1 -> 2 -> 0 one-way ring, and a two-way road 2 - 3
+    SparseGraph       network(4, {{0, 1, 5}, {1, 2, 7}, {2, 0, 11}, {2, 3, 2}, {3, 2, 2}}, 0.01);
+    CostMatrixBuilder builder(network, /*threads=*/2);
+
+    auto graph = builder.build({0, 1, 3, 0}, /*initial_pheromone=*/0.01);
+    EXPECT_EQ(5, graph.get_cost(0, 1));
+    EXPECT_EQ(18, graph.get_cost(1, 0));
+    EXPECT_EQ(14, graph.get_cost(0, 2));
+    EXPECT_EQ(13, graph.get_cost(2, 0));
+
+    // Two stops at node 0
+    EXPECT_EQ(1, graph.get_cost(0, 3));
+    EXPECT_EQ(1, graph.get_cost(3, 0));
+    EXPECT_EQ(5, graph.get_cost(3, 1));
+}
+
+TEST(AcoCostMatrixTest, InvalidStops) {
+    SparseGraph       network(3, {{0, 1, 5}, {1, 0, 5}, {1, 2, 1}}, 0.01);
+    CostMatrixBuilder builder(network);
+
+    EXPECT_THROW(builder.build({0, 3}, 0.01), std::invalid_argument);
+    // Nothing leaves node 2
+    EXPECT_THROW(builder.build({0, 2}, 0.01), std::invalid_argument);
+    EXPECT_EQ(2, builder.build({0, 1}, 0.01).get_size());
+}
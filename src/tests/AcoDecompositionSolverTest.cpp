@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+#include "../AcoAlgorithm.hpp"
+#include "../AcoDecompositionSolver.hpp"
+
+using aco::DecompositionSolver;
+using aco::DeviceType;
+using aco::Point;
+
+class AcoDecompositionSolverTest : public ::testing::Test {
+  public:
+    AcoDecompositionSolverTest() : gen(/*seed=*/42) {
+        config.device = DeviceType::CPU;
+        config.threads = 2;
+        config.cluster_size = 40;
+        config.agents_per_node = 1;
+        config.pheromone_evaporation = 0.9;
+        config.budget.max_iterations = 10;
+        config.rounds = 3;
+        config.seed = 7;
+    }
+
+    std::vector<Point> random_points(std::size_t count) {
+        std::uniform_real_distribution<double> coordinate(0, 1000);
+        std::vector<Point>                     points(count);
+        for (auto& point : points) {
+            point = {coordinate(gen), coordinate(gen)};
+        }
+        return points;
+    }
+
+    // Every index exactly once
+    void validate_path(std::size_t nodes, aco::Graph::Path path) {
+        ASSERT_EQ(nodes, path.size());
+        std::sort(begin(path), end(path));
+        for (std::size_t i = 0; i < nodes; ++i) {
+            ASSERT_EQ(i, path[i]);
+        }
+    }
+
+  public:
+    std::mt19937                gen;
+    DecompositionSolver::Config config;
+};
+
+TEST_F(AcoDecompositionSolverTest, ThrowsOnInvalidArguments) {
+    auto invalid = config;
+    invalid.cluster_size = 2;
+    EXPECT_THROW(DecompositionSolver{invalid}, std::invalid_argument);
+
+    invalid = config;
+    invalid.rounds = 0;
+    EXPECT_THROW(DecompositionSolver{invalid}, std::invalid_argument);
+
+    invalid = config;
+    invalid.budget = {};
+    EXPECT_THROW(DecompositionSolver{invalid}, std::invalid_argument);
+
+    EXPECT_THROW(DecompositionSolver(config).solve(random_points(2)), std::invalid_argument);
+}
+
+TEST_F(AcoDecompositionSolverTest, SolvesAllCitiesAndImprovesEveryRound) {
+    auto points = random_points(500);
+    auto result = DecompositionSolver(config).solve(points);
+
+    validate_path(points.size(), result.path);
+    EXPECT_EQ(13u, result.clusters);
+    EXPECT_EQ(DecompositionSolver::tour_length(points, result.path), result.length);
+    ASSERT_EQ(config.rounds, result.round_lengths.size());
+    for (std::size_t round = 1; round < result.round_lengths.size(); ++round) {
+        EXPECT_LE(result.round_lengths[round], result.round_lengths[round - 1]);
+    }
+}
+
+TEST_F(AcoDecompositionSolverTest, SameResultWithAnyThreads) {
+    auto points = random_points(300);
+    auto result = DecompositionSolver(config).solve(points);
+
+    config.threads = 1;
+    EXPECT_EQ(result.path, DecompositionSolver(config).solve(points).path);
+}
+
+TEST_F(AcoDecompositionSolverTest, FindsGoodTourOnGrid) {
+    // 20 x 20 cities, 10 apart. The optimal tour goes between neighbours only.
+    std::vector<Point> points;
+    for (int x = 0; x < 20; ++x) {
+        for (int y = 0; y < 20; ++y) {
+            points.push_back({x * 10.0, y * 10.0});
+        }
+    }
+
+    auto result = DecompositionSolver(config).solve(points);
+    validate_path(points.size(), result.path);
+    EXPECT_LE(result.length, 4000 * 1.1);
+}
@@ -0,0 +1,116 @@
+#include <cmath>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <vector>
+
+#include "../AcoDiagnostics.hpp"
+#include "../AcoGraph.hpp"
+
+using aco::Diagnostics;
+using aco::Graph;
+
+class AcoDiagnosticsTest : public ::testing::Test {
+  public:
+    AcoDiagnosticsTest() : gen(/*seed=*/42) {}
+
+  public:
+    std::mt19937 gen;
+};
+
+TEST_F(AcoDiagnosticsTest, UniformPheromonesAreNotConverged) {
+    std::size_t nodes = 10;
+    Graph       graph(gen, nodes, /*initial_pheromone=*/0.5);
+
+    EXPECT_DOUBLE_EQ(nodes - 1, Diagnostics::branching_factor(graph, 3, /*lambda=*/0.05f));
+    EXPECT_NEAR(1.0, Diagnostics::entropy(graph, 3), 1e-6);
+}
+
+TEST_F(AcoDiagnosticsTest, TourPheromonesAreConverged) {
+    // Pheromones of a single tour, left both ways
+    std::size_t nodes = 10;
+    Graph       graph(gen, nodes, /*initial_pheromone=*/0.01);
+    for (Graph::Index i = 0; i < nodes; ++i) {
+        graph.add_pheromone_two_way(i, (i + 1) % nodes, 100);
+    }
+
+    for (Graph::Index i = 0; i < nodes; ++i) {
+        EXPECT_DOUBLE_EQ(2, Diagnostics::branching_factor(graph, i, /*lambda=*/0.05f));
+        EXPECT_LT(Diagnostics::entropy(graph, i), 0.4);
+    }
+
+    // Sampled rows rotate, so any number of samples measures the same
+    Diagnostics diagnostics;
+    for (std::size_t samples = 1; samples <= 2 * nodes; ++samples) {
+        auto snapshot = diagnostics.measure(graph, nullptr, 0, samples);
+        EXPECT_DOUBLE_EQ(2, snapshot.branching_factor);
+        EXPECT_TRUE(std::isnan(snapshot.diversity));
+    }
+}
+
+TEST_F(AcoDiagnosticsTest, LoadsOnlyTheSampledRows) {
+    std::size_t nodes = 10;
+    Graph       graph(gen, nodes, /*initial_pheromone=*/0.5);
+
+    std::vector<Graph::Index> loaded;
+    auto                      load_row = [&](Graph::Index row, float* values) {
+        loaded.push_back(row);
+        for (Graph::Index j = 0; j < nodes; ++j) {
+            values[j] = j != row ? graph.get_pheromone(row, j) : 0.f;
+        }
+    };
+
+    Diagnostics diagnostics;
+    auto        snapshot = diagnostics.measure(nodes, load_row, nullptr, 0, /*samples=*/3);
+    EXPECT_DOUBLE_EQ(nodes - 1, snapshot.branching_factor);
+    EXPECT_EQ((std::vector<Graph::Index>{0, 1, 2}), loaded);
+
+    // The next call continues with the following rows
+    loaded.clear();
+    diagnostics.measure(nodes, load_row, nullptr, 0, /*samples=*/3);
+    EXPECT_EQ((std::vector<Graph::Index>{3, 4, 5}), loaded);
+}
+
+TEST_F(AcoDiagnosticsTest, EdgeDistanceOfTours) {
+    std::size_t               nodes = 8;
+    std::vector<Graph::Index> a(nodes);
+    std::iota(begin(a), end(a), 0);
+
+    // The same tour, from another node and in the other direction
+    std::vector<Graph::Index> b{3, 2, 1, 0, 7, 6, 5, 4};
+    Diagnostics               diagnostics;
+    EXPECT_DOUBLE_EQ(0, diagnostics.distance(a.data(), a.data(), nodes));
+    EXPECT_DOUBLE_EQ(0, diagnostics.distance(a.data(), b.data(), nodes));
+
+    // Two neighbours swapped: edges 1-2, 3-4 replaced by 1-3, 2-4
+    std::vector<Graph::Index> c{0, 1, 3, 2, 4, 5, 6, 7};
+    EXPECT_DOUBLE_EQ(2.0 / nodes, diagnostics.distance(a.data(), c.data(), nodes));
+
+    // No common edge
+    std::vector<Graph::Index> d{0, 2, 4, 6, 1, 7, 5, 3};
+    EXPECT_DOUBLE_EQ(1, diagnostics.distance(a.data(), d.data(), nodes));
+}
+
+TEST_F(AcoDiagnosticsTest, DiversityOfTours) {
+    std::size_t nodes = 8;
+    Graph       graph(gen, nodes, /*initial_pheromone=*/0.5);
+
+    // Four copies of the same tour
+    std::vector<Graph::Index> tours(4 * nodes);
+    for (std::size_t i = 0; i < tours.size(); ++i) {
+        tours[i] = i % nodes;
+    }
+    Diagnostics diagnostics;
+    EXPECT_DOUBLE_EQ(0, diagnostics.measure(graph, tours.data(), 4, /*samples=*/3).diversity);
+
+    // Tours are paired with those half of the tours apart, which now don't share any edge
+    std::vector<Graph::Index> other{0, 2, 4, 6, 1, 7, 5, 3};
+    std::copy(begin(other), end(other), begin(tours) + 2 * nodes);
+    std::copy(begin(other), end(other), begin(tours) + 3 * nodes);
+    EXPECT_DOUBLE_EQ(1, diagnostics.measure(graph, tours.data(), 4, /*samples=*/3).diversity);
+
+    // Nothing to measure
+    auto snapshot = diagnostics.measure(graph, tours.data(), 1, /*samples=*/3);
+    EXPECT_TRUE(std::isnan(snapshot.diversity));
+    EXPECT_FALSE(std::isnan(snapshot.entropy));
+    EXPECT_TRUE(std::isnan(diagnostics.measure(graph, tours.data(), 4, 0).branching_factor));
+}
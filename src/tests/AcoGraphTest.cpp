@@ -1,4 +1,8 @@
+#include <algorithm>
+#include <fstream>
 #include <gtest/gtest.h>
+#include <numeric>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -219,6 +223,176 @@ TEST_F(AcoGraphTest, UpdateAllShouldNotGoBelowInitial) {
     }
 }
 
+TEST_F(AcoGraphTest, UpdateAllWithDeposits) {
+    // Initialize
+    std::size_t nodes = 10;
+    float       initial_pheromone = 0.7;
+    Graph       graph(gen, nodes, initial_pheromone);
+    graph.set_pheromone(/*src=*/5, /*dst=*/2, /*value=*/1.9);
+
+    // The same deposits, one by one, and in a single pass
+    float              update_coefficient = 0.9;
+    Graph              expected = graph;
+    aco::DepositBuffer deposits;
+    expected.update_all(update_coefficient);
+    for (Graph::Index i = 0; i < nodes; ++i) {
+        auto j = (i * 3 + 1) % nodes;
+        if (i != j) {
+            expected.add_pheromone_two_way(i, j, 0.1f * i);
+            deposits.add_two_way(i, j, 0.1f * i);
+        }
+    }
+    graph.update_all(update_coefficient, deposits);
+
+    EXPECT_EQ(expected, graph);
+}
+
+TEST_F(AcoGraphTest, UpdateAllWithDepositsThrowsOnInvalidArguments) {
+    std::size_t nodes = 10;
+    Graph       graph(gen, nodes, /*initial_pheromone=*/1);
+
+    aco::DepositBuffer deposits;
+    deposits.add_two_way(0, nodes, 0.7);
+    EXPECT_THROW(graph.update_all(0.9, deposits), std::invalid_argument);
+}
+
+TEST_F(AcoGraphTest, AddNode) {
+    std::size_t nodes = 10;
+    Graph       graph(gen, nodes, /*initial_pheromone=*/1);
+    graph.set_pheromone(3, 4, 2.5);
+    auto original = graph;
+
+    std::vector<int> costs(nodes);
+    std::iota(begin(costs), end(costs), 1);
+    EXPECT_EQ(nodes, graph.add_node(costs));
+    ASSERT_EQ(nodes + 1, graph.get_size());
+
+    // Existing edges are untouched
+    for (int i = 0; i < nodes; ++i) {
+        for (int j = 0; j < nodes; ++j) {
+            if (i != j) {
+                EXPECT_EQ(original.get_cost(i, j), graph.get_cost(i, j));
+                EXPECT_EQ(original.get_pheromone(i, j), graph.get_pheromone(i, j));
+            }
+        }
+    }
+
+    // New edges in both directions
+    for (int i = 0; i < nodes; ++i) {
+        EXPECT_EQ(costs[i], graph.get_cost(i, nodes));
+        EXPECT_EQ(costs[i], graph.get_cost(nodes, i));
+        EXPECT_EQ(1, graph.get_pheromone(i, nodes));
+        EXPECT_EQ(1, graph.get_pheromone(nodes, i));
+    }
+}
+
+TEST_F(AcoGraphTest, RemoveNode) {
+    std::size_t nodes = 10;
+    Graph       graph(gen, nodes, /*initial_pheromone=*/1);
+    graph.set_pheromone(3, 4, 2.5);
+    auto original = graph;
+
+    graph.remove_node(2);
+    ASSERT_EQ(nodes - 1, graph.get_size());
+    for (int i = 0; i < nodes - 1; ++i) {
+        for (int j = 0; j < nodes - 1; ++j) {
+            if (i != j) {
+                auto src = i < 2 ? i : i + 1;
+                auto dst = j < 2 ? j : j + 1;
+                EXPECT_EQ(original.get_cost(src, dst), graph.get_cost(i, j));
+                EXPECT_EQ(original.get_pheromone(src, dst), graph.get_pheromone(i, j));
+            }
+        }
+    }
+
+    // Removing and adding back the last node gives the same graph
+    auto last = graph;
+    std::vector<int> costs;
+    for (int i = 0; i < nodes - 2; ++i) {
+        costs.push_back(graph.get_cost(i, nodes - 2));
+    }
+    graph.remove_node(nodes - 2);
+    graph.add_node(costs);
+    EXPECT_EQ(last, graph);
+}
+
+TEST_F(AcoGraphTest, SetCost) {
+    std::size_t nodes = 10;
+    Graph       graph(gen, nodes, /*initial_pheromone=*/1);
+    auto        reverse = graph.get_cost(4, 3);
+
+    graph.set_cost(3, 4, 123);
+    EXPECT_EQ(123, graph.get_cost(3, 4));
+    EXPECT_EQ(reverse, graph.get_cost(4, 3));
+}
+
+TEST_F(AcoGraphTest, DynamicChangesThrowOnInvalidArguments) {
+    std::size_t nodes = 10;
+    Graph       graph(gen, nodes, /*initial_pheromone=*/1);
+
+    EXPECT_THROW(graph.add_node(std::vector<int>(nodes - 1, 1)), std::invalid_argument);
+    EXPECT_THROW(graph.add_node(std::vector<int>(nodes, 0)), std::invalid_argument);
+    EXPECT_THROW(graph.remove_node(nodes), std::invalid_argument);
+    EXPECT_THROW(graph.set_cost(0, 0, 1), std::invalid_argument);
+    EXPECT_THROW(graph.set_cost(0, nodes, 1), std::invalid_argument);
+    EXPECT_THROW(graph.set_cost(0, 1, 0), std::invalid_argument);
+    EXPECT_EQ(nodes, graph.get_size());
+}
+
+TEST_F(AcoGraphTest, PathLength) {
+    std::size_t nodes = 10;
+    Graph       graph(gen, nodes, /*initial_pheromone=*/1);
+
+    Graph::Path path(nodes);
+    std::iota(begin(path), end(path), 0);
+    std::shuffle(begin(path), end(path), gen);
+
+    std::int64_t expected = 0;
+    for (std::size_t i = 0; i < nodes; ++i) {
+        expected += graph.get_cost(path[i], path[(i + 1) % nodes]);
+    }
+
+    EXPECT_EQ(expected, graph.path_length(path));
+}
+
+TEST_F(AcoGraphTest, PathLengthsMatchSinglePaths) {
+    std::size_t nodes = 10;
+    std::size_t count = 25;
+    Graph       graph(gen, nodes, /*initial_pheromone=*/1);
+
+    // Flat buffer of shuffled paths
+    std::vector<Graph::Index> paths;
+    std::vector<std::int64_t> expected;
+    for (std::size_t i = 0; i < count; ++i) {
+        Graph::Path path(nodes);
+        std::iota(begin(path), end(path), 0);
+        std::shuffle(begin(path), end(path), gen);
+        paths.insert(end(paths), begin(path), end(path));
+        expected.push_back(graph.path_length(path));
+    }
+
+    for (std::size_t threads : {1, 3, 100}) {
+        EXPECT_EQ(expected, graph.path_lengths(paths, threads)) << "Threads: " << threads;
+    }
+}
+
+TEST_F(AcoGraphTest, PathLengthThrowsOnInvalidArguments) {
+    std::size_t nodes = 10;
+    Graph       graph(gen, nodes, /*initial_pheromone=*/1);
+
+    Graph::Path path(nodes);
+    std::iota(begin(path), end(path), 0);
+
+    // Incorrect sizes
+    EXPECT_THROW(graph.path_length(Graph::Path(nodes - 1)), std::invalid_argument);
+    EXPECT_THROW(graph.path_lengths(Graph::Path(nodes + 1)), std::invalid_argument);
+
+    // Index out of bounds
+    path.back() = nodes;
+    EXPECT_THROW(graph.path_length(path), std::invalid_argument);
+    EXPECT_THROW(graph.path_lengths(path), std::invalid_argument);
+}
+
 TEST_F(AcoGraphTest, SerializeDeserialize) {
     // Create graph, change some pheromone values
     std::size_t nodes = 10;
@@ -302,4 +476,97 @@ TEST_F(AcoGraphTest, DeserializeThrowsOnIncorrectVectorSizes3) {
 
     // Expect it throws
     EXPECT_THROW(Graph::from_string(json.dump()), std::invalid_argument);
-}
\ No newline at end of file
+}
+
+TEST_F(AcoGraphTest, FromTsplibCoordinates) {
+    auto make = [](const std::string& type) {
+        return "NAME: test\nTYPE: TSP\nDIMENSION: 3\nEDGE_WEIGHT_TYPE: " + type +
+               "\nNODE_COORD_SECTION\n1 0 0\n2 3 4\n3 0.5 0\nEOF\n";
+    };
+
+    auto euclidean = Graph::from_tsplib(make("EUC_2D"), /*initial_pheromone=*/0.1);
+    ASSERT_EQ(3, euclidean.get_size());
+    EXPECT_EQ(5, euclidean.get_cost(0, 1));
+    EXPECT_EQ(5, euclidean.get_cost(1, 0));
+    EXPECT_EQ(1, euclidean.get_cost(0, 2)); // 0.5 rounds to 1 (and costs are at least 1 anyway)
+    EXPECT_EQ(0.1f, euclidean.get_pheromone(0, 1));
+
+    auto ceiling = Graph::from_tsplib(make("CEIL_2D"), /*initial_pheromone=*/0.1);
+    EXPECT_EQ(5, ceiling.get_cost(0, 1));
+    EXPECT_EQ(5, ceiling.get_cost(1, 2)); // sqrt(6.25 + 16) = 4.72
+
+    // sqrt(25 / 10) = 1.58, rounded up
+    auto att = Graph::from_tsplib(make("ATT"), /*initial_pheromone=*/0.1);
+    EXPECT_EQ(2, att.get_cost(0, 1));
+}
+
+TEST_F(AcoGraphTest, FromTsplibExplicitFormats) {
+    // The same symmetric matrix in every supported format
+    const std::vector<std::pair<std::string, std::string>> formats = {
+        {"FULL_MATRIX", "0 1 2 3\n1 0 4 5\n2 4 0 6\n3 5 6 0"},
+        {"UPPER_ROW", "1 2 3\n4 5\n6"},
+        {"UPPER_DIAG_ROW", "0 1 2 3\n0 4 5\n0 6\n0"},
+        {"LOWER_ROW", "1\n2 4\n3 5 6"},
+        {"LOWER_DIAG_ROW", "0\n1 0\n2 4 0\n3 5 6 0"},
+    };
+    for (const auto& format : formats) {
+        auto graph = Graph::from_tsplib("TYPE: TSP\nDIMENSION: 4\nEDGE_WEIGHT_TYPE: EXPLICIT\n"
+                                        "EDGE_WEIGHT_FORMAT: " +
+                                            format.first + "\nEDGE_WEIGHT_SECTION\n" +
+                                            format.second + "\nEOF\n",
+                                        /*initial_pheromone=*/0.1);
+        ASSERT_EQ(4, graph.get_size()) << format.first;
+        EXPECT_EQ(1, graph.get_cost(0, 1)) << format.first;
+        EXPECT_EQ(3, graph.get_cost(3, 0)) << format.first;
+        EXPECT_EQ(5, graph.get_cost(1, 3)) << format.first;
+        EXPECT_EQ(6, graph.get_cost(3, 2)) << format.first;
+    }
+}
+
+// burma14 from TSPLIB, its optimal tour is known
+TEST_F(AcoGraphTest, FromTsplibFile) {
+    std::ifstream file("burma14.tsp");
+    std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    auto        graph = Graph::from_tsplib(contents, /*initial_pheromone=*/0.1);
+
+    ASSERT_EQ(14, graph.get_size());
+    Graph::Path optimal = {0, 1, 13, 2, 3, 4, 5, 11, 6, 12, 7, 10, 8, 9};
+    EXPECT_EQ(3323, graph.path_length(optimal));
+}
+
+TEST_F(AcoGraphTest, FromTsplibThrowsOnInvalidInput) {
+    // Unsupported problem, edge weight type and format
+    EXPECT_THROW(Graph::from_tsplib("TYPE: ATSP\nDIMENSION: 2\n", 0.1), std::invalid_argument);
+    EXPECT_THROW(Graph::from_tsplib("DIMENSION: 2\nEDGE_WEIGHT_TYPE: MAN_2D\n"
+                                    "NODE_COORD_SECTION\n1 0 0\n2 1 1\n",
+                                    0.1),
+                 std::invalid_argument);
+    EXPECT_THROW(Graph::from_tsplib("DIMENSION: 2\nEDGE_WEIGHT_TYPE: EXPLICIT\n"
+                                    "EDGE_WEIGHT_FORMAT: UPPER_COL\nEDGE_WEIGHT_SECTION\n1\n",
+                                    0.1),
+                 std::invalid_argument);
+
+    // Missing or truncated data
+    EXPECT_THROW(Graph::from_tsplib("DIMENSION: 2\nEDGE_WEIGHT_TYPE: EUC_2D\n", 0.1),
+                 std::invalid_argument);
+    EXPECT_THROW(Graph::from_tsplib("DIMENSION: 3\nEDGE_WEIGHT_TYPE: EUC_2D\n"
+                                    "NODE_COORD_SECTION\n1 0 0\n2 1 1\n",
+                                    0.1),
+                 std::invalid_argument);
+    EXPECT_THROW(Graph::from_tsplib("NODE_COORD_SECTION\n1 0 0\n2 1 1\n", 0.1),
+                 std::invalid_argument);
+    EXPECT_THROW(Graph::from_tsplib("DIMENSION: many\n", 0.1), std::invalid_argument);
+}
+
+TEST_F(AcoGraphTest, NearestCosts) {
+    auto graph = Graph::from_points({{0, 0}, {3, 4}, {0, 1}, {10, 0}}, /*initial_pheromone=*/0.1);
+
+    std::vector<int> nearest;
+    graph.nearest_costs(nearest);
+    EXPECT_EQ((std::vector<int>{1, 4, 1, 8}), nearest);
+
+    // Asymmetric, only the leaving edges count
+    graph.set_cost(3, 1, 2);
+    graph.nearest_costs(nearest);
+    EXPECT_EQ((std::vector<int>{1, 4, 1, 2}), nearest);
+}
@@ -0,0 +1,147 @@
+#include <cmath>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "../AcoDepositBuffer.hpp"
+#include "../AcoKernels.hpp"
+
+using aco::DepositBuffer;
+using aco::kernels::Isa;
+
+class AcoKernelsTest : public ::testing::TestWithParam<Isa> {
+  public:
+    AcoKernelsTest() : gen(/*seed=*/42) {}
+
+  public:
+    std::mt19937 gen;
+};
+
+// Every size from empty to a few vector widths, to cover the remainders
+TEST_P(AcoKernelsTest, EvaporateMatchesScalar) {
+    auto isa = GetParam();
+    if (!aco::kernels::is_supported(isa)) {
+        GTEST_SKIP() << "Instruction set not supported: " << isa;
+    }
+
+    std::uniform_real_distribution<float> distrib(0, 2);
+    for (std::size_t size = 0; size < 70; ++size) {
+        std::vector<float> data(size);
+        std::generate(begin(data), end(data), [&] { return distrib(gen); });
+
+        auto expected = data;
+        aco::kernels::evaporate(Isa::Scalar, expected.data(), size, /*coefficient=*/0.9,
+                                /*min_value=*/0.5);
+        aco::kernels::evaporate(isa, data.data(), size, /*coefficient=*/0.9, /*min_value=*/0.5);
+
+        EXPECT_EQ(expected, data) << "Size: " << size;
+    }
+}
+
+TEST_P(AcoKernelsTest, EvaporateDoesNotTouchMemoryOutsideRange) {
+    auto isa = GetParam();
+    if (!aco::kernels::is_supported(isa)) {
+        GTEST_SKIP() << "Instruction set not supported: " << isa;
+    }
+
+    std::vector<float> data(40, 1.f);
+    aco::kernels::evaporate(isa, data.data() + 3, 33, /*coefficient=*/0.5, /*min_value=*/0.1);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        auto expected = i >= 3 && i < 36 ? 0.5f : 1.f;
+        EXPECT_EQ(expected, data[i]) << "Index: " << i;
+    }
+}
+
+// Random permutations of every size up to a few vector widths, to cover the remainders
+TEST_P(AcoKernelsTest, TourLengthMatchesScalar) {
+    auto isa = GetParam();
+    if (!aco::kernels::is_supported(isa)) {
+        GTEST_SKIP() << "Instruction set not supported: " << isa;
+    }
+
+    std::uniform_int_distribution<> distrib(1, 1000);
+    for (std::size_t nodes = 1; nodes < 20; ++nodes) {
+        std::vector<int> costs(nodes * nodes);
+        std::generate(begin(costs), end(costs), [&] { return distrib(gen); });
+        std::vector<std::size_t> tour(nodes);
+        std::iota(begin(tour), end(tour), 0);
+        std::shuffle(begin(tour), end(tour), gen);
+
+        std::int64_t expected = 0;
+        for (std::size_t i = 0; i < nodes; ++i) {
+            expected += costs[tour[i] * nodes + tour[(i + 1) % nodes]];
+        }
+
+        EXPECT_EQ(expected, aco::kernels::tour_length(isa, costs.data(), nodes, tour.data()))
+            << "Nodes: " << nodes;
+    }
+}
+
+TEST_P(AcoKernelsTest, BFloat16MatchesScalar) {
+    auto isa = GetParam();
+    if (!aco::kernels::is_supported(isa)) {
+        GTEST_SKIP() << "Instruction set not supported: " << isa;
+    }
+
+    // Wide range of magnitudes, including ties that round to even
+    std::uniform_real_distribution<float> distrib(-30, 30);
+    for (std::size_t size = 0; size < 70; ++size) {
+        std::vector<float> data(size);
+        std::generate(begin(data), end(data), [&] { return std::exp2(distrib(gen)); });
+        if (size > 2) {
+            data[0] = 0.f;
+            data[1] = 1.f + 1.f / 256; // Exactly halfway between two bfloat16 values
+        }
+
+        std::vector<std::uint16_t> expected(size);
+        std::vector<std::uint16_t> compact(size);
+        aco::kernels::to_bfloat16(Isa::Scalar, data.data(), expected.data(), size);
+        aco::kernels::to_bfloat16(isa, data.data(), compact.data(), size);
+        EXPECT_EQ(expected, compact) << "Size: " << size;
+
+        std::vector<float> restored(size);
+        aco::kernels::from_bfloat16(isa, compact.data(), restored.data(), size);
+        for (std::size_t i = 0; i < size; ++i) {
+            EXPECT_EQ(aco::kernels::from_bfloat16(expected[i]), restored[i]);
+            EXPECT_LE(std::abs(restored[i] - data[i]), std::ldexp(data[i], -8)) << data[i];
+        }
+        if (size > 2) {
+            EXPECT_EQ(0.f, restored[0]);
+            EXPECT_EQ(1.f, restored[1]);
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(AcoKernelsTest, AcoKernelsTest,
+                         testing::Values(Isa::Scalar, Isa::Avx2, Isa::Avx512));
+
+TEST(AcoDepositBufferTest, GroupsByRowInOrderOfAddition) {
+    DepositBuffer deposits;
+    deposits.add_two_way(2, 0, 1.f);
+    deposits.add_two_way(1, 2, 2.f);
+    deposits.add_two_way(0, 2, 3.f);
+    deposits.group_by_row(/*nodes=*/3);
+
+    EXPECT_EQ(6, deposits.size());
+    auto row = [&](std::size_t i) {
+        std::vector<std::pair<std::uint32_t, float>> result;
+        for (auto entry = deposits.row_begin(i); entry != deposits.row_end(i); ++entry) {
+            result.emplace_back(entry->dst, entry->amount);
+        }
+        return result;
+    };
+
+    using Row = std::vector<std::pair<std::uint32_t, float>>;
+    EXPECT_EQ(Row({{2, 1.f}, {2, 3.f}}), row(0));
+    EXPECT_EQ(Row({{2, 2.f}}), row(1));
+    EXPECT_EQ(Row({{0, 1.f}, {1, 2.f}, {0, 3.f}}), row(2));
+}
+
+TEST(AcoDepositBufferTest, ThrowsOnInvalidEdges) {
+    for (auto edge : {std::make_pair(0, 3), std::make_pair(3, 0), std::make_pair(1, 1)}) {
+        DepositBuffer deposits;
+        deposits.add_two_way(edge.first, edge.second, 1.f);
+        EXPECT_THROW(deposits.group_by_row(/*nodes=*/3), std::invalid_argument);
+    }
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+#include "../AcoAlgorithm.hpp"
+#include "../AcoGraph.hpp"
+#include "../AcoMemoryPlanner.hpp"
+#include "../HugePageAllocator.hpp"
+
+using aco::Algorithm;
+using aco::DeviceType;
+using aco::Footprint;
+using aco::Graph;
+
+class AcoMemoryPlannerTest : public ::testing::Test {
+  public:
+    AcoMemoryPlannerTest() : gen(/*seed=*/42) {}
+
+  public:
+    // Footprint after a few iterations, when all the workspaces were allocated
+    Footprint measure(DeviceType device, std::size_t nodes, const Algorithm::Config& config) {
+        Graph graph(gen, nodes, /*initial_pheromone=*/0.01);
+        auto  algorithm = Algorithm::make(device, gen, graph, config);
+        for (int i = 0; i < 3; ++i) {
+            algorithm->advance();
+        }
+        return algorithm->get_footprint();
+    }
+
+  public:
+    std::mt19937 gen;
+};
+
+TEST_F(AcoMemoryPlannerTest, PredictionMatchesAllocations) {
+    Algorithm::Config config{/*agents_count=*/50, /*pheromone_evaporation=*/0.9};
+    config.threads = 2;
+    for (auto precision : {aco::Precision::Float, aco::Precision::BFloat16}) {
+        config.choice_info_precision = precision;
+        for (auto device : {DeviceType::CPU, DeviceType::CPU_PIPELINED, DeviceType::CPU_SIMD,
+                            DeviceType::CPU_SMALL}) {
+            auto predicted = aco::predict_footprint(device, /*nodes=*/100, config);
+            auto measured = measure(device, /*nodes=*/100, config);
+            ASSERT_EQ(predicted.get_entries().size(), measured.get_entries().size()) << device;
+            for (const auto& entry : predicted.get_entries()) {
+                EXPECT_EQ(entry.bytes, measured.get(entry.name)) << device << ": " << entry.name;
+            }
+        }
+    }
+
+    // Everything but the tours is exact, see predict_footprint
+    auto predicted = aco::predict_footprint(DeviceType::CPU_NUMA, /*nodes=*/100, config);
+    auto measured = measure(DeviceType::CPU_NUMA, /*nodes=*/100, config);
+    EXPECT_EQ(predicted.get("replica choice info"), measured.get("replica choice info"));
+    EXPECT_EQ(predicted.get("replica deposits"), measured.get("replica deposits"));
+    EXPECT_GE(measured.get("tours"), predicted.get("tours") * 9 / 10);
+    EXPECT_LE(measured.get("tours"), predicted.get("tours") * config.threads * 11 / 10);
+
+    // Choice info can lag behind
+    predicted = aco::predict_footprint(DeviceType::CPU_ASYNC, /*nodes=*/100, config);
+    measured = measure(DeviceType::CPU_ASYNC, /*nodes=*/100, config);
+    EXPECT_EQ(predicted.get("shared pheromones"), measured.get("shared pheromones"));
+    EXPECT_EQ(predicted.get("refresh scores"), measured.get("refresh scores"));
+    EXPECT_LE(predicted.total() - predicted.get("choice info") / 2, measured.total());
+}
+
+TEST_F(AcoMemoryPlannerTest, LargeBuffersTakeWholeHugePages) {
+    Algorithm::Config config{/*agents_count=*/4, /*pheromone_evaporation=*/0.9};
+
+    // The cost matrix is just above one huge page, so it takes two
+    std::size_t nodes = 725;
+    ASSERT_GT(nodes * nodes * sizeof(int), utils::huge_page_size);
+    auto predicted = aco::predict_footprint(DeviceType::CPU, nodes, config);
+    auto measured = measure(DeviceType::CPU, nodes, config);
+    EXPECT_EQ(2 * utils::huge_page_size, predicted.get("graph costs"));
+    for (const auto& entry : predicted.get_entries()) {
+        EXPECT_EQ(entry.bytes, measured.get(entry.name)) << entry.name;
+    }
+}
+
+TEST_F(AcoMemoryPlannerTest, FootprintGrowsWithTheGraphAndAgents) {
+    Algorithm::Config config{/*agents_count=*/10, /*pheromone_evaporation=*/0.9};
+    auto small = aco::predict_footprint(DeviceType::CPU, /*nodes=*/1000, config);
+    auto bigger = aco::predict_footprint(DeviceType::CPU, /*nodes=*/2000, config);
+    EXPECT_EQ(4 * small.get("graph costs"), bigger.get("graph costs"));
+    EXPECT_EQ(4 * small.get("choice info"), bigger.get("choice info"));
+
+    config.agents_count = 20;
+    auto more_agents = aco::predict_footprint(DeviceType::CPU, /*nodes=*/1000, config);
+    EXPECT_EQ(small.get("graph costs"), more_agents.get("graph costs"));
+    EXPECT_EQ(2 * small.get("tours"), more_agents.get("tours"));
+
+    EXPECT_THROW(aco::predict_footprint(DeviceType::CPU_SMALL, /*nodes=*/257, config),
+                 std::invalid_argument);
+}
+
+TEST_F(AcoMemoryPlannerTest, PlansTheCheapestStorageThatFits) {
+    Algorithm::Config config{/*agents_count=*/100, /*pheromone_evaporation=*/0.9};
+    std::size_t       nodes = 1000;
+    std::vector<DeviceType> devices{DeviceType::CPU_PIPELINED, DeviceType::CPU};
+
+    auto pipelined = aco::predict_footprint(DeviceType::CPU_PIPELINED, nodes, config);
+    auto plan = aco::plan_memory(devices, nodes, config, pipelined.total());
+    ASSERT_TRUE(plan);
+    EXPECT_EQ(DeviceType::CPU_PIPELINED, plan->device);
+    EXPECT_EQ(aco::Precision::Float, plan->config.choice_info_precision);
+
+    // Reduced precision before another device
+    plan = aco::plan_memory(devices, nodes, config, pipelined.total() - 1);
+    ASSERT_TRUE(plan);
+    EXPECT_EQ(DeviceType::CPU_PIPELINED, plan->device);
+    EXPECT_EQ(aco::Precision::BFloat16, plan->config.choice_info_precision);
+    EXPECT_LT(plan->footprint.total(), pipelined.total());
+
+    auto cpu = config;
+    cpu.choice_info_precision = aco::Precision::BFloat16;
+    auto cheapest = aco::predict_footprint(DeviceType::CPU, nodes, cpu);
+    plan = aco::plan_memory(devices, nodes, config, cheapest.total());
+    ASSERT_TRUE(plan);
+    EXPECT_EQ(DeviceType::CPU, plan->device);
+    EXPECT_EQ(cheapest.total(), plan->footprint.total());
+
+    EXPECT_FALSE(aco::plan_memory(devices, nodes, config, cheapest.total() - 1));
+    EXPECT_FALSE(aco::plan_memory({DeviceType::CPU_SMALL}, nodes, config, cheapest.total()));
+}
@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "../AcoAlgorithm.hpp"
+#include "../AcoGraph.hpp"
+#include "../AcoRecombination.hpp"
+
+using aco::Algorithm;
+using aco::DeviceType;
+using aco::Graph;
+using aco::Point;
+using aco::Recombination;
+
+class AcoRecombinationTest : public ::testing::Test {
+  public:
+    AcoRecombinationTest() : gen(/*seed=*/42) {}
+
+  public:
+    // Every node exactly once
+    static bool is_permutation(Graph::Path path, std::size_t nodes) {
+        std::sort(begin(path), end(path));
+        Graph::Path expected(nodes);
+        std::iota(begin(expected), end(expected), 0);
+        return path == expected;
+    }
+
+  public:
+    std::mt19937 gen;
+};
+
+TEST_F(AcoRecombinationTest, IdenticalParentsHaveNoChild) {
+    std::size_t nodes = 10;
+    Graph       graph(gen, nodes, /*initial_pheromone=*/0.01);
+    Graph::Path parent(nodes);
+    std::iota(begin(parent), end(parent), 0);
+
+    Recombination recombination;
+    Graph::Path   child;
+    EXPECT_FALSE(recombination.crossover(graph, parent.data(), parent.data(), child));
+
+    // The same tour in the other direction
+    Graph::Path reversed(rbegin(parent), rend(parent));
+    EXPECT_FALSE(recombination.crossover(graph, parent.data(), reversed.data(), child));
+}
+
+TEST_F(AcoRecombinationTest, ChildTakesTheBetterPartOfEachParent) {
+    // Two hexagons far apart, each parent visits one of them in order and the other one not
+    std::vector<Point> points;
+    for (double center : {0.0, 1000.0}) {
+        for (int i = 0; i < 6; ++i) {
+            double angle = 2 * M_PI * i / 6;
+            points.push_back({center + 10 * std::cos(angle), 10 * std::sin(angle)});
+        }
+    }
+    auto        graph = Graph::from_points(points, /*initial_pheromone=*/0.01);
+    Graph::Path first{0, 1, 2, 3, 4, 5, 6, 8, 7, 10, 9, 11};
+    Graph::Path second{0, 2, 1, 4, 3, 5, 6, 7, 8, 9, 10, 11};
+
+    Recombination recombination;
+    Graph::Path   child;
+    ASSERT_TRUE(recombination.crossover(graph, first.data(), second.data(), child));
+    EXPECT_TRUE(is_permutation(child, points.size()));
+    EXPECT_LT(graph.path_length(child), graph.path_length(first));
+    EXPECT_LT(graph.path_length(child), graph.path_length(second));
+
+    // Both hexagons in order, which is optimal
+    Graph::Path optimal(points.size());
+    std::iota(begin(optimal), end(optimal), 0);
+    EXPECT_EQ(graph.path_length(optimal), graph.path_length(child));
+}
+
+TEST_F(AcoRecombinationTest, ChildOfRandomParentsIsShorterTour) {
+    std::size_t nodes = 50;
+    Graph       graph(gen, nodes, /*initial_pheromone=*/0.01);
+
+    Recombination recombination(nodes);
+    Graph::Path   first(nodes);
+    Graph::Path   second(nodes);
+    Graph::Path   child;
+    std::iota(begin(first), end(first), 0);
+    int children = 0;
+    for (int i = 0; i < 100; ++i) {
+        // Similar parents, as in a converging colony
+        second = first;
+        for (int swaps = 0; swaps < 3; ++swaps) {
+            std::swap(second[gen() % nodes], second[gen() % nodes]);
+        }
+        if (recombination.crossover(graph, first.data(), second.data(), child)) {
+            ASSERT_TRUE(is_permutation(child, nodes));
+            EXPECT_LT(graph.path_length(child), graph.path_length(first));
+            EXPECT_LT(graph.path_length(child), graph.path_length(second));
+            ++children;
+        }
+        std::shuffle(begin(first), end(first), gen);
+    }
+
+    // Not every pair of parents has a feasible partition, but some do
+    EXPECT_GT(children, 0);
+}
+
+TEST_F(AcoRecombinationTest, AlgorithmWithRecombinationFindsValidPaths) {
+    std::size_t nodes = 30;
+    Graph       graph(gen, nodes, /*initial_pheromone=*/0.01);
+
+    Algorithm::Config config{/*agents_count=*/nodes, /*pheromone_evaporation=*/0.9};
+    config.recombination_elites = 3;
+    auto algorithm = Algorithm::make(DeviceType::CPU, gen, graph, config);
+
+    auto previous = graph.path_length(algorithm->get_shortest_path());
+    for (int i = 0; i < 20; ++i) {
+        algorithm->advance();
+        auto path = algorithm->get_shortest_path();
+        ASSERT_TRUE(is_permutation(path, nodes));
+        EXPECT_LE(graph.path_length(path), previous);
+        previous = graph.path_length(path);
+    }
+}
@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "../AcoAlgorithm.hpp"
+#include "../AcoGraph.hpp"
+#include "../AcoReordering.hpp"
+
+using aco::Algorithm;
+using aco::DeviceType;
+using aco::Graph;
+using aco::Point;
+using aco::Reordering;
+
+class AcoReorderingTest : public ::testing::Test {
+  public:
+    AcoReorderingTest() : gen(/*seed=*/42) {}
+
+  public:
+    // Grid of points, numbered in a random order
+    std::vector<Point> make_shuffled_grid(int side) {
+        std::vector<Point> points;
+        for (int x = 0; x < side; ++x) {
+            for (int y = 0; y < side; ++y) {
+                points.push_back({10.0 * x, 10.0 * y});
+            }
+        }
+        std::shuffle(begin(points), end(points), gen);
+        return points;
+    }
+
+    // Average difference of internal indices of the nearest neighbours
+    static double average_neighbour_distance(const Graph& graph) {
+        std::vector<int> nearest;
+        graph.nearest_costs(nearest);
+
+        double total = 0;
+        int    count = 0;
+        for (Graph::Index i = 0; i < graph.get_size(); ++i) {
+            for (Graph::Index j = 0; j < graph.get_size(); ++j) {
+                if (j != i && graph.get_cost(i, j) == nearest[i]) {
+                    total += i > j ? i - j : j - i;
+                    ++count;
+                }
+            }
+        }
+        return total / count;
+    }
+
+    static bool is_permutation(Graph::Path path, std::size_t nodes) {
+        std::sort(begin(path), end(path));
+        Graph::Path expected(nodes);
+        std::iota(begin(expected), end(expected), 0);
+        return path == expected;
+    }
+
+  public:
+    std::mt19937 gen;
+};
+
+TEST_F(AcoReorderingTest, MapsBothWays) {
+    auto reordering = Reordering::from_order({2, 0, 3, 1});
+    EXPECT_EQ(2, reordering.to_original(0));
+    EXPECT_EQ(0, reordering.to_internal(2));
+
+    Graph::Path path{3, 1, 0, 2};
+    EXPECT_EQ(path, reordering.to_original(reordering.to_internal(path)));
+
+    EXPECT_THROW(Reordering::from_order({0, 0, 1}), std::invalid_argument);
+    EXPECT_THROW(Reordering::from_order({0, 3}), std::invalid_argument);
+}
+
+TEST_F(AcoReorderingTest, AppliedGraphKeepsLengths) {
+    Graph graph(gen, /*nodes=*/20, /*initial_pheromone=*/0.1);
+    graph.set_cost(3, 7, 1000); // Asymmetric
+    graph.set_pheromone(5, 9, 0.5);
+
+    auto order = Reordering(20).get_order();
+    std::shuffle(begin(order), end(order), gen);
+    auto reordering = Reordering::from_order(order);
+    auto internal = reordering.apply(graph);
+
+    Graph::Path path(20);
+    for (int i = 0; i < 10; ++i) {
+        std::shuffle(begin(path = order), end(path), gen);
+        EXPECT_EQ(graph.path_length(path), internal.path_length(reordering.to_internal(path)));
+    }
+    EXPECT_EQ(1000, internal.get_cost(reordering.to_internal(3), reordering.to_internal(7)));
+    EXPECT_EQ(0.5f, internal.get_pheromone(reordering.to_internal(5), reordering.to_internal(9)));
+    EXPECT_EQ(graph, reordering.restore(internal));
+}
+
+TEST_F(AcoReorderingTest, OrdersBringNeighboursClose) {
+    auto points = make_shuffled_grid(/*side=*/16);
+    auto graph = Graph::from_points(points, /*initial_pheromone=*/0.1);
+    auto shuffled = average_neighbour_distance(graph);
+
+    auto hilbert = Reordering::hilbert(points);
+    auto nearest_neighbour = Reordering::nearest_neighbour(graph);
+    auto cuthill_mckee = Reordering::cuthill_mckee(graph);
+    for (const auto* reordering : {&hilbert, &nearest_neighbour, &cuthill_mckee}) {
+        EXPECT_TRUE(is_permutation(reordering->get_order(), points.size()));
+        EXPECT_LT(average_neighbour_distance(reordering->apply(graph)), shuffled / 2);
+    }
+}
+
+TEST_F(AcoReorderingTest, FollowsDynamicChanges) {
+    auto reordering = Reordering::from_order({2, 0, 3, 1});
+    reordering.add_node();
+    EXPECT_EQ((Graph::Path{2, 0, 3, 1, 4}), reordering.get_order());
+
+    // The original node 0, the internal node 1
+    reordering.remove_node(0);
+    EXPECT_EQ((Graph::Path{1, 2, 0, 3}), reordering.get_order());
+    EXPECT_EQ(2, reordering.to_internal(0));
+    EXPECT_THROW(reordering.remove_node(4), std::invalid_argument);
+}
+
+TEST_F(AcoReorderingTest, AlgorithmReturnsOriginalIndices) {
+    auto points = make_shuffled_grid(/*side=*/6);
+    auto graph = Graph::from_points(points, /*initial_pheromone=*/0.01);
+    auto nodes = graph.get_size();
+
+    Algorithm::Config config{/*agents_count=*/nodes, /*pheromone_evaporation=*/0.9};
+    auto algorithm =
+        Algorithm::make(DeviceType::CPU, gen, graph, config, Reordering::hilbert(points));
+    EXPECT_EQ("CPU (reordered)", algorithm->info());
+    EXPECT_THROW(Algorithm::make(DeviceType::CPU, gen, graph, config, Reordering(3)),
+                 std::invalid_argument);
+
+    for (int i = 0; i < 10; ++i) {
+        auto iteration_best = algorithm->advance();
+        const auto& shortest = algorithm->get_shortest_path();
+        ASSERT_TRUE(is_permutation(iteration_best, nodes));
+        ASSERT_TRUE(is_permutation(shortest, nodes));
+        EXPECT_LE(graph.path_length(shortest), graph.path_length(iteration_best));
+    }
+
+    // Pheromones follow the tours, in the original indices
+    const auto& learned = algorithm->get_graph();
+    const auto& shortest = algorithm->get_shortest_path();
+    EXPECT_GT(learned.get_pheromone(shortest[0], shortest[1]), 0.01f);
+    for (Graph::Index i = 0; i < nodes; ++i) {
+        for (Graph::Index j = 0; j < nodes; ++j) {
+            if (i != j) {
+                ASSERT_EQ(graph.get_cost(i, j), learned.get_cost(i, j));
+            }
+        }
+    }
+
+    // Dynamic changes in the original indices
+    std::vector<int> costs(nodes, 1);
+    auto             node = algorithm->add_node(costs);
+    EXPECT_EQ(nodes, node);
+    EXPECT_EQ(1, algorithm->get_graph().get_cost(3, node));
+    algorithm->set_cost(5, 2, 777);
+    EXPECT_EQ(777, algorithm->get_graph().get_cost(5, 2));
+    algorithm->remove_node(0);
+    EXPECT_EQ(777, algorithm->get_graph().get_cost(4, 1)); // Both indices shifted
+    for (int i = 0; i < 3; ++i) {
+        algorithm->advance();
+        EXPECT_TRUE(is_permutation(algorithm->get_shortest_path(), nodes));
+    }
+
+    // Another instance, renumbered on its own
+    Graph other(gen, /*nodes=*/12, /*initial_pheromone=*/0.01);
+    algorithm->reset(other, config);
+    algorithm->advance();
+    EXPECT_TRUE(is_permutation(algorithm->get_shortest_path(), 12));
+    EXPECT_EQ(other.get_cost(2, 9), algorithm->get_graph().get_cost(2, 9));
+}
+
+TEST_F(AcoReorderingTest, AlgorithmKeepsASingleCopyOfTheMatrices) {
+    auto points = make_shuffled_grid(/*side=*/6);
+    auto graph = Graph::from_points(points, /*initial_pheromone=*/0.01);
+
+    Algorithm::Config config{/*agents_count=*/8, /*pheromone_evaporation=*/0.9};
+    auto              plain = Algorithm::make(DeviceType::CPU, gen, graph, config);
+    auto              algorithm =
+        Algorithm::make(DeviceType::CPU, gen, graph, config, Reordering::hilbert(points));
+    plain->advance();
+    algorithm->advance();
+    EXPECT_EQ(plain->get_footprint().total(), algorithm->get_footprint().total());
+
+    // Lengths come from the inner graph, in the original indices
+    const auto& shortest = algorithm->get_shortest_path();
+    EXPECT_EQ(graph.path_length(shortest), algorithm->path_length(shortest));
+    auto invalid = shortest;
+    invalid[0] = graph.get_size();
+    EXPECT_THROW(algorithm->path_length(invalid), std::invalid_argument);
+    EXPECT_THROW(algorithm->path_length({0, 1}), std::invalid_argument);
+    EXPECT_THROW(algorithm->remove_node(graph.get_size()), std::invalid_argument);
+    EXPECT_THROW(algorithm->set_cost(0, graph.get_size(), 5), std::invalid_argument);
+}
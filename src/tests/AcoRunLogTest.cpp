@@ -0,0 +1,193 @@
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "../../third_party/nlohmann/json.hpp"
+#include "../AcoAlgorithm.hpp"
+#include "../AcoGraph.hpp"
+#include "../AcoRunLog.hpp"
+#include "../AcoSolver.hpp"
+#include "../RingBuffer.hpp"
+
+using aco::Algorithm;
+using aco::DeviceType;
+using aco::Graph;
+using aco::RunLog;
+using aco::Solver;
+
+class AcoRunLogTest : public ::testing::Test {
+  public:
+    AcoRunLogTest()
+        : gen(/*seed=*/42), directory(std::filesystem::temp_directory_path() / "aco_run_log_test") {
+        std::filesystem::create_directories(directory);
+    }
+
+    ~AcoRunLogTest() { std::filesystem::remove_all(directory); }
+
+  public:
+    static std::string read_file(const std::string& filename) {
+        std::ifstream file(filename, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(file)),
+                           std::istreambuf_iterator<char>());
+    }
+
+    // One JSON per line
+    static std::vector<nlohmann::json> parse_lines(const std::string& output) {
+        std::vector<nlohmann::json> lines;
+        std::istringstream          stream(output);
+        std::string                 line;
+        while (std::getline(stream, line)) {
+            lines.push_back(nlohmann::json::parse(line));
+        }
+        return lines;
+    }
+
+  public:
+    std::mt19937          gen;
+    std::filesystem::path directory;
+};
+
+TEST_F(AcoRunLogTest, RingBufferKeepsOrderAndCapacity) {
+    utils::RingBuffer<int> buffer(/*min_capacity=*/5);
+    EXPECT_EQ(8, buffer.capacity());
+
+    // All or nothing
+    std::vector<int> values{1, 2, 3, 4, 5, 6};
+    EXPECT_TRUE(buffer.push(values.data(), values.size()));
+    EXPECT_FALSE(buffer.push(values.data(), 3));
+    EXPECT_EQ(2, buffer.free());
+
+    std::vector<int> popped(4);
+    EXPECT_TRUE(buffer.pop(popped.data(), 4));
+    EXPECT_EQ((std::vector<int>{1, 2, 3, 4}), popped);
+    EXPECT_FALSE(buffer.pop(popped.data(), 3));
+
+    // Wraps around
+    EXPECT_TRUE(buffer.push(values.data(), 5));
+    int value = 0;
+    for (int expected : {5, 6, 1, 2, 3, 4, 5}) {
+        ASSERT_TRUE(buffer.pop(value));
+        EXPECT_EQ(expected, value);
+    }
+    EXPECT_FALSE(buffer.pop(value));
+}
+
+TEST_F(AcoRunLogTest, RingBufferBetweenThreads) {
+    utils::RingBuffer<int> buffer(/*min_capacity=*/16);
+    const int              count = 100000;
+
+    std::thread producer([&] {
+        for (int i = 0; i < count;) {
+            if (buffer.push(i)) {
+                ++i;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    int value = 0;
+    for (int i = 0; i < count;) {
+        if (buffer.pop(value)) {
+            ASSERT_EQ(i, value);
+            ++i;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+}
+
+TEST_F(AcoRunLogTest, SolverLogsEveryIterationAndImprovedTours) {
+    Graph graph(gen, /*nodes=*/30, /*initial_pheromone=*/0.01);
+    auto  algorithm = Algorithm::make(DeviceType::CPU, gen, graph,
+                                      {/*agents_count=*/30, /*pheromone_evaporation=*/0.9});
+
+    auto filename = (directory / "run.ndjson").string();
+    auto initial = graph.path_length(algorithm->get_shortest_path());
+
+    Solver::StopCriteria criteria;
+    criteria.max_iterations = 20;
+    Solver::Result result;
+    {
+        RunLog log(filename, RunLog::Format::Ndjson);
+        result = Solver(*algorithm, criteria, &log, /*log_id=*/3).run();
+        EXPECT_EQ(0, log.dropped());
+    }
+
+    auto lines = parse_lines(read_file(filename));
+    ASSERT_EQ(result.iterations, lines.size());
+    int previous = initial;
+    for (std::size_t i = 0; i < lines.size(); ++i) {
+        EXPECT_EQ(3, lines[i]["algorithm"]);
+        EXPECT_EQ(i + 1, lines[i]["iteration"]);
+        EXPECT_GE(lines[i]["iteration_length"], lines[i]["best_length"]);
+        EXPECT_TRUE(lines[i]["branching_factor"].is_null()); // Diagnostics disabled
+
+        int best = lines[i]["best_length"];
+        EXPECT_EQ(best < previous, lines[i].contains("tour"));
+        if (lines[i].contains("tour")) {
+            EXPECT_EQ(best, graph.path_length(lines[i]["tour"].get<Graph::Path>()));
+        }
+        previous = best;
+    }
+    EXPECT_EQ(result.length, lines.back()["best_length"]);
+}
+
+TEST_F(AcoRunLogTest, BinaryConvertsToTheSameNdjson) {
+    std::vector<RunLog::Record> records(3);
+    Graph::Path                 tour{2, 0, 1};
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        records[i].iteration = i + 1;
+        records[i].best_length = 100 - i;
+        records[i].entropy = 0.5f;
+    }
+    records[1].tour_size = tour.size();
+
+    auto binary = (directory / "run.bin").string();
+    auto ndjson = (directory / "run.ndjson").string();
+    {
+        RunLog binary_log(binary, RunLog::Format::Binary);
+        RunLog ndjson_log(ndjson, RunLog::Format::Ndjson);
+        for (const auto& record : records) {
+            EXPECT_TRUE(binary_log.log(record, tour.data()));
+            EXPECT_TRUE(ndjson_log.log(record, tour.data()));
+        }
+    }
+
+    std::istringstream input(read_file(binary));
+    std::ostringstream output;
+    RunLog::convert(input, output);
+    EXPECT_EQ(read_file(ndjson), output.str());
+
+    auto lines = parse_lines(output.str());
+    ASSERT_EQ(3, lines.size());
+    EXPECT_EQ(tour, lines[1]["tour"].get<Graph::Path>());
+    EXPECT_FALSE(lines[2].contains("tour"));
+
+    // Truncated
+    std::istringstream truncated(read_file(binary).substr(0, sizeof(RunLog::Record) + 10));
+    EXPECT_THROW(RunLog::convert(truncated, output), std::runtime_error);
+}
+
+TEST_F(AcoRunLogTest, DropsWhatDoesNotFit) {
+    RunLog log((directory / "run.ndjson").string(), RunLog::Format::Ndjson, /*capacity=*/16,
+               /*tour_capacity=*/4);
+
+    Graph::Path    tour(10);
+    RunLog::Record record;
+    record.tour_size = tour.size();
+    EXPECT_FALSE(log.log(record, tour.data()));
+    EXPECT_EQ(1, log.dropped());
+
+    record.tour_size = 0;
+    EXPECT_TRUE(log.log(record));
+    EXPECT_EQ(1, log.dropped());
+}
+
+TEST_F(AcoRunLogTest, ThrowsWhenFileCantBeOpened) {
+    EXPECT_THROW(RunLog((directory / "missing" / "run.ndjson").string(), RunLog::Format::Ndjson),
+                 std::runtime_error);
+}
@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+#include "../AcoChoiceInfo.hpp"
+#include "../AcoGraph.hpp"
+#include "../AcoSimdTourBuilder.hpp"
+
+using aco::ChoiceInfo;
+using aco::Graph;
+using aco::SimdTourBuilder;
+using aco::kernels::Isa;
+
+class AcoSimdTourBuilderTest : public ::testing::TestWithParam<Isa> {
+  public:
+    AcoSimdTourBuilderTest() : gen(/*seed=*/42) {}
+
+  public:
+    std::mt19937 gen;
+};
+
+// Counts that are not a multiple of the lanes, to cover partial batches
+TEST_P(AcoSimdTourBuilderTest, BuildsValidTours) {
+    auto isa = GetParam();
+    if (!aco::kernels::is_supported(isa)) {
+        GTEST_SKIP() << "Instruction set not supported: " << isa;
+    }
+
+    for (std::size_t nodes : {1, 2, 7, 40}) {
+        Graph      graph(gen, nodes, /*initial_pheromone=*/0.1);
+        ChoiceInfo choice_info;
+        choice_info.update(graph);
+
+        SimdTourBuilder           builder(isa);
+        std::size_t               count = 21;
+        std::vector<Graph::Index> tours(count * nodes + 1, nodes);
+        builder.build(choice_info, count, gen, tours.data());
+
+        // Nothing is written past the last tour
+        EXPECT_EQ(nodes, tours.back());
+        for (std::size_t i = 0; i < count; ++i) {
+            Graph::Path path(tours.begin() + i * nodes, tours.begin() + (i + 1) * nodes);
+            EXPECT_EQ(i % nodes, path.front());
+
+            // Every city visited exactly once
+            std::sort(begin(path), end(path));
+            for (Graph::Index j = 0; j < nodes; ++j) {
+                ASSERT_EQ(j, path[j]) << "Nodes: " << nodes << ", tour: " << i;
+            }
+        }
+    }
+}
+
+// The choice follows the scores: from city 0, city 1 is three times more desired than city 2
+TEST_P(AcoSimdTourBuilderTest, FollowsTheScores) {
+    auto isa = GetParam();
+    if (!aco::kernels::is_supported(isa)) {
+        GTEST_SKIP() << "Instruction set not supported: " << isa;
+    }
+
+    std::size_t        nodes = 3;
+    std::vector<float> values = {0, 3, 1, //
+                                 1, 0, 1, //
+                                 1, 1, 0};
+    ChoiceInfo         choice_info;
+    choice_info.assign(values, nodes);
+
+    // Every third tour starts from city 0
+    SimdTourBuilder           builder(isa);
+    std::size_t               count = 3 * 4000;
+    std::vector<Graph::Index> tours(count * nodes);
+    builder.build(choice_info, count, gen, tours.data());
+
+    int to_first = 0;
+    for (std::size_t i = 0; i < count; i += 3) {
+        to_first += tours[i * nodes + 1] == 1;
+    }
+    EXPECT_NEAR(0.75, to_first / (count / 3.0), 0.03);
+}
+
+// Lanes are emulated exactly by the scalar version
+TEST_P(AcoSimdTourBuilderTest, SameToursAsScalarWithSameLanes) {
+    auto isa = GetParam();
+    if (!aco::kernels::is_supported(isa)) {
+        GTEST_SKIP() << "Instruction set not supported: " << isa;
+    }
+    SimdTourBuilder builder(isa);
+    SimdTourBuilder scalar(Isa::Scalar);
+    if (builder.get_lanes() != scalar.get_lanes()) {
+        GTEST_SKIP() << "Different number of lanes";
+    }
+
+    std::size_t nodes = 30;
+    Graph       graph(gen, nodes, /*initial_pheromone=*/0.1);
+    graph.set_pheromone(/*src=*/3, /*dst=*/4, /*value=*/1.9);
+    ChoiceInfo choice_info;
+    choice_info.update(graph);
+
+    std::size_t               count = 20;
+    std::vector<Graph::Index> expected(count * nodes);
+    std::vector<Graph::Index> tours(count * nodes);
+    std::mt19937              scalar_gen(/*seed=*/7);
+    std::mt19937              simd_gen(/*seed=*/7);
+    scalar.build(choice_info, count, scalar_gen, expected.data());
+    builder.build(choice_info, count, simd_gen, tours.data());
+
+    EXPECT_EQ(expected, tours);
+}
+
+// Scores calculated from the graph are the same as a float choice info with the same weights
+TEST_P(AcoSimdTourBuilderTest, SameToursFromGraphAsFromChoiceInfo) {
+    auto isa = GetParam();
+    if (!aco::kernels::is_supported(isa)) {
+        GTEST_SKIP() << "Instruction set not supported: " << isa;
+    }
+
+    std::size_t nodes = 30;
+    Graph       graph(gen, nodes, /*initial_pheromone=*/0.1);
+    graph.set_pheromone(/*src=*/3, /*dst=*/4, /*value=*/1.9);
+    ChoiceInfo choice_info;
+    choice_info.set_exponents(/*alpha=*/1, /*beta=*/2);
+    choice_info.update(graph);
+
+    SimdTourBuilder           builder(isa);
+    std::size_t               count = 20;
+    std::vector<Graph::Index> expected(count * nodes);
+    std::vector<Graph::Index> tours(count * nodes);
+    std::mt19937              choice_info_gen(/*seed=*/7);
+    std::mt19937              graph_gen(/*seed=*/7);
+    builder.build(choice_info, count, choice_info_gen, expected.data());
+    builder.update(graph, /*alpha=*/1, /*beta=*/2);
+    builder.build(count, graph_gen, tours.data());
+
+    EXPECT_EQ(expected, tours);
+}
+
+INSTANTIATE_TEST_SUITE_P(AcoSimdTourBuilderTest, AcoSimdTourBuilderTest,
+                         testing::Values(Isa::Scalar, Isa::Avx2, Isa::Avx512));
@@ -0,0 +1,128 @@
+#include <atomic>
+#include <gtest/gtest.h>
+#include <limits>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../AcoAlgorithm.hpp"
+#include "../AcoGraph.hpp"
+#include "../AcoSolver.hpp"
+
+using aco::Algorithm;
+using aco::DeviceType;
+using aco::Graph;
+using aco::Solver;
+
+class AcoSolverTest : public ::testing::Test {
+  public:
+    AcoSolverTest()
+        : gen(/*seed=*/42), graph(gen, /*nodes=*/30, /*initial_pheromone=*/0.01),
+          algorithm(Algorithm::make(DeviceType::CPU, gen, graph,
+                                    {/*agents_count=*/30, /*pheromone_evaporation=*/0.9})) {}
+
+  public:
+    std::mt19937               gen;
+    Graph                      graph;
+    std::unique_ptr<Algorithm> algorithm;
+};
+
+TEST_F(AcoSolverTest, ThrowsOnInvalidArguments) {
+    // No criteria
+    EXPECT_THROW(Solver(*algorithm, {}), std::invalid_argument);
+
+    // Negative criterion
+    Solver::StopCriteria criteria;
+    criteria.max_iterations = 10;
+    criteria.max_stagnation = -1;
+    EXPECT_THROW(Solver(*algorithm, criteria), std::invalid_argument);
+}
+
+TEST_F(AcoSolverTest, StopsAfterMaxIterations) {
+    Solver::StopCriteria criteria;
+    criteria.max_iterations = 7;
+
+    auto result = Solver(*algorithm, criteria).run();
+    EXPECT_EQ(7, result.iterations);
+    EXPECT_EQ(Solver::StopReason::Iterations, result.reason);
+    EXPECT_EQ(algorithm->get_shortest_path(), result.path);
+    EXPECT_EQ(algorithm->path_length(result.path), result.length);
+}
+
+TEST_F(AcoSolverTest, StopsOnStagnation) {
+    Solver::StopCriteria criteria;
+    criteria.max_stagnation = 5;
+    criteria.max_iterations = 1000; // Just in case
+
+    auto result = Solver(*algorithm, criteria).run();
+    EXPECT_EQ(Solver::StopReason::Stagnation, result.reason);
+    EXPECT_LT(result.iterations, 1000);
+}
+
+TEST_F(AcoSolverTest, StopsOnTarget) {
+    // Any path is good enough
+    Solver::StopCriteria criteria;
+    criteria.target_length = std::numeric_limits<int>::max();
+
+    auto result = Solver(*algorithm, criteria).run();
+    EXPECT_EQ(Solver::StopReason::Target, result.reason);
+    EXPECT_EQ(1, result.iterations);
+}
+
+TEST_F(AcoSolverTest, StopsOnConvergence) {
+    Algorithm::Config config{/*agents_count=*/30, /*pheromone_evaporation=*/0.5};
+    config.diagnostics_samples = 30;
+    algorithm->reset(graph, config);
+
+    Solver::StopCriteria criteria;
+    criteria.min_branching_factor = 10; // Out of 29 at the beginning
+    criteria.max_iterations = 1000; // Just in case
+
+    auto result = Solver(*algorithm, criteria).run();
+    EXPECT_EQ(Solver::StopReason::Convergence, result.reason);
+    EXPECT_LE(algorithm->get_diagnostics().branching_factor, 10);
+}
+
+TEST_F(AcoSolverTest, StopsBeforeDeadline) {
+    Solver::StopCriteria criteria;
+    criteria.time_limit = std::chrono::milliseconds(50);
+
+    auto result = Solver(*algorithm, criteria).run();
+    EXPECT_EQ(Solver::StopReason::Time, result.reason);
+    EXPECT_GE(result.iterations, 1);
+
+    // Deadline is respected, with a generous margin for a slow machine
+    EXPECT_LT(result.time.count(), 100);
+}
+
+TEST_F(AcoSolverTest, BestPathCanBeTakenWhileRunning) {
+    Solver::StopCriteria criteria;
+    criteria.max_iterations = 200;
+    Solver solver(*algorithm, criteria);
+
+    Solver::Result    result;
+    std::atomic<bool> finished(false);
+    std::thread       runner([&] {
+        result = solver.run();
+        finished = true;
+    });
+
+    // Take snapshots while the simulation is running. They can only get better.
+    std::int64_t previous_length = std::numeric_limits<std::int64_t>::max();
+    while (!finished) {
+        const auto& snapshot = solver.best();
+        if (snapshot.path.empty()) {
+            // Nothing published yet
+            continue;
+        }
+
+        EXPECT_EQ(graph.get_size(), snapshot.path.size());
+        EXPECT_LE(snapshot.length, previous_length);
+        previous_length = snapshot.length;
+    }
+    runner.join();
+
+    // The last snapshot is the final result
+    EXPECT_EQ(result.length, solver.best().length);
+    EXPECT_EQ(result.path, solver.best().path);
+}
@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "../AcoSparseAlgorithm.hpp"
+#include "../AcoSparseGraph.hpp"
+
+using aco::SparseAlgorithm;
+using aco::SparseGraph;
+
+// Two-way ring 0 - 1 - ... - nodes-1 - 0 with costs 1, and chords of cost 'chord_cost' between
+// every node and the one 'nodes / 2' further
+static SparseGraph make_ring(std::size_t nodes, int chord_cost) {
+    std::vector<SparseGraph::Edge> edges;
+    for (std::size_t i = 0; i < nodes; ++i) {
+        auto next = (i + 1) % nodes;
+        edges.push_back({i, next, 1});
+        edges.push_back({next, i, 1});
+        if (chord_cost > 0 && i < nodes / 2) {
+            edges.push_back({i, i + nodes / 2, chord_cost});
+            edges.push_back({i + nodes / 2, i, chord_cost});
+        }
+    }
+    return SparseGraph(nodes, std::move(edges), /*initial_pheromone=*/0.01);
+}
+
+TEST(AcoSparseGraphTest, RejectsInvalidEdges) {
+    using Edges = std::vector<SparseGraph::Edge>;
+    EXPECT_THROW(SparseGraph(3, Edges{{0, 3, 1}}, 0.01), std::invalid_argument);
+    EXPECT_THROW(SparseGraph(3, Edges{{1, 1, 1}}, 0.01), std::invalid_argument);
+    EXPECT_THROW(SparseGraph(3, Edges{{0, 1, 0}}, 0.01), std::invalid_argument);
+    EXPECT_THROW(SparseGraph(3, Edges{{0, 1, 2}, {0, 1, 3}}, 0.01), std::invalid_argument);
+    EXPECT_NO_THROW(SparseGraph(3, Edges{{0, 1, 2}, {1, 0, 3}}, 0.01));
+}
+
+TEST(AcoSparseGraphTest, EdgesAreSortedBySourceAndTarget) {
+    SparseGraph graph(4, {{2, 0, 5}, {0, 3, 7}, {0, 1, 2}, {3, 2, 4}}, 0.01);
+    EXPECT_EQ(4, graph.get_size());
+    EXPECT_EQ(4, graph.get_edge_count());
+
+    // Node 0 has two edges, node 1 none
+    ASSERT_EQ(2, graph.edges_end(0) - graph.edges_begin(0));
+    EXPECT_EQ(1, graph.get_target(graph.edges_begin(0)));
+    EXPECT_EQ(3, graph.get_target(graph.edges_begin(0) + 1));
+    EXPECT_EQ(graph.edges_begin(1), graph.edges_end(1));
+
+    auto edge = graph.find_edge(0, 3);
+    ASSERT_NE(SparseGraph::no_edge, edge);
+    EXPECT_EQ(7, graph.get_cost(edge));
+    EXPECT_FLOAT_EQ(0.01f, graph.get_pheromone(edge));
+    EXPECT_EQ(SparseGraph::no_edge, graph.find_edge(3, 0));
+    EXPECT_THROW(graph.find_edge(0, 4), std::invalid_argument);
+
+    // Pheromones don't go under the initial level
+    graph.add_pheromone(edge, 1.f);
+    graph.update_all(0.5f);
+    EXPECT_FLOAT_EQ(0.505f, graph.get_pheromone(edge));
+    EXPECT_FLOAT_EQ(0.01f, graph.get_pheromone(graph.find_edge(0, 1)));
+}
+
+TEST(AcoSparseGraphTest, PathLengthChargesMissingEdges) {
+    auto graph = make_ring(/*nodes=*/6, /*chord_cost=*/0);
+
+    SparseGraph::Path ring{0, 1, 2, 3, 4, 5};
+    EXPECT_EQ(6, graph.path_length(ring, /*missing_edge_cost=*/100));
+    EXPECT_EQ(0, graph.missing_edges(ring));
+
+    // 2 -> 4 and 3 -> 5 are not edges
+    SparseGraph::Path jumping{0, 1, 2, 4, 3, 5};
+    EXPECT_EQ(2, graph.missing_edges(jumping));
+    EXPECT_EQ(4 + 200, graph.path_length(jumping, /*missing_edge_cost=*/100));
+
+    EXPECT_THROW(graph.path_length({0, 6}, 100), std::invalid_argument);
+}
+
+TEST(AcoSparseGraphTest, FromDimacs) {
+    auto graph = SparseGraph::from_dimacs("c 9th DIMACS challenge format\n"
+                                          "p sp 3 5\n"
+                                          "a 1 2 10\n"
+                                          "a 2 1 10\n"
+                                          "c parallel arcs keep the cheapest one\n"
+                                          "a 2 3 8\n"
+                                          "a 2 3 6\n"
+                                          "a 3 3 1\n",
+                                          /*initial_pheromone=*/0.01);
+    EXPECT_EQ(3, graph.get_size());
+    EXPECT_EQ(3, graph.get_edge_count());
+    EXPECT_EQ(10, graph.get_cost(graph.find_edge(0, 1)));
+    EXPECT_EQ(6, graph.get_cost(graph.find_edge(1, 2)));
+    EXPECT_EQ(SparseGraph::no_edge, graph.find_edge(2, 1));
+
+    EXPECT_THROW(SparseGraph::from_dimacs("a 1 2 10\n", 0.01), std::invalid_argument);
+    EXPECT_THROW(SparseGraph::from_dimacs("p sp 2 1\na 1 3 10\n", 0.01), std::invalid_argument);
+    EXPECT_THROW(SparseGraph::from_dimacs("p sp 2 1\na 1 2 0\n", 0.01), std::invalid_argument);
+    EXPECT_THROW(SparseGraph::from_dimacs("p max 2 1\n", 0.01), std::invalid_argument);
+    EXPECT_THROW(SparseGraph::from_dimacs("c nothing\n", 0.01), std::invalid_argument);
+}
+
+TEST(AcoSparseGraphTest, AlgorithmFindsFeasibleTour) {
+    std::mt19937 gen(/*seed=*/42);
+    std::size_t  nodes = 40;
+    auto         graph = make_ring(nodes, /*chord_cost=*/3);
+
+    SparseAlgorithm::Config config{/*agents_count=*/20, /*pheromone_evaporation=*/0.9,
+                                   /*missing_edge_cost=*/100};
+    SparseAlgorithm         algorithm(gen, graph, config);
+
+    for (int iteration = 0; iteration < 50; ++iteration) {
+        auto path = algorithm.advance();
+
+        // Every city exactly once
+        auto sorted = path;
+        std::sort(begin(sorted), end(sorted));
+        for (std::size_t i = 0; i < nodes; ++i) {
+            ASSERT_EQ(i, sorted[i]);
+        }
+    }
+
+    // The ring is the only tour without a jump
+    const auto& best = algorithm.get_shortest_path();
+    EXPECT_EQ(0, algorithm.get_graph().missing_edges(best));
+    EXPECT_EQ(static_cast<std::int64_t>(nodes), algorithm.path_length(best));
+}
+
+TEST(AcoSparseGraphTest, AntsDepositOnTheEdgesTheyTook) {
+    std::mt19937 gen(/*seed=*/42);
+    std::size_t  nodes = 12;
+    auto         graph = make_ring(nodes, /*chord_cost=*/3);
+
+    // A single ant and no evaporation, so only its edges change
+    SparseAlgorithm::Config config{/*agents_count=*/1, /*pheromone_evaporation=*/1,
+                                   /*missing_edge_cost=*/100};
+    SparseAlgorithm         algorithm(gen, graph, config);
+    auto                    path = algorithm.advance();
+
+    std::vector<char> taken(graph.get_edge_count(), 0);
+    for (std::size_t i = 0; i < nodes; ++i) {
+        auto edge = graph.find_edge(path[i], path[(i + 1) % nodes]);
+        if (edge != SparseGraph::no_edge) {
+            taken[edge] = 1;
+        }
+    }
+    const auto& result = algorithm.get_graph();
+    for (std::size_t edge = 0; edge < result.get_edge_count(); ++edge) {
+        if (taken[edge]) {
+            EXPECT_GT(result.get_pheromone(edge), 0.01f) << edge;
+        } else {
+            EXPECT_FLOAT_EQ(0.01f, result.get_pheromone(edge)) << edge;
+        }
+    }
+}
+
+TEST(AcoSparseGraphTest, MemoryScalesWithEdges) {
+    std::mt19937 gen(/*seed=*/42);
+    std::size_t  nodes = 10000;
+    auto         graph = make_ring(nodes, /*chord_cost=*/0);
+
+    SparseAlgorithm::Config config{/*agents_count=*/1, /*pheromone_evaporation=*/0.9,
+                                   /*missing_edge_cost=*/100};
+    SparseAlgorithm         algorithm(gen, graph, config);
+    algorithm.advance();
+
+    // A dense graph would need 800 MB for the costs and the pheromones alone
+    EXPECT_LT(algorithm.get_footprint().total(), 2'000'000);
+    EXPECT_EQ(0, algorithm.get_graph().missing_edges(algorithm.get_shortest_path()));
+
+    SparseAlgorithm::Config invalid{/*agents_count=*/1, /*pheromone_evaporation=*/0.9,
+                                    /*missing_edge_cost=*/0};
+    EXPECT_THROW(SparseAlgorithm(gen, graph, invalid), std::invalid_argument);
+}
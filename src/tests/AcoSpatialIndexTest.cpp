@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+#include "../AcoGraph.hpp"
+#include "../AcoSpatialIndex.hpp"
+
+using aco::Point;
+using aco::SpatialIndex;
+
+class AcoSpatialIndexTest : public ::testing::Test {
+  public:
+    AcoSpatialIndexTest() : gen(/*seed=*/42) {}
+
+    std::vector<Point> random_points(std::size_t count) {
+        std::uniform_real_distribution<double> distrib(0, 1000);
+        std::vector<Point>                     points(count);
+        for (auto& point : points) {
+            point = {distrib(gen), distrib(gen)};
+        }
+        return points;
+    }
+
+    // Integer grid, lots of points at exactly the same distance
+    static std::vector<Point> grid_points(int side) {
+        std::vector<Point> points;
+        for (int x = 0; x < side; ++x) {
+            for (int y = 0; y < side; ++y) {
+                points.push_back({double(x), double(y)});
+            }
+        }
+        return points;
+    }
+
+    static double distance_squared(const Point& a, const Point& b) {
+        return (a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y);
+    }
+
+    // Reference: sort all the other points by distance, then by index
+    static std::vector<SpatialIndex::Index> brute_force_nearest(const std::vector<Point>& points,
+                                                                std::size_t index, std::size_t k) {
+        std::vector<SpatialIndex::Index> others;
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            if (i != index) {
+                others.push_back(i);
+            }
+        }
+        std::sort(begin(others), end(others), [&](auto a, auto b) {
+            auto da = distance_squared(points[index], points[a]);
+            auto db = distance_squared(points[index], points[b]);
+            return da < db || (da == db && a < b);
+        });
+        others.resize(std::min(k, others.size()));
+        return others;
+    }
+
+  public:
+    std::mt19937 gen;
+};
+
+TEST_F(AcoSpatialIndexTest, NearestMatchesBruteForce) {
+    for (auto points : {random_points(500), grid_points(15)}) {
+        SpatialIndex index(points);
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            EXPECT_EQ(brute_force_nearest(points, i, 8), index.nearest(i, 8)) << "Point: " << i;
+        }
+    }
+}
+
+TEST_F(AcoSpatialIndexTest, NearestWithMoreNeighboursThanPoints) {
+    auto         points = random_points(5);
+    SpatialIndex index(points);
+
+    EXPECT_EQ(4, index.nearest(0, 10).size());
+    EXPECT_EQ(brute_force_nearest(points, 0, 10), index.nearest(0, 10));
+    EXPECT_TRUE(index.nearest(0, 0).empty());
+}
+
+TEST_F(AcoSpatialIndexTest, NeighbourListsDoNotDependOnThreads) {
+    auto         points = random_points(3000);
+    SpatialIndex index(points);
+    std::size_t  k = 6;
+
+    auto lists = index.neighbour_lists(k, /*threads=*/1);
+    ASSERT_EQ(points.size() * k, lists.size());
+    EXPECT_EQ(lists, index.neighbour_lists(k, /*threads=*/4));
+
+    for (std::size_t i = 0; i < points.size(); i += 97) {
+        std::vector<SpatialIndex::Index> list(begin(lists) + i * k, begin(lists) + (i + 1) * k);
+        EXPECT_EQ(index.nearest(i, k), list) << "Point: " << i;
+    }
+}
+
+TEST_F(AcoSpatialIndexTest, WithinRadiusMatchesBruteForce) {
+    for (auto points : {random_points(500), grid_points(15)}) {
+        SpatialIndex index(points);
+        for (double radius : {0.0, 1.0, 2.5, 60.0}) {
+            for (std::size_t i = 0; i < points.size(); i += 7) {
+                std::vector<SpatialIndex::Index> expected;
+                for (std::size_t j = 0; j < points.size(); ++j) {
+                    if (j != i && distance_squared(points[i], points[j]) <= radius * radius) {
+                        expected.push_back(j);
+                    }
+                }
+
+                EXPECT_EQ(expected, index.within_radius(i, radius))
+                    << "Point: " << i << ", radius: " << radius;
+            }
+        }
+    }
+}
+
+TEST_F(AcoSpatialIndexTest, WithinRadiusOfArbitraryPoint) {
+    SpatialIndex index(grid_points(3));
+
+    // Center of the grid, only the four direct neighbours of the middle point are within radius
+    std::vector<SpatialIndex::Index> expected{1, 3, 4, 5, 7};
+    EXPECT_EQ(expected, index.within_radius(Point{1, 1}, 1.0));
+    EXPECT_TRUE(index.within_radius(Point{10, 10}, 1.0).empty());
+}
+
+TEST_F(AcoSpatialIndexTest, EmptyIndex) {
+    SpatialIndex index({});
+
+    EXPECT_EQ(0, index.get_size());
+    EXPECT_TRUE(index.neighbour_lists(5).empty());
+    EXPECT_TRUE(index.within_radius(Point{0, 0}, 10).empty());
+}
+
+TEST_F(AcoSpatialIndexTest, ThrowsOnInvalidArguments) {
+    SpatialIndex index(random_points(10));
+
+    EXPECT_THROW(index.get_point(10), std::invalid_argument);
+    EXPECT_THROW(index.nearest(10, 3), std::invalid_argument);
+    EXPECT_THROW(index.within_radius(SpatialIndex::Index(10), 1.0), std::invalid_argument);
+}
+
+TEST_F(AcoSpatialIndexTest, GraphFromPoints) {
+    std::vector<Point> points{{0, 0}, {3, 4}, {0, 0.2}, {10, 0}};
+    auto               graph = aco::Graph::from_points(points, /*initial_pheromone=*/1);
+
+    ASSERT_EQ(points.size(), graph.get_size());
+    EXPECT_EQ(5, graph.get_cost(0, 1));
+    EXPECT_EQ(5, graph.get_cost(1, 0));
+    EXPECT_EQ(1, graph.get_cost(0, 2)); // Rounded to zero, but costs must be positive
+    EXPECT_EQ(10, graph.get_cost(0, 3));
+    EXPECT_EQ(8, graph.get_cost(1, 3)); // sqrt(65) = 8.06
+    EXPECT_FLOAT_EQ(1, graph.get_pheromone(2, 3));
+}
@@ -0,0 +1,91 @@
+#include <chrono>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <vector>
+
+#include "../AcoGraph.hpp"
+#include "../AcoTuner.hpp"
+
+using aco::DeviceType;
+using aco::Graph;
+using aco::Profile;
+using aco::Tuner;
+
+class AcoTunerTest : public ::testing::Test {
+  public:
+    AcoTunerTest() : gen(/*seed=*/42) {}
+
+  public:
+    std::mt19937 gen;
+};
+
+TEST_F(AcoTunerTest, ProfileSerialization) {
+    Profile profile{DeviceType::CPU_PIPELINED, /*nodes=*/64, /*agents_per_node=*/4,
+                    /*threads=*/2,             /*pheromone_evaporation=*/0.8,
+                    /*alpha=*/1.5,             /*beta=*/3};
+    auto    restored = Profile::from_string(profile.to_string());
+
+    EXPECT_EQ(profile.device, restored.device);
+    EXPECT_EQ(profile.nodes, restored.nodes);
+    EXPECT_EQ(profile.agents_per_node, restored.agents_per_node);
+    EXPECT_EQ(profile.threads, restored.threads);
+    EXPECT_EQ(profile.pheromone_evaporation, restored.pheromone_evaporation);
+    EXPECT_EQ(profile.alpha, restored.alpha);
+    EXPECT_EQ(profile.beta, restored.beta);
+
+    // The configuration scales with the instance size
+    auto config = restored.make_config(/*nodes=*/10);
+    EXPECT_EQ(40, config.agents_count);
+    EXPECT_EQ(2, config.threads);
+    EXPECT_EQ(1.5f, config.alpha);
+}
+
+TEST_F(AcoTunerTest, ProfileDeserializationThrowsOnInvalidInput) {
+    EXPECT_THROW(Profile::from_string("not a json"), std::invalid_argument);
+    EXPECT_THROW(Profile::from_string(R"({"device":"CPU"})"), std::invalid_argument);
+
+    Profile profile{DeviceType::CPU, 10, 1, 0, 0.9, 1, 1};
+    auto    string = profile.to_string();
+    string.replace(string.find("CPU"), 3, "TPU");
+    EXPECT_THROW(Profile::from_string(string), std::invalid_argument);
+}
+
+TEST_F(AcoTunerTest, InvalidConfigThrows) {
+    Tuner::Config config{DeviceType::CPU, Tuner::Space(), std::chrono::milliseconds(100), 0};
+    config.space.beta.clear();
+    EXPECT_THROW(Tuner{config}, std::invalid_argument);
+
+    config.space = Tuner::Space();
+    config.budget = std::chrono::milliseconds(0);
+    EXPECT_THROW(Tuner{config}, std::invalid_argument);
+
+    config.budget = std::chrono::milliseconds(100);
+    Tuner              tuner(config);
+    std::ostringstream log;
+    EXPECT_THROW(tuner.tune({}, log), std::invalid_argument);
+}
+
+TEST_F(AcoTunerTest, TuneRacesCandidatesFromTheSpace) {
+    std::vector<Graph> instances;
+    instances.emplace_back(gen, /*nodes=*/12, /*initial_pheromone=*/0.1);
+    instances.emplace_back(gen, /*nodes=*/12, /*initial_pheromone=*/0.1);
+
+    Tuner::Space space;
+    space.agents_per_node = {1, 2};
+    space.pheromone_evaporation = {0.9};
+    space.beta = {1, 2, 3};
+    Tuner              tuner({DeviceType::CPU, space, std::chrono::milliseconds(300), /*seed=*/1});
+    std::ostringstream log;
+    auto               profile = tuner.tune(instances, log);
+
+    EXPECT_EQ(DeviceType::CPU, profile.device);
+    EXPECT_EQ(12, profile.nodes);
+    EXPECT_TRUE(profile.agents_per_node == 1 || profile.agents_per_node == 2);
+    EXPECT_EQ(0.9f, profile.pheromone_evaporation);
+    EXPECT_EQ(1.f, profile.alpha);
+    EXPECT_TRUE(profile.beta == 1 || profile.beta == 2 || profile.beta == 3);
+
+    // Six candidates need three rounds of halving
+    EXPECT_NE(std::string::npos, log.str().find("Round 1: 6 candidates"));
+    EXPECT_NE(std::string::npos, log.str().find("Round 3: 2 candidates"));
+}
@@ -0,0 +1,55 @@
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <numeric>
+
+#include "../HugePageAllocator.hpp"
+
+using utils::HugePages;
+using utils::LargeVector;
+
+class HugePageAllocatorTest : public ::testing::TestWithParam<HugePages> {
+  public:
+    HugePageAllocatorTest() : previous(utils::get_huge_pages()) {
+        utils::set_huge_pages(GetParam());
+    }
+    ~HugePageAllocatorTest() { utils::set_huge_pages(previous); }
+
+  private:
+    HugePages previous;
+};
+
+TEST_P(HugePageAllocatorTest, SmallBuffersAreAlignedToCacheLines) {
+    for (std::size_t size : {1, 3, 100, 1000}) {
+        LargeVector<float> values(size, 1.f);
+        EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(values.data()) % utils::cache_line_size);
+    }
+}
+
+TEST_P(HugePageAllocatorTest, LargeBuffersAreAlignedToHugePages) {
+    auto before = utils::get_huge_page_statistics();
+
+    std::size_t          size = utils::huge_page_size / sizeof(int32_t) + 123;
+    LargeVector<int32_t> values(size);
+    std::iota(begin(values), end(values), 0);
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(values.data()) % utils::huge_page_size);
+    EXPECT_EQ(int32_t(size - 1), values.back());
+
+    // Padded to two whole huge pages, whatever pages it got
+    auto after = utils::get_huge_page_statistics();
+    auto bytes = (after.explicit_bytes - before.explicit_bytes) +
+                 (after.transparent_bytes - before.transparent_bytes) +
+                 (after.normal_bytes - before.normal_bytes);
+    EXPECT_EQ(2 * utils::huge_page_size, bytes);
+    if (GetParam() == HugePages::Off) {
+        EXPECT_EQ(2 * utils::huge_page_size, after.normal_bytes - before.normal_bytes);
+    }
+
+    // Copies and growth go through the allocator as well
+    auto copy = values;
+    copy.resize(2 * size);
+    EXPECT_EQ(values[size / 2], copy[size / 2]);
+}
+
+INSTANTIATE_TEST_SUITE_P(HugePageAllocatorTest, HugePageAllocatorTest,
+                         testing::Values(HugePages::Off, HugePages::Transparent,
+                                         HugePages::Explicit));
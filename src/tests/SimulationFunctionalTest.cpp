@@ -38,8 +38,8 @@ class SimulationFunctionalTest : public ::testing::Test {
     std::mt19937 gen;
 };
 
-static float last_20_average(const std::vector<int>& in) {
-    auto sum = std::accumulate(end(in) - 20, end(in), 0);
+static float last_20_average(const std::vector<std::int64_t>& in) {
+    auto sum = std::accumulate(end(in) - 20, end(in), std::int64_t{0});
     return sum / 20.f;
 }
 
@@ -68,11 +68,11 @@ TEST_F(SimulationFunctionalTest, CompareCpuAndGpuResults) {
     auto gpu_algorithm = make_algorithm(graph, config, DeviceType::GPU);
 
     // Simulation
-    const auto         max_iterations = 100;
-    std::vector<int>   cpu_iter_bests;
-    std::vector<int>   gpu_iter_bests;
-    std::vector<Graph> cpu_graphs;
-    std::vector<Graph> gpu_graphs;
+    const auto                max_iterations = 100;
+    std::vector<std::int64_t> cpu_iter_bests;
+    std::vector<std::int64_t> gpu_iter_bests;
+    std::vector<Graph>        cpu_graphs;
+    std::vector<Graph>        gpu_graphs;
     for (int i = 0; i < max_iterations; ++i) {
         auto cpu_best = cpu_algorithm->advance();
         cpu_iter_bests.push_back(cpu_algorithm->path_length(cpu_best));
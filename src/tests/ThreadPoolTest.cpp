@@ -0,0 +1,54 @@
+#include <atomic>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+#include "../ThreadPool.hpp"
+
+TEST(ThreadPoolTest, RunsAllTasks) {
+    utils::ThreadPool        pool(/*threads=*/4);
+    std::atomic<int>         sum(0);
+    std::vector<std::size_t> workers(100);
+    for (int i = 0; i < 100; ++i) {
+        pool.submit([&, i](std::size_t worker) {
+            sum += i;
+            workers[i] = worker;
+        });
+    }
+    pool.wait();
+
+    EXPECT_EQ(99 * 100 / 2, sum);
+    for (auto worker : workers) {
+        EXPECT_LT(worker, pool.size());
+    }
+}
+
+TEST(ThreadPoolTest, RethrowsTaskException) {
+    utils::ThreadPool pool(/*threads=*/2);
+    pool.submit([](std::size_t) { throw std::runtime_error("Task failed"); });
+    EXPECT_THROW(pool.wait(), std::runtime_error);
+
+    // Pool is still usable after the exception
+    std::atomic<int> count(0);
+    pool.submit([&](std::size_t) { ++count; });
+    EXPECT_NO_THROW(pool.wait());
+    EXPECT_EQ(1, count);
+}
+
+// Tasks submitted by tasks may be stolen and finished before their submit returns
+TEST(ThreadPoolTest, WaitsForNestedTasks) {
+    utils::ThreadPool pool(/*threads=*/4);
+    for (int round = 0; round < 100; ++round) {
+        std::atomic<int> finished(0);
+        for (int i = 0; i < 4; ++i) {
+            pool.submit([&](std::size_t) {
+                for (int j = 0; j < 10; ++j) {
+                    pool.submit([&](std::size_t) { ++finished; });
+                }
+                ++finished;
+            });
+        }
+        pool.wait();
+        ASSERT_EQ(4 * 11, finished) << round;
+    }
+}
@@ -0,0 +1,54 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "../AcoAlgorithm.hpp"
+#include "../AcoAlgorithmCpuAsync.hpp"
+#include "../AcoGraph.hpp"
+
+int main(int argc, char* argv[]) {
+    // Parse command line arguments
+    if (argc > 4) {
+        std::cout << "A tool to compare the asynchronous and pipelined algorithms with the "
+                     "synchronous one, in terms of throughput and convergence.\n";
+        std::cout << "Usage: " << argv[0] << " [cities] [iterations] [threads]\n";
+        return 1;
+    }
+    std::size_t cities = argc > 1 ? std::stoul(argv[1]) : 512;
+    int         iterations = argc > 2 ? std::stoi(argv[2]) : 50;
+    std::size_t threads = argc > 3 ? std::stoul(argv[3]) : 0;
+
+    std::mt19937           gen(/*seed=*/42);
+    aco::Graph             graph(gen, cities, /*initial_pheromone=*/0.1);
+    aco::Algorithm::Config config{/*agents_count=*/cities, /*pheromone_evaporation=*/0.9};
+    config.threads = threads;
+
+    // All algorithms get the same number of tours, the best length is reported every few
+    // iterations to compare convergence
+    auto checkpoint = std::max(1, iterations / 10);
+    for (auto device :
+         {aco::DeviceType::CPU, aco::DeviceType::CPU_ASYNC, aco::DeviceType::CPU_PIPELINED}) {
+        auto algorithm = aco::Algorithm::make(device, gen, graph, config);
+        std::cout << "\nAlgorithm: " << algorithm->info() << "\n";
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            algorithm->advance();
+            if ((i + 1) % checkpoint == 0) {
+                std::cout << "iteration " << i + 1 << ": best length: "
+                          << algorithm->path_length(algorithm->get_shortest_path()) << "\n";
+            }
+        }
+        auto seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "Average iteration: " << seconds / iterations * 1000
+                  << " ms, tours/s: " << iterations * config.agents_count / seconds << "\n";
+        if (auto async = dynamic_cast<aco::AlgorithmCpuAsync*>(algorithm.get())) {
+            auto statistics = async->get_statistics();
+            std::cout << "Workers: tours: " << statistics.tours
+                      << ", tours/s: " << statistics.tours_per_second << "\n";
+        }
+    }
+}
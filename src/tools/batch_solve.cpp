@@ -0,0 +1,55 @@
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "../AcoBatchSolver.hpp"
+
+int main(int argc, char* argv[]) {
+    // Parse command line arguments
+    if (argc < 2 || argc > 5) {
+        std::cout << "A tool to solve many problem instances concurrently.\n";
+        std::cout << "Usage: " << argv[0] << " instances [threads] [iterations] [time_limit_ms]\n";
+        std::cout << "instances - file listing the instances to solve, one per line, or '-' to "
+                     "read them from standard input. Line format:\n";
+        std::cout << "    graph_filename [iterations [time_limit_ms]]\n";
+        std::cout << "Results are written to standard output as JSON lines, in order of "
+                     "completion.\n";
+        return 1;
+    }
+    std::string instances(argv[1]);
+    std::size_t threads = argc > 2 ? std::stoul(argv[2]) : 0;
+    int         max_iterations = argc > 3 ? std::stoi(argv[3]) : 100;
+    long        time_limit_ms = argc > 4 ? std::stol(argv[4]) : 0;
+
+    // Configuration, same as the one used by the main simulation
+    aco::BatchSolver::Config config = {
+        .device = aco::DeviceType::CPU,
+        .threads = threads,
+        .agents_per_node = 16,
+        .pheromone_evaporation = 0.9,
+        .budget = {.max_iterations = max_iterations,
+                   .time_limit = std::chrono::milliseconds(time_limit_ms)},
+        .seed = 42};
+    aco::BatchSolver solver(config);
+
+    // Solve
+    auto        begin = std::chrono::steady_clock::now();
+    std::size_t count = 0;
+    if (instances == "-") {
+        count = solver.run(std::cin, std::cout);
+    } else {
+        std::ifstream file(instances);
+        if (!file) {
+            std::cerr << "Error: Could not open the file: " << instances << "\n";
+            return 1;
+        }
+        count = solver.run(file, std::cout);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    // Report summary
+    std::cerr << "Processed " << count << " instances in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count()
+              << " ms\n";
+}
@@ -0,0 +1,79 @@
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../AcoBenchmark.hpp"
+#include "../AcoTuner.hpp"
+
+static std::string read_file(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file) {
+        throw std::runtime_error("Could not open the file: " + filename);
+    }
+    return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+int main(int argc, char* argv[]) {
+    // Parse command line arguments
+    if (argc < 3) {
+        std::cout << "A tool to compare the quality of solutions over time between backends, "
+                     "configurations and builds. Every instance is solved with every profile "
+                     "and seed, results are written to output.csv (summary) and output.json "
+                     "(summary and curves).\n";
+        std::cout << "Usage: " << argv[0]
+                  << " instances output [seeds] [time_limit_ms] [profile...]\n";
+        std::cout << "Instances file lists one instance per line: filename [known optimum], see "
+                     "benchmark_instances.txt. Profiles are created by the 'tune' tool, the "
+                     "default one is the configuration of tsp_aco.\n";
+        return 1;
+    }
+    std::string instances_filename = argv[1];
+    std::string output = argv[2];
+
+    aco::Benchmark::Config config;
+    config.seeds = argc > 3 ? std::stoul(argv[3]) : 10;
+    config.seed = 1;
+    config.time_limit = std::chrono::milliseconds(argc > 4 ? std::stol(argv[4]) : 2000);
+    config.target_gap = 0.05;
+    for (int i = 5; i < argc; ++i) {
+        config.profiles.push_back(aco::Profile::from_string(read_file(argv[i])));
+    }
+    if (config.profiles.empty()) {
+        config.profiles.push_back({aco::DeviceType::CPU, /*nodes=*/0, /*agents_per_node=*/16,
+                                   /*threads=*/0, /*pheromone_evaporation=*/0.9, /*alpha=*/1,
+                                   /*beta=*/1});
+    }
+
+    // Instances, relative to the directory of the instances file
+    std::vector<aco::Benchmark::Instance> instances;
+    auto                                  directory =
+        std::filesystem::path(instances_filename).parent_path();
+    std::istringstream list(read_file(instances_filename));
+    std::string        line;
+    while (std::getline(list, line)) {
+        std::istringstream line_stream(line);
+        std::string        filename;
+        std::int64_t       optimum = 0;
+        if (!(line_stream >> filename) || filename.front() == '#') {
+            continue;
+        }
+        line_stream >> optimum;
+        instances.push_back(aco::Benchmark::load_instance((directory / filename).string(), optimum,
+                                                          /*initial_pheromone=*/0.1));
+    }
+
+    aco::Benchmark benchmark(config);
+    auto           report = benchmark.run(instances, std::cout);
+
+    std::ofstream csv(output + ".csv");
+    aco::Benchmark::write_csv(report, csv);
+    std::ofstream json(output + ".json");
+    aco::Benchmark::write_json(report, json);
+    std::cout << "Results written to " << output << ".csv and " << output << ".json\n";
+}
@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "../AcoAlgorithm.hpp"
+#include "../AcoDecompositionSolver.hpp"
+#include "../AcoGraph.hpp"
+#include "../AcoSolver.hpp"
+
+int main(int argc, char* argv[]) {
+    // Parse command line arguments
+    if (argc > 5) {
+        std::cout << "A tool to solve a large random instance by decomposition, and to compare it "
+                     "with a single colony given the same wall time.\n";
+        std::cout << "Usage: " << argv[0] << " [cities] [cluster_size] [rounds] [threads]\n";
+        std::cout << "The single colony is skipped above " << 4000
+                  << " cities, its cost matrix would be too big.\n";
+        return 1;
+    }
+    std::size_t cities = argc > 1 ? std::stoul(argv[1]) : 20000;
+    std::size_t cluster_size = argc > 2 ? std::stoul(argv[2]) : 200;
+    std::size_t rounds = argc > 3 ? std::stoul(argv[3]) : 3;
+    std::size_t threads = argc > 4 ? std::stoul(argv[4]) : 0;
+
+    // Uniformly random cities, on a square where the distance between neighbours is about 100
+    std::mt19937                           gen(/*seed=*/42);
+    std::uniform_real_distribution<double> coordinate(0, 100 * std::sqrt(double(cities)));
+    std::vector<aco::Point>                points(cities);
+    for (auto& point : points) {
+        point = {coordinate(gen), coordinate(gen)};
+    }
+
+    aco::DecompositionSolver::Config config;
+    config.device = aco::DeviceType::CPU;
+    config.threads = threads;
+    config.cluster_size = cluster_size;
+    config.agents_per_node = 1;
+    config.pheromone_evaporation = 0.9;
+    config.budget.max_iterations = 100;
+    config.budget.max_stagnation = 20;
+    config.rounds = rounds;
+    config.seed = 42;
+
+    auto result = aco::DecompositionSolver(config).solve(points);
+    std::cout << "Decomposition: " << result.clusters << " clusters, length: " << result.length
+              << ", wall time: " << result.time.count() << " ms\n";
+    for (std::size_t round = 0; round < result.round_lengths.size(); ++round) {
+        std::cout << "Round " << round + 1 << ": " << result.round_lengths[round] << "\n";
+    }
+
+    if (cities > 4000) {
+        std::cout << "Single colony: skipped\n";
+        return 0;
+    }
+
+    // The same wall time, building the cost matrix included
+    auto begin = std::chrono::steady_clock::now();
+    auto graph = aco::Graph::from_points(points, /*initial_pheromone=*/0.01);
+    auto algorithm = aco::Algorithm::make(config.device, gen, graph,
+                                          {cities * config.agents_per_node,
+                                           config.pheromone_evaporation});
+    aco::Solver::StopCriteria criteria;
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - begin);
+    criteria.time_limit = std::max(std::chrono::milliseconds(1), result.time - elapsed);
+    auto single = aco::Solver(*algorithm, criteria).run();
+    auto time = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - begin);
+    std::cout << "Single colony: length: " << single.length << ", iterations: " << single.iterations
+              << ", wall time: " << time.count() << " ms\n";
+    std::cout << "Single colony is " << 100.0 * (single.length - result.length) / result.length
+              << "% longer\n";
+}
@@ -7,21 +7,7 @@
 
 #include "../AcoGraph.hpp"
 
-using Path = std::vector<std::size_t>; // Indices of cities in order
-
-auto path_length(const aco::Graph& graph, const Path& path) {
-    int length = 0;
-    for (int i = 0; i < path.size(); ++i) {
-        // Path stores visited cities in order. It is a round trip, so the last distance is from the
-        // last city directly to the first one
-        auto src = path[i];
-        auto dst = path[(i + 1) % path.size()];
-
-        length += graph.get_cost(src, dst);
-    }
-
-    return length;
-}
+using Path = aco::Graph::Path;
 
 const Path& get_shortest_path(const aco::Graph& graph, const std::vector<Path>& paths) {
     if (paths.empty()) {
@@ -29,7 +15,7 @@ const Path& get_shortest_path(const aco::Graph& graph, const std::vector<Path>&
     }
 
     return *std::min_element(begin(paths), end(paths), [&](const Path& a, const Path& b) {
-        return path_length(graph, a) < path_length(graph, b);
+        return graph.path_length(a) < graph.path_length(b);
     });
 }
 
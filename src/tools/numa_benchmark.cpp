@@ -0,0 +1,123 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../AcoAlgorithm.hpp"
+#include "../AcoAlgorithmCpuNuma.hpp"
+#include "../AcoGraph.hpp"
+#include "../Topology.hpp"
+
+// Run a function on all CPUs of a node in parallel, every thread pinned to its CPU
+template <typename Function>
+void run_on_node(const utils::Topology::Node& node, Function function) {
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < node.cpus.size(); ++i) {
+        threads.emplace_back([&, i] {
+            utils::pin_current_thread(node.cpus[i]);
+            function(i, node.cpus.size());
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+// Read bandwidth (GB/s) of CPUs from 'cpu_node' reading memory first touched on 'memory_node'
+double measure_bandwidth(const utils::Topology::Node& cpu_node,
+                         const utils::Topology::Node& memory_node, std::size_t megabytes) {
+    auto elements = megabytes * 1024 * 1024 / sizeof(float);
+
+    // Allocate without touching, then let the memory node's threads touch their chunks first
+    std::unique_ptr<float[]> buffer(new float[elements]);
+    run_on_node(memory_node, [&](std::size_t thread, std::size_t threads) {
+        auto chunk = elements / threads;
+        std::fill(buffer.get() + thread * chunk, buffer.get() + (thread + 1) * chunk, 1.f);
+    });
+
+    // Every thread reads its chunk, a few times
+    const int           repetitions = 5;
+    std::vector<double> sums(cpu_node.cpus.size());
+    auto                start = std::chrono::steady_clock::now();
+    run_on_node(cpu_node, [&](std::size_t thread, std::size_t threads) {
+        auto chunk = elements / threads;
+        for (int r = 0; r < repetitions; ++r) {
+            sums[thread] += std::accumulate(buffer.get() + thread * chunk,
+                                            buffer.get() + (thread + 1) * chunk, 0.f);
+        }
+    });
+    auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Use the result, so that the reads are not optimized away
+    if (std::accumulate(begin(sums), end(sums), 0.) == 0) {
+        std::cerr << "Unexpected zero sum\n";
+    }
+
+    return repetitions * elements * sizeof(float) / seconds / 1e9;
+}
+
+int main(int argc, char* argv[]) {
+    // Parse command line arguments
+    if (argc > 4) {
+        std::cout << "A tool to measure memory bandwidth of NUMA nodes and the NUMA-aware "
+                     "algorithm.\n";
+        std::cout << "Usage: " << argv[0] << " [cities] [iterations] [buffer_mb]\n";
+        return 1;
+    }
+    std::size_t cities = argc > 1 ? std::stoul(argv[1]) : 1024;
+    int         iterations = argc > 2 ? std::stoi(argv[2]) : 10;
+    std::size_t buffer_mb = argc > 3 ? std::stoul(argv[3]) : 256;
+
+    auto topology = utils::Topology::detect();
+    std::cout << "NUMA nodes: " << topology.get_nodes().size() << ", CPUs: " << topology.cpu_count()
+              << "\n";
+
+    // Step 1: raw read bandwidth between every pair of nodes
+    std::cout << "\nRead bandwidth [GB/s] (rows: CPU node, columns: memory node)\n";
+    for (const auto& cpu_node : topology.get_nodes()) {
+        std::cout << "node " << cpu_node.id << ":";
+        for (const auto& memory_node : topology.get_nodes()) {
+            std::cout << " " << std::fixed << std::setprecision(2)
+                      << measure_bandwidth(cpu_node, memory_node, buffer_mb);
+        }
+        std::cout << "\n";
+    }
+
+    // Step 2: the algorithm, single-threaded CPU vs NUMA-aware
+    std::mt19937           gen(/*seed=*/42);
+    aco::Graph             graph(gen, cities, /*initial_pheromone=*/0.1);
+    aco::Algorithm::Config config{/*agents_count=*/cities, /*pheromone_evaporation=*/0.9};
+
+    for (auto device : {aco::DeviceType::CPU, aco::DeviceType::CPU_NUMA}) {
+        auto algorithm = aco::Algorithm::make(device, gen, graph, config);
+        std::cout << "\nAlgorithm: " << algorithm->info() << "\n";
+
+        auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            algorithm->advance();
+        }
+        auto seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        std::cout << "Average iteration: " << seconds / iterations * 1000 << " ms, best length: "
+                  << algorithm->path_length(algorithm->get_shortest_path()) << "\n";
+
+        // Per-node figures of the last iteration. Every ant step reads a row of the node's choice
+        // info in the worst case, which gives the upper bound of the bandwidth used.
+        if (auto numa = dynamic_cast<aco::AlgorithmCpuNuma*>(algorithm.get())) {
+            for (const auto& node : numa->get_statistics()) {
+                double row_bytes = cities * sizeof(float);
+                double bytes = double(node.tours) * cities * row_bytes;
+                std::cout << "node " << node.node << ": threads: " << node.threads
+                          << ", tours: " << node.tours
+                          << ", construction: " << node.construction_seconds * 1000 << " ms"
+                          << ", tours/s: " << node.tours / node.construction_seconds
+                          << ", replica: " << node.replica_bytes / (1024. * 1024.) << " MB"
+                          << ", choice info read (upper bound): "
+                          << bytes / node.construction_seconds / 1e9 << " GB/s\n";
+            }
+        }
+    }
+}
@@ -0,0 +1,65 @@
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../AcoAlgorithm.hpp"
+#include "../AcoMemoryPlanner.hpp"
+
+static const std::vector<aco::DeviceType> all_devices{
+    aco::DeviceType::CPU,           aco::DeviceType::GPU,      aco::DeviceType::CPU_NUMA,
+    aco::DeviceType::CPU_ASYNC,     aco::DeviceType::CPU_PIPELINED,
+    aco::DeviceType::CPU_SIMD,      aco::DeviceType::CPU_SMALL};
+
+static aco::DeviceType parse_device(const std::string& name) {
+    for (auto device : all_devices) {
+        std::ostringstream out;
+        out << device;
+        if (out.str() == name) {
+            return device;
+        }
+    }
+    std::cerr << "Unknown device: " << name << "\n";
+    throw std::invalid_argument("Unknown device!");
+}
+
+int main(int argc, char* argv[]) {
+    // Parse command line arguments
+    if (argc < 4) {
+        std::cout << "A tool to predict the memory footprint of a job, and to choose the device "
+                     "and the storage that fit a memory limit.\n";
+        std::cout << "Usage: " << argv[0] << " nodes agents limit_mib [device...]\n";
+        std::cout << "Devices are tried in the given order, all CPU ones by default.\n";
+        return 1;
+    }
+    std::size_t nodes = std::stoul(argv[1]);
+    std::size_t agents = std::stoul(argv[2]);
+    std::size_t limit = std::stoul(argv[3]) << 20;
+
+    std::vector<aco::DeviceType> devices;
+    for (int i = 4; i < argc; ++i) {
+        devices.push_back(parse_device(argv[i]));
+    }
+    if (devices.empty()) {
+        devices = {aco::DeviceType::CPU_PIPELINED, aco::DeviceType::CPU,
+                   aco::DeviceType::CPU_SMALL, aco::DeviceType::CPU_SIMD};
+    }
+
+    aco::Algorithm::Config config{agents, /*pheromone_evaporation=*/0.9};
+    auto                   plan = aco::plan_memory(devices, nodes, config, limit);
+    if (!plan) {
+        std::cout << "Nothing fits, the footprint with full precision:\n";
+        for (auto device : devices) {
+            if (device != aco::DeviceType::CPU_SMALL || nodes <= 256) {
+                auto footprint = aco::predict_footprint(device, nodes, config);
+                std::cout << "\n" << device << "\n" << footprint;
+            }
+        }
+        return 2;
+    }
+
+    std::cout << "Device: " << plan->device
+              << ", choice info precision: " << plan->config.choice_info_precision << "\n"
+              << plan->footprint;
+}
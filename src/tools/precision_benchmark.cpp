@@ -0,0 +1,65 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "../AcoAlgorithm.hpp"
+#include "../AcoChoiceInfo.hpp"
+#include "../AcoGraph.hpp"
+
+int main(int argc, char* argv[]) {
+    // Parse command line arguments
+    if (argc > 3) {
+        std::cout << "A tool to compare the float and bfloat16 storage of the choice info, in "
+                     "terms of the row load bandwidth and of the tour quality.\n";
+        std::cout << "Usage: " << argv[0] << " [cities] [iterations]\n";
+        return 1;
+    }
+    std::size_t cities = argc > 1 ? std::stoul(argv[1]) : 1024;
+    int         iterations = argc > 2 ? std::stoi(argv[2]) : 30;
+
+    std::mt19937 gen(/*seed=*/42);
+    aco::Graph   graph(gen, cities, /*initial_pheromone=*/0.1);
+
+    for (auto precision : {aco::Precision::Float, aco::Precision::BFloat16}) {
+        std::cout << "\nPrecision: " << precision << "\n";
+
+        // Step 1: the exact scan loads whole rows, measure how fast all of them can be loaded
+        aco::ChoiceInfo choice_info(cities, precision);
+        choice_info.update(graph);
+
+        std::vector<float> row(cities);
+        const int          repeats = 20;
+        float              checksum = 0;
+        auto               start = std::chrono::steady_clock::now();
+        for (int repeat = 0; repeat < repeats; ++repeat) {
+            for (aco::Graph::Index i = 0; i < cities; ++i) {
+                choice_info.load_row(i, row.data());
+                checksum += row[(i + repeat) % cities];
+            }
+        }
+        auto seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        auto stored_bytes = precision == aco::Precision::Float ? sizeof(float) : 2;
+        auto bytes = double(repeats) * cities * cities * stored_bytes;
+        std::cout << "Row loads: " << bytes / seconds / 1e9 << " GB/s stored, "
+                  << double(repeats) * cities * cities / seconds / 1e9
+                  << " G values/s (checksum " << checksum << ")\n";
+
+        // Step 2: the same run of the whole algorithm, only the precision differs
+        std::mt19937           run_gen(/*seed=*/7);
+        aco::Algorithm::Config config{/*agents_count=*/cities, /*pheromone_evaporation=*/0.9};
+        config.choice_info_precision = precision;
+        auto algorithm = aco::Algorithm::make(aco::DeviceType::CPU, run_gen, graph, config);
+
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            algorithm->advance();
+        }
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "Best length: " << algorithm->path_length(algorithm->get_shortest_path())
+                  << ", average iteration: " << seconds / iterations * 1000 << " ms\n";
+    }
+}
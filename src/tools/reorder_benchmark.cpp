@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "../AcoAlgorithm.hpp"
+#include "../AcoGraph.hpp"
+#include "../AcoReordering.hpp"
+
+// Hardware cache event of the calling thread, not available if perf events are not allowed (see
+// /proc/sys/kernel/perf_event_paranoid) or not supported
+class CacheMissCounter {
+  public:
+    // 'cache' is one of PERF_COUNT_HW_CACHE_*, read misses are counted
+    explicit CacheMissCounter(std::uint64_t cache) : fd(-1) {
+#ifdef __linux__
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = syscall(SYS_perf_event_open, &attr, /*pid=*/0, /*cpu=*/-1, /*group_fd=*/-1, 0);
+#endif
+    }
+
+    ~CacheMissCounter() {
+#ifdef __linux__
+        if (fd >= 0) {
+            close(fd);
+        }
+#endif
+    }
+
+    bool available() const { return fd >= 0; }
+
+    void start() {
+#ifdef __linux__
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    long long stop() {
+        long long count = -1;
+#ifdef __linux__
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fd, &count, sizeof(count)) != sizeof(count)) {
+                count = -1;
+            }
+        }
+#endif
+        return count;
+    }
+
+  private:
+    int fd;
+};
+
+int main(int argc, char* argv[]) {
+    // Parse command line arguments
+    if (argc > 3) {
+        std::cout << "A tool to compare the cache misses and the iteration time of the CPU "
+                     "algorithm on randomly numbered cities, and on the same cities renumbered "
+                     "for locality.\n";
+        std::cout << "Usage: " << argv[0] << " [cities] [iterations]\n";
+        return 1;
+    }
+    std::size_t cities = argc > 1 ? std::stoul(argv[1]) : 2048;
+    int         iterations = argc > 2 ? std::stoi(argv[2]) : 5;
+
+#ifdef __linux__
+    CacheMissCounter l1_misses(PERF_COUNT_HW_CACHE_L1D);
+    CacheMissCounter llc_misses(PERF_COUNT_HW_CACHE_LL);
+#else
+    CacheMissCounter l1_misses(0);
+    CacheMissCounter llc_misses(0);
+#endif
+    if (!l1_misses.available() || !llc_misses.available()) {
+        std::cout << "Some cache miss counters are not available, they are reported as -1\n";
+    }
+
+    // Uniformly random cities, numbered in the order they were generated, which is random too
+    std::mt19937                           gen(/*seed=*/42);
+    std::uniform_real_distribution<double> coordinate(0, 10000);
+    std::vector<aco::Point>                points(cities);
+    for (auto& point : points) {
+        point = {coordinate(gen), coordinate(gen)};
+    }
+    auto graph = aco::Graph::from_points(points, /*initial_pheromone=*/0.01);
+    std::cout << "Matrix size: " << cities * cities * sizeof(float) / (1 << 20) << " MB\n";
+
+    struct Variant {
+        std::string     name;
+        aco::Reordering reordering;
+    };
+    std::vector<Variant> variants{
+        {"random (original)", aco::Reordering(cities)},
+        {"hilbert", aco::Reordering::hilbert(points)},
+        {"nearest neighbour", aco::Reordering::nearest_neighbour(graph)},
+        {"cuthill-mckee", aco::Reordering::cuthill_mckee(graph)},
+    };
+
+    aco::Algorithm::Config config{/*agents_count=*/cities / 4, /*pheromone_evaporation=*/0.9};
+    for (auto& variant : variants) {
+        std::cout << "\nOrder: " << variant.name << "\n";
+
+        // The same random numbers for every variant
+        gen.seed(42);
+        auto algorithm = aco::Algorithm::make(aco::DeviceType::CPU, gen, graph, config,
+                                              std::move(variant.reordering));
+
+        // The first iteration touches the pages for the first time
+        algorithm->advance();
+
+        l1_misses.start();
+        llc_misses.start();
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            algorithm->advance();
+        }
+        auto seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        auto l1 = l1_misses.stop();
+        auto llc = llc_misses.stop();
+
+        std::cout << "Average iteration: " << seconds / iterations * 1000 << " ms"
+                  << ", L1 data load misses per iteration: " << (l1 < 0 ? l1 : l1 / iterations)
+                  << ", last level load misses per iteration: "
+                  << (llc < 0 ? llc : llc / iterations) << ", best length: "
+                  << algorithm->path_length(algorithm->get_shortest_path()) << "\n";
+    }
+}
@@ -0,0 +1,64 @@
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../AcoCostMatrix.hpp"
+#include "../AcoSparseGraph.hpp"
+
+static std::string read_file(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file) {
+        throw std::runtime_error("Could not open the file: " + filename);
+    }
+    return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+int main(int argc, char* argv[]) {
+    // Parse command line arguments
+    if (argc < 4 || argc > 5) {
+        std::cout << "A tool to build the graph over delivery stops of a road network, with the "
+                     "shortest paths between the stops as costs.\n";
+        std::cout << "Usage: " << argv[0] << " network stops output [threads]\n";
+        std::cout << "The network is in the DIMACS shortest path format (.gr), stops are its node "
+                     "numbers (from 1, as in the network file), separated by whitespace. The graph "
+                     "is written to output, in the format of the other tools.\n";
+        return 1;
+    }
+    std::string network_filename(argv[1]);
+    std::string stops_filename(argv[2]);
+    std::string output(argv[3]);
+    std::size_t threads = argc > 4 ? std::stoul(argv[4]) : 0;
+
+    auto begin = std::chrono::steady_clock::now();
+    auto network = aco::SparseGraph::from_dimacs(read_file(network_filename),
+                                                 /*initial_pheromone=*/0.1);
+
+    std::vector<aco::SparseGraph::Index> stops;
+    std::istringstream                   stops_input(read_file(stops_filename));
+    for (std::size_t stop; stops_input >> stop;) {
+        if (stop == 0) {
+            std::cerr << "Stops are numbered from 1\n";
+            return 1;
+        }
+        stops.push_back(stop - 1);
+    }
+    auto loaded = std::chrono::steady_clock::now();
+
+    auto graph = aco::CostMatrixBuilder(network, threads).build(stops, /*initial_pheromone=*/0.1);
+    auto built = std::chrono::steady_clock::now();
+
+    std::ofstream file(output);
+    file << graph.to_string();
+
+    auto milliseconds = [](auto duration) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+    };
+    std::cout << "Network: " << network.get_size() << " nodes, " << network.get_edge_count()
+              << " edges, loaded in " << milliseconds(loaded - begin) << " ms\n";
+    std::cout << "Cost matrix of " << stops.size() << " stops built in "
+              << milliseconds(built - loaded) << " ms, saved to: " << output << "\n";
+}
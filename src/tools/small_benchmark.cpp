@@ -0,0 +1,48 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "../AcoAlgorithm.hpp"
+#include "../AcoGraph.hpp"
+
+int main(int argc, char* argv[]) {
+    // Parse command line arguments
+    if (argc > 4) {
+        std::cout << "A tool to compare the throughput of the specialized small instance algorithm "
+                     "with the generic ones, on a batch of tiny instances.\n";
+        std::cout << "Usage: " << argv[0] << " [cities] [instances] [iterations]\n";
+        return 1;
+    }
+    std::size_t cities = argc > 1 ? std::stoul(argv[1]) : 64;
+    int         instances = argc > 2 ? std::stoi(argv[2]) : 200;
+    int         iterations = argc > 3 ? std::stoi(argv[3]) : 50;
+
+    std::mt19937            gen(/*seed=*/42);
+    std::vector<aco::Graph> graphs;
+    for (int i = 0; i < instances; ++i) {
+        graphs.emplace_back(gen, cities, /*initial_pheromone=*/0.01);
+    }
+    aco::Algorithm::Config config{/*agents_count=*/cities, /*pheromone_evaporation=*/0.9};
+
+    // Every instance is solved from scratch, as in batch traffic
+    for (auto device :
+         {aco::DeviceType::CPU, aco::DeviceType::CPU_SIMD, aco::DeviceType::CPU_SMALL}) {
+        std::cout << "\nDevice: " << device << "\n";
+
+        std::int64_t total_length = 0;
+        auto         start = std::chrono::steady_clock::now();
+        for (const auto& graph : graphs) {
+            auto algorithm = aco::Algorithm::make(device, gen, graph, config);
+            for (int i = 0; i < iterations; ++i) {
+                algorithm->advance();
+            }
+            total_length += algorithm->path_length(algorithm->get_shortest_path());
+        }
+        auto seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "Instances/s: " << instances / seconds
+                  << ", average best length: " << total_length / instances << "\n";
+    }
+}
@@ -0,0 +1,127 @@
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "../AcoAlgorithm.hpp"
+#include "../AcoGraph.hpp"
+#include "../HugePageAllocator.hpp"
+
+// Data TLB load misses of the calling thread, not available if perf events are not allowed (see
+// /proc/sys/kernel/perf_event_paranoid) or not supported
+class TlbMissCounter {
+  public:
+    TlbMissCounter() : fd(-1) {
+#ifdef __linux__
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = syscall(SYS_perf_event_open, &attr, /*pid=*/0, /*cpu=*/-1, /*group_fd=*/-1, 0);
+#endif
+    }
+
+    ~TlbMissCounter() {
+#ifdef __linux__
+        if (fd >= 0) {
+            close(fd);
+        }
+#endif
+    }
+
+    bool available() const { return fd >= 0; }
+
+    void start() {
+#ifdef __linux__
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    long long stop() {
+        long long count = -1;
+#ifdef __linux__
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fd, &count, sizeof(count)) != sizeof(count)) {
+                count = -1;
+            }
+        }
+#endif
+        return count;
+    }
+
+  private:
+    int fd;
+};
+
+int main(int argc, char* argv[]) {
+    // Parse command line arguments
+    if (argc > 3) {
+        std::cout << "A tool to compare the data TLB misses and the iteration time with and "
+                     "without huge pages for the graph matrices and the solver workspaces.\n";
+        std::cout << "Usage: " << argv[0] << " [cities] [iterations]\n";
+        return 1;
+    }
+    std::size_t cities = argc > 1 ? std::stoul(argv[1]) : 2048;
+    int         iterations = argc > 2 ? std::stoi(argv[2]) : 3;
+
+    TlbMissCounter counter;
+    if (!counter.available()) {
+        std::cout << "Data TLB miss counter not available, only times are reported\n";
+    }
+    std::cout << "Matrix size: " << cities * cities * sizeof(float) / (1 << 20) << " MB\n";
+
+    for (auto policy : {utils::HugePages::Off, utils::HugePages::Transparent,
+                        utils::HugePages::Explicit}) {
+        std::cout << "\nHuge pages: " << policy << "\n";
+
+        // Everything is allocated again with the policy, the graph is the same every time
+        utils::set_huge_pages(policy);
+        auto before = utils::get_huge_page_statistics();
+
+        std::mt19937           gen(/*seed=*/42);
+        aco::Graph             graph(gen, cities, /*initial_pheromone=*/0.1);
+        aco::Algorithm::Config config{/*agents_count=*/cities / 4, /*pheromone_evaporation=*/0.9};
+        auto algorithm = aco::Algorithm::make(aco::DeviceType::CPU, gen, graph, config);
+
+        auto after = utils::get_huge_page_statistics();
+        std::cout << "Allocated: " << (after.explicit_bytes - before.explicit_bytes) / (1 << 20)
+                  << " MB explicit, "
+                  << (after.transparent_bytes - before.transparent_bytes) / (1 << 20)
+                  << " MB transparent, " << (after.normal_bytes - before.normal_bytes) / (1 << 20)
+                  << " MB on normal pages\n";
+
+        // The first iteration touches the pages for the first time
+        algorithm->advance();
+
+        counter.start();
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            algorithm->advance();
+        }
+        auto seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        auto misses = counter.stop();
+
+        std::cout << "Average iteration: " << seconds / iterations * 1000 << " ms";
+        if (misses >= 0) {
+            std::cout << ", data TLB load misses per iteration: " << misses / iterations;
+        }
+        std::cout << "\n";
+    }
+}
@@ -0,0 +1,43 @@
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "../AcoGraph.hpp"
+#include "../AcoTuner.hpp"
+
+int main(int argc, char* argv[]) {
+    // Parse command line arguments
+    if (argc < 2 || argc > 5) {
+        std::cout << "A tool to tune the algorithm parameters for random graphs of a given size, "
+                     "within a time budget. The result is saved as a profile, which can be "
+                     "passed to tsp_aco.\n";
+        std::cout << "Usage: " << argv[0] << " profile [cities] [instances] [budget_seconds]\n";
+        return 1;
+    }
+    std::string filename = argv[1];
+    std::size_t cities = argc > 2 ? std::stoul(argv[2]) : 64;
+    std::size_t instances_count = argc > 3 ? std::stoul(argv[3]) : 3;
+    long        budget_seconds = argc > 4 ? std::stol(argv[4]) : 60;
+
+    // Sample instances of the class
+    std::mt19937            gen(/*seed=*/42);
+    std::vector<aco::Graph> instances;
+    for (std::size_t i = 0; i < instances_count; ++i) {
+        instances.emplace_back(gen, cities, /*initial_pheromone=*/0.1);
+    }
+
+    aco::Tuner::Config config{aco::DeviceType::CPU, aco::Tuner::Space(),
+                              std::chrono::seconds(budget_seconds), /*seed=*/7};
+    aco::Tuner         tuner(config);
+    auto               profile = tuner.tune(instances, std::cout);
+
+    std::ofstream file(filename);
+    file << profile.to_string() << "\n";
+    if (!file) {
+        std::cerr << "Could not write the profile: " << filename << "\n";
+        return 1;
+    }
+    std::cout << "Profile saved to " << filename << ":\n" << profile.to_string() << "\n";
+}